@@ -18,6 +18,8 @@
 
 // std
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
 // QC
 #include "QualityControl/QualityObject.h"
 #include "QualityControl/CheckConfig.h"
@@ -71,6 +73,21 @@ class Aggregator
 
   o2::quality_control::core::QualityObjectsType aggregate(core::QualityObjectsMapType& qoMap);
 
+  /**
+   * \brief Keep the QualityObject if it is one of the inputs of this aggregator.
+   *
+   * The accepted objects replace the previous ones with the same name and form the view
+   * which is passed to the user code by aggregate().
+   * @param qo
+   * @return true if the object was accepted.
+   */
+  bool update(const std::shared_ptr<const core::QualityObject>& qo);
+
+  /**
+   * \brief Aggregate the QualityObjects accepted so far by update().
+   */
+  o2::quality_control::core::QualityObjectsType aggregate();
+
   const std::string& getName() const;
   std::string getPolicyName() const;
   std::vector<std::string> getObjectsNames() const;
@@ -86,9 +103,19 @@ class Aggregator
    */
   core::QualityObjectsMapType filter(core::QualityObjectsMapType& qoMap);
 
+  /**
+   * Whether the QualityObject of the given name belongs to one of the sources of this aggregator.
+   */
+  bool accepts(const std::string& name, const core::QualityObject& qo) const;
+
+  /// Convert the QualityObjects returned by the user code into QualityObjects of this aggregator.
+  core::QualityObjectsType createQualityObjects(const std::map<std::string, core::Quality>& qualities) const;
+
   CheckConfig mAggregatorConfig; // we reuse checkConfig, just consider that Check = Aggregator
   AggregatorInterface* mAggregatorInterface = nullptr;
   std::vector<AggregatorSource> mSources;
+  std::unordered_map<std::string, std::unordered_set<std::string>> mSourcesObjects; // source name -> accepted QOs, all if empty
+  core::QualityObjectsMapType mInputs;                                               // the QOs accepted by update()
 };
 
 } // namespace o2::quality_control::checker
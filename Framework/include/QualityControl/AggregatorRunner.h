@@ -16,6 +16,9 @@
 #ifndef QC_CHECKER_AGGREGATORRUNNER_H
 #define QC_CHECKER_AGGREGATORRUNNER_H
 
+// std
+#include <unordered_map>
+#include <vector>
 // O2
 #include <Framework/Task.h>
 #include <Framework/DataProcessorSpec.h>
@@ -23,6 +26,7 @@
 // QC
 #include "QualityControl/QualityObject.h"
 #include "QualityControl/UpdatePolicyManager.h"
+#include "QualityControl/Tracer.h"
 
 namespace o2::framework
 {
@@ -118,6 +122,13 @@ class AggregatorRunner : public framework::Task
    */
   core::QualityObjectsType aggregate();
 
+  /**
+   * \brief Give the QualityObject to the aggregators which have its check or aggregator as a source.
+   *
+   * The aggregators accepting it are marked to be executed at the next call to aggregate().
+   */
+  void dispatch(const std::shared_ptr<const core::QualityObject>& qo);
+
   /**
    * \brief Store the QualityObjects in the database.
    *
@@ -159,7 +170,8 @@ class AggregatorRunner : public framework::Task
   std::vector<std::shared_ptr<Aggregator>> mAggregators;
   std::shared_ptr<o2::quality_control::repository::DatabaseInterface> mDatabase;
   std::shared_ptr<o2::configuration::ConfigurationInterface> mConfigFile;
-  core::QualityObjectsMapType mQualityObjects; // where we cache the incoming quality objects and the output of the aggregators
+  std::unordered_map<std::string, std::vector<size_t>> mAggregatorsBySource; // source name -> indices in mAggregators
+  std::vector<bool> mAggregatorsToUpdate;                                      // whether the inputs of the aggregator changed
   UpdatePolicyManager updatePolicyManager;
 
   // DPL
@@ -172,6 +184,9 @@ class AggregatorRunner : public framework::Task
   int mTotalNumberAggregatorExecuted;
   int mTotalNumberObjectsProduced;
 
+  // tracing
+  core::Tracer mTracer;
+
   // Service discovery
   std::shared_ptr<core::ServiceDiscovery> mServiceDiscovery;
 };
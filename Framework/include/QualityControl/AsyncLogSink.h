@@ -0,0 +1,125 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   AsyncLogSink.h
+///
+
+#ifndef QC_CORE_ASYNCLOGSINK_H
+#define QC_CORE_ASYNCLOGSINK_H
+
+#include "QualityControl/QcInfoLogger.h"
+
+#include <atomic>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <type_traits>
+
+namespace o2::quality_control::core
+{
+
+/// \brief Asynchronous sink for the InfoLogger messages.
+///
+/// The messages are put in a bounded lock-free ring buffer and sent to InfoLogger by a background thread, so that
+/// the thread producing them never waits for the logging backend. If the buffer is full, the messages are dropped
+/// and counted. The context (facility, detector...) of QcInfoLogger is taken when the sink is first used.
+/// Usage :   ILOG_ASYNC(Info, Devel) << "message" << ENDM;
+class AsyncLogSink
+{
+ public:
+  struct Message {
+    AliceO2::InfoLogger::InfoLogger::Severity severity;
+    int level;
+    const char* file;
+    int line;
+    std::string text;
+  };
+
+  static AsyncLogSink& GetInstance()
+  {
+    static AsyncLogSink instance;
+    return instance;
+  }
+
+  /// Enqueues the message. Can be called from any thread.
+  /// \return false if the buffer was full and the message was dropped.
+  bool push(Message&& message);
+
+  /// Waits until all the messages enqueued so far are sent.
+  void flush();
+
+  size_t getNumberDropped() const { return mDropped.load(std::memory_order_relaxed); }
+
+  static constexpr size_t Capacity = 4096; ///< size of the ring buffer, a power of two
+
+ private:
+  AsyncLogSink();
+  ~AsyncLogSink();
+  AsyncLogSink& operator=(const AsyncLogSink&) = delete;
+  AsyncLogSink(const AsyncLogSink&) = delete;
+
+  /// Takes the next message, if any. Only called by the background thread.
+  bool pop(Message& message);
+  void run();
+
+  struct Cell {
+    std::atomic<size_t> sequence;
+    Message message;
+  };
+  std::unique_ptr<Cell[]> mCells;
+  alignas(64) std::atomic<size_t> mEnqueuePosition{ 0 };
+  alignas(64) std::atomic<size_t> mDequeuePosition{ 0 };
+  std::atomic<size_t> mDropped{ 0 };
+  std::atomic<bool> mRunning{ true };
+  std::thread mThread;
+};
+
+/// \brief Stream collecting a message for the AsyncLogSink, it is enqueued when ENDM is received.
+class AsyncLogStream
+{
+ public:
+  AsyncLogStream(AliceO2::InfoLogger::InfoLogger::Severity severity, int level, const char* file, int line)
+    : mSeverity(severity), mLevel(level), mFile(file), mLine(line)
+  {
+  }
+
+  template <typename T>
+  AsyncLogStream& operator<<(const T& value)
+  {
+    if constexpr (std::is_same_v<T, std::decay_t<decltype(AliceO2::InfoLogger::InfoLogger::endm)>>) {
+      AsyncLogSink::GetInstance().push({ mSeverity, mLevel, mFile, mLine, mStream.str() });
+      mStream.str({});
+    } else {
+      mStream << value;
+    }
+    return *this;
+  }
+
+ private:
+  AliceO2::InfoLogger::InfoLogger::Severity mSeverity;
+  int mLevel;
+  const char* mFile;
+  int mLine;
+  std::ostringstream mStream;
+};
+
+} // namespace o2::quality_control::core
+
+// Same as ILOG, but the message is sent by the background thread of AsyncLogSink
+#define ILOG_ASYNC(severity, level)                                                                      \
+  !ILOG_ENABLED(severity, level) ? (void)0 : o2::quality_control::core::QcInfoLogger::Voidify() &         \
+                                               o2::quality_control::core::AsyncLogStream                  \
+  {                                                                                                        \
+    ILOG_SEVERITY(severity), ILOG_LEVEL(level), __FILE__, __LINE__                                        \
+  }
+
+#endif // QC_CORE_ASYNCLOGSINK_H
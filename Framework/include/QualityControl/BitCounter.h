@@ -0,0 +1,82 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   BitCounter.h
+///
+
+#ifndef QC_CORE_BITCOUNTER_H
+#define QC_CORE_BITCOUNTER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class TH1;
+class TH2;
+
+namespace o2::quality_control::core
+{
+
+/// \brief Counts how many times each bit of a word was set, per channel.
+///
+/// This replaces the loops which fill a histogram bin for each set bit of a flag word (trigger type, error flags...)
+/// of each RDH. Only the set bits are visited, with a bit scan, and each costs an increment of an integer. The counts
+/// are added to the histograms by transfer(), typically at the end of the cycle.
+class BitCounter
+{
+ public:
+  BitCounter() = default;
+  /// \param nChannels - number of channels, e.g. FEEs, numbered from 0
+  /// \param nBits - number of bits counted in each word, at most 64
+  BitCounter(size_t nChannels, unsigned int nBits);
+
+  /// Counts the bits set in the word for the channel. The bits beyond nBits and the channels out of range are ignored.
+  void count(size_t channel, uint64_t word)
+  {
+    word &= mMask;
+    if (channel >= mNChannels || word == 0) {
+      return;
+    }
+    mEntries += __builtin_popcountll(word);
+    uint32_t* counts = mCounts.data() + channel * mNBits;
+    for (; word != 0; word &= word - 1) {
+      counts[__builtin_ctzll(word)]++;
+    }
+  }
+
+  size_t getNumberOfChannels() const { return mNChannels; }
+  unsigned int getNumberOfBits() const { return mNBits; }
+  uint32_t get(size_t channel, unsigned int bit) const { return mCounts[channel * mNBits + bit]; }
+  /// \return the counts of a bit summed over the channels
+  uint64_t getTotal(unsigned int bit) const;
+  /// \return the number of set bits counted since the last clear
+  uint64_t getEntries() const { return mEntries; }
+
+  /// Adds the counts of another counter, e.g. of another thread.
+  /// \throw std::invalid_argument if the counters have different dimensions
+  void add(const BitCounter& other);
+  void clear();
+
+  /// Adds the counts to the bins (channel + 1, bit + 1) of perChannel, and their sums over the channels to the bins
+  /// (bit + 1) of totals, then clears them. The histograms can be null, the numbers of entries are updated.
+  void transfer(TH2* perChannel, TH1* totals = nullptr);
+
+ private:
+  size_t mNChannels = 0;
+  unsigned int mNBits = 0;
+  uint64_t mMask = 0;
+  uint64_t mEntries = 0;
+  std::vector<uint32_t> mCounts; // channel after channel
+};
+
+} // namespace o2::quality_control::core
+
+#endif // QC_CORE_BITCOUNTER_H
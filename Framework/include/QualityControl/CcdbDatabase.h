@@ -95,7 +95,7 @@ class CcdbDatabase : public DatabaseInterface
    * \path Path on an object.
    * \return A vector of all 'valid from' timestamps for an object in non-descending order.
    */
-  std::vector<uint64_t> getTimestampsForObject(std::string path);
+  std::vector<uint64_t> getTimestampsForObject(std::string path) override;
 
  private:
   /**
@@ -22,7 +22,9 @@
 #include <memory>
 #include <string>
 #include <map>
+#include <set>
 #include <vector>
+#include <unordered_map>
 #include <unordered_set>
 // O2
 #include <Common/Timer.h>
@@ -38,6 +40,8 @@
 #include "QualityControl/QcInfoLogger.h"
 #include "QualityControl/Check.h"
 #include "QualityControl/UpdatePolicyManager.h"
+#include "QualityControl/Tracer.h"
+#include "QualityControl/MonitorObjectTable.h"
 
 namespace o2::quality_control::core
 {
@@ -121,6 +125,14 @@ class CheckRunner : public framework::Task
   static std::string createCheckRunnerName(std::vector<Check> checks);
   static std::string createSinkCheckRunnerName(o2::framework::InputSpec input);
 
+  /**
+   * \brief Adds the paths of the QOs which are not in the names yet.
+   * The QOs are identified by their name, which includes the MO name with the policy OnEachSeparately.
+   * @return true if a path was added
+   */
+  static bool addQualityObjectPaths(const QualityObjectsType& qualityObjects,
+                                    std::unordered_set<std::string>& names, std::vector<std::string>& paths);
+
  private:
   /**
    * \brief Evaluate the quality of a MonitorObject.
@@ -134,6 +146,9 @@ class CheckRunner : public framework::Task
    */
   QualityObjectsType check();
 
+  /// \brief Gives the QO the trace of the MOs it was checked on and stamps the check.
+  void traceCheck(QualityObject& qo);
+
   /**
    * \brief Store the QualityObjects in the database.
    *
@@ -181,12 +196,24 @@ class CheckRunner : public framework::Task
    * \brief Massage/Prepare data from the Context and store it in the cache.
    * When data is received it can be 1. a TObjArray filled with MonitorObjects,
    * 2. a TObjArray filled with TObjects or 3. a TObject. The two latter happen
-   * in case an external device is sending the data.
+   * in case an external device is sending the data. A TaskRunner on the same node can also send
+   * a MonitorObjectTable, see readObjectTable().
    * This method first transform the data in order to have a TObjArray of MonitorObjects.
    * It then stores these objects in the cache.
    * @param ctx
    */
   void prepareCacheData(framework::InputRecord& inputRecord);
+
+  /**
+   * \brief Deserialize the objects of a MonitorObjectTable which are checked or stored by this CheckRunner.
+   * The trace of the table is attached to all of its objects, as the one of a collection.
+   */
+  void readObjectTable(const MonitorObjectTable::View& table, bool store, const std::string& binding);
+
+  /**
+   * \brief Add a received MonitorObject to the cache used by the checks and to the objects to store.
+   */
+  void cacheMonitorObject(std::shared_ptr<MonitorObject> mo, bool store, const std::shared_ptr<const core::TraceStamps>& trace);
   /**
    * Send metrics to the monitoring system if the time has come.
    */
@@ -212,10 +239,17 @@ class CheckRunner : public framework::Task
 
   // Checks cache
   std::map<std::string, std::shared_ptr<MonitorObject>> mMonitorObjects;
+  bool mAllObjectsChecked = false;                         // whether a check takes all the objects of its inputs
+  std::set<std::string, std::less<>> mCheckedObjectsNames; // otherwise, the objects the checks take
+
+  // Tracing
+  core::Tracer mTracer;
+  std::unordered_map<std::string, std::shared_ptr<const core::TraceStamps>> mMonitorObjectsTraces; // shared by the MOs of a collection
 
   // Service discovery
   std::shared_ptr<ServiceDiscovery> mServiceDiscovery;
-  std::unordered_set<std::string> mListAllQOPaths; // store the names of all the QOs the Checks have generated so far
+  std::unordered_set<std::string> mListAllQONames; // store the names of all the QOs the Checks have generated so far
+  std::vector<std::string> mListAllQOPaths;        // and their paths
 
   // monitoring
   std::shared_ptr<o2::monitoring::Monitoring> mCollector;
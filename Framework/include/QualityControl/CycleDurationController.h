@@ -0,0 +1,52 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   CycleDurationController.h
+///
+
+#ifndef QC_CORE_CYCLEDURATIONCONTROLLER_H
+#define QC_CORE_CYCLEDURATIONCONTROLLER_H
+
+namespace o2::quality_control::core
+{
+
+/// \brief Adapts the duration of the cycles of a task to the cost of its publication.
+///
+/// The publication (endOfCycle, serialization and sending of the objects) is an overhead paid once per cycle.
+/// The controller chooses the shortest cycle for which this overhead stays under the budget, i.e. for which
+/// cost / (duration + cost) <= budget, within the given bounds. Light tasks thus publish often and heavy tasks
+/// rarely. The cost is smoothed over the cycles and the duration changes by a factor 2 at most from one cycle to
+/// the next, so that a single slow publication does not make the task silent for a long time.
+class CycleDurationController
+{
+ public:
+  /// \param initialDuration duration of the first cycle, in seconds
+  /// \param minDuration minimum duration of a cycle, in seconds
+  /// \param maxDuration maximum duration of a cycle, in seconds
+  /// \param budget maximum fraction of the time spent publishing, e.g. 0.05
+  CycleDurationController(double initialDuration, double minDuration, double maxDuration, double budget);
+
+  /// Records the time spent publishing at the end of a cycle and computes the duration of the next one.
+  void update(double publicationDuration);
+  /// \return the duration of the current cycle, in seconds
+  double getCycleDuration() const { return mCycleDuration; }
+
+ private:
+  double mMinDuration;
+  double mMaxDuration;
+  double mBudget;
+  double mCycleDuration;
+  double mPublicationCost = -1; // smoothed, negative until the first publication
+};
+
+} // namespace o2::quality_control::core
+
+#endif // QC_CORE_CYCLEDURATIONCONTROLLER_H
@@ -17,6 +17,8 @@
 #define QUALITYCONTROL_DATAPRODUCER_H
 
 #include <Framework/DataProcessorSpec.h>
+#include <string>
+#include <vector>
 
 namespace o2::quality_control::core
 {
@@ -51,6 +53,52 @@ framework::AlgorithmSpec
   getDataProducerAlgorithm(framework::ConcreteDataMatcher output, size_t minSize, size_t maxSize, double rate,
                            uint64_t amount = 0, std::string monitoringUrl = "", bool fill = true);
 
+/// \brief Distribution of the time intervals between the messages of a pooled data producer
+enum class RateProfile {
+  Constant, ///< messages evenly spaced by 1/rate
+  Poisson,  ///< exponentially distributed intervals with mean 1/rate
+  Bursty    ///< bursts of burstSize messages sent back-to-back, spaced by burstSize/rate
+};
+
+/// \brief Parameters of a pooled data producer
+struct PooledDataProducerConfig {
+  size_t minSize = 1;     ///< Minimum size of a generated payload in bytes
+  size_t maxSize = 10000; ///< Maximum size of a generated payload in bytes, or of a replayed message
+  double rate = 10.0;     ///< How many messages to produce in one second on each output, 0 for as fast as possible
+  uint64_t amount = 0;    ///< How many messages to produce in total on each output (0 for inf)
+  RateProfile rateProfile = RateProfile::Constant;
+  size_t burstSize = 1;    ///< Number of messages in a burst, for RateProfile::Bursty
+  size_t poolSize = 64;    ///< Number of payloads generated at initialization
+  std::string replayFile;  ///< If not empty, the pool is made of the content of this file instead of random data
+  size_t fanOut = 1;       ///< Number of SubSpecifications the producer publishes on
+  std::string monitoringUrl;
+};
+
+/// \brief Returns a data producer specification which publishes pooled payloads on {"TST", "RAWDATA", <subSpec>}
+///
+/// The SubSpecifications are index * fanOut ... (index + 1) * fanOut - 1, so several producers do not overlap.
+///
+/// \param config       Parameters of the producer
+/// \param index        Index of the data producer (useful when more than one needed)
+/// \param timepipeline How many copies of the producer
+///
+/// \return             A pooled data producer specification
+framework::DataProcessorSpec
+  getPooledDataProducerSpec(const PooledDataProducerConfig& config, size_t index = 0, size_t timepipeline = 1);
+
+/// \brief Returns an algorithm sending payloads taken from a pool prepared at initialization
+///
+/// Contrary to getDataProducerAlgorithm, the messages are not generated on the fly, but copied from a ring of
+/// payloads which is either generated randomly or read from a raw data file. This way the producer can saturate
+/// the QC tasks under test. Each iteration sends one message on each of the outputs.
+///
+/// \param outputs Origin, Description and SubSpecification of data to be produced
+/// \param config  Parameters of the producer
+///
+/// \return        A pooled data producer algorithm
+framework::AlgorithmSpec
+  getPooledDataProducerAlgorithm(std::vector<framework::ConcreteDataMatcher> outputs, const PooledDataProducerConfig& config);
+
 } // namespace o2::quality_control::core
 
 #endif //QUALITYCONTROL_DATAPRODUCER_H
@@ -16,6 +16,7 @@
 #ifndef QC_REPOSITORY_DATABASEINTERFACE_H
 #define QC_REPOSITORY_DATABASEINTERFACE_H
 
+#include <cstdint>
 #include <string>
 #include <memory>
 #include <vector>
@@ -171,6 +172,13 @@ class DatabaseInterface
    */
   virtual void prepareTaskDataContainer(std::string taskName) = 0;
   virtual std::vector<std::string> getPublishedObjectNames(std::string taskName) = 0;
+  /**
+   * \brief Returns a vector of all 'valid from' timestamps for an object.
+   * The backends which cannot list the versions of an object return an empty vector.
+   * \param path Path of the object.
+   * \return A vector of all 'valid from' timestamps for an object in non-descending order.
+   */
+  virtual std::vector<uint64_t> getTimestampsForObject(std::string /*path*/) { return {}; }
   /**
    * Delete all versions of a given object
    * @param taskName Task sending the object
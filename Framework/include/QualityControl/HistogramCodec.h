@@ -0,0 +1,52 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   HistogramCodec.h
+///
+
+#ifndef QC_CORE_HISTOGRAMCODEC_H
+#define QC_CORE_HISTOGRAMCODEC_H
+
+#include <memory>
+#include <vector>
+
+class TObject;
+class TH1;
+
+namespace o2::quality_control::core
+{
+
+/// \brief Compact binary encoding of the common histograms, as an alternative to the ROOT streamers.
+///
+/// It supports TH1F, TH1D, TH1I, TH2F, TH2D and TH2I, with fixed or variable bins. The bin contents and the
+/// sum of squares of weights are stored as raw arrays. When it is smaller, e.g. for sparse occupancy maps, an array
+/// is stored as runs of zeros and of literal values, the lengths being varints. No class or streamer information is
+/// written. Along the contents, it keeps the name, title, option, entries, statistics, minimum, maximum, status
+/// bits, line/fill/marker attributes and the axes (bins, range, title and attributes). The histograms with
+/// functions or bin labels are not supported, they should use the ROOT streamers.
+/// The encoding is native and versioned, it is meant for the data exchanged between the devices of one node.
+class HistogramCodec
+{
+ public:
+  static constexpr unsigned char Version = 1;
+
+  /// \return true if the object can be encoded by this codec
+  static bool canEncode(const TObject* object);
+  /// Appends the encoded histogram to the output.
+  static void encode(const TH1& histogram, std::vector<char>& output);
+  /// \return the decoded histogram, which is not attached to any directory
+  /// \throw std::runtime_error if the data is not a valid encoded histogram
+  static std::unique_ptr<TH1> decode(const char* data, size_t size);
+};
+
+} // namespace o2::quality_control::core
+
+#endif // QC_CORE_HISTOGRAMCODEC_H
@@ -18,6 +18,7 @@
 
 #include <vector>
 #include <string>
+#include <boost/property_tree/ptree_fwd.hpp>
 
 namespace o2::framework
 {
@@ -149,6 +150,9 @@ class InfrastructureGenerator
   static vector<framework::OutputSpec> generateCheckRunners(framework::WorkflowSpec& workflow, std::string configurationSource);
   static void generateAggregator(framework::WorkflowSpec& workflow, std::string configurationSource, vector<framework::OutputSpec>& checkRunnerOutputs);
   static void generatePostProcessing(framework::WorkflowSpec& workflow, std::string configurationSource);
+  /// \brief Creates the TaskRunner of a task which runs on the same node as its CheckRunners
+  /// \throw std::runtime_error if the publicationFormat is not collection, objectTable or compactObjectTable
+  static framework::DataProcessorSpec generateTaskRunner(std::string taskName, std::string configurationSource, const boost::property_tree::ptree& taskConfig);
 };
 
 } // namespace core
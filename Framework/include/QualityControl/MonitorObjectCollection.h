@@ -18,6 +18,7 @@
 
 #include <TObjArray.h>
 #include <Mergers/MergeInterface.h>
+#include "QualityControl/Tracer.h"
 
 namespace o2::quality_control::core
 {
@@ -29,7 +30,14 @@ class MonitorObjectCollection : public TObjArray, public mergers::MergeInterface
   ~MonitorObjectCollection() = default;
 
   void merge(mergers::MergeInterface* const other) override;
-  ClassDefOverride(MonitorObjectCollection, 0);
+
+  void setTrace(const TraceStamps& trace) { mTrace = trace; }
+  const TraceStamps& getTrace() const { return mTrace; }
+
+ private:
+  TraceStamps mTrace; // empty unless tracing is enabled
+
+  ClassDefOverride(MonitorObjectCollection, 1);
 };
 
 } // namespace o2::quality_control::core
@@ -0,0 +1,99 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   MonitorObjectTable.h
+///
+
+#ifndef QC_CORE_MONITOROBJECTTABLE_H
+#define QC_CORE_MONITOROBJECTTABLE_H
+
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+#include <TBufferFile.h>
+
+#include "QualityControl/Tracer.h"
+
+class TObjArray;
+
+namespace o2::quality_control::core
+{
+
+class MonitorObject;
+
+/// \brief Flat table of individually serialized MonitorObjects.
+///
+/// This is the alternative to sending a whole MonitorObjectCollection between a TaskRunner and a CheckRunner which
+/// run on the same node. The table is sent as a raw DPL message, which stays in the shared memory segment of FairMQ.
+/// The CheckRunner reads the names in place and deserializes only the objects that its checks or its storage need,
+/// instead of the whole collection. The layout is native, the table must not leave the node:
+///   Header, Entry[numberOfObjects], then the name and the serialized object of each entry, then the trace
+/// Optionally, the common histograms are written with the HistogramCodec, which is faster to write and read than
+/// the ROOT streamers and much smaller for sparse histograms. The MonitorObject around them is still streamed.
+class MonitorObjectTable
+{
+ public:
+  /// \param compactHistograms - encode the histograms supported by the HistogramCodec with it
+  explicit MonitorObjectTable(bool compactHistograms = false) : mCompactHistograms(compactHistograms) {}
+
+  /// Serializes separately each MonitorObject of the array. The memory is kept from one call to the next.
+  /// \param trace - trace stamps of the objects, as the ones of a MonitorObjectCollection
+  void write(const TObjArray& objects, const TraceStamps& trace = {});
+  const std::vector<char>& getBuffer() const { return mBuffer; }
+
+  /// \brief Read-only access to a table, for example the payload of a DPL message, without copying it.
+  class View
+  {
+   public:
+    /// \throw std::runtime_error if the data is not a valid table
+    View(const char* data, size_t size);
+
+    size_t size() const;
+    /// \return the full name of the object (task/object)
+    std::string_view getName(size_t index) const;
+    /// Deserializes the object, the caller owns it.
+    /// \throw std::runtime_error if a compact histogram is corrupted
+    std::unique_ptr<MonitorObject> materialize(size_t index) const;
+    /// \return the trace stamps written with the objects, empty if there were none
+    TraceStamps getTrace() const;
+
+   private:
+    const char* mData;
+    size_t mSize;
+  };
+
+ private:
+  struct Header {
+    uint32_t magic;
+    uint32_t numberOfObjects;
+    uint64_t traceOffset;
+    uint64_t traceSize; // the stamps, each as the size of its key, the key and the value
+  };
+  struct Entry {
+    uint64_t nameOffset;
+    uint64_t nameSize;
+    uint64_t objectOffset;
+    uint64_t objectSize;
+    uint64_t histogramOffset;
+    uint64_t histogramSize; // 0 if the object is streamed together with the MonitorObject
+  };
+  static constexpr uint32_t Magic = 0x514d4f54; // "QMOT"
+
+  bool mCompactHistograms;
+  TBufferFile mObjectBuffer{ TBuffer::kWrite };
+  std::vector<char> mBuffer;
+};
+
+} // namespace o2::quality_control::core
+
+#endif // QC_CORE_MONITOROBJECTTABLE_H
@@ -21,8 +21,10 @@
 #include "QualityControl/MonitorObjectCollection.h"
 #include "QualityControl/TaskConfig.h"
 // stl
+#include <functional>
 #include <string>
 #include <memory>
+#include <vector>
 
 class TObject;
 class TObjArray;
@@ -54,6 +56,7 @@ class ObjectsManager
 
   static const std::string gDrawOptionsKey;
   static const std::string gDisplayHintsKey;
+  static const std::string gCycleDurationKey;
 
   /**
    * Start publishing the object obj, i.e. it will be pushed forward in the workflow at regular intervals.
@@ -170,6 +173,26 @@ class ObjectsManager
    */
   void updateRunNumber(int runNumber);
 
+  /**
+   * Advertise the duration of the cycle in the metadata of all the objects.
+   * It is used when the task adapts the duration of its cycles.
+   * @param seconds the duration of the cycle which is being published.
+   */
+  void updateCycleDuration(double seconds);
+
+  /**
+   * \brief Register a function which renders published objects, e.g. canvases, once per cycle.
+   * Only the last rendering of an object is published, so rendering it for each message wastes CPU. The function
+   * is called at the end of each cycle, after endOfCycle and just before the objects are published.
+   * @param renderer The function, which should update the objects it renders.
+   */
+  void registerRenderer(std::function<void()> renderer);
+
+  /**
+   * Calls the registered renderers, in the order of their registration.
+   */
+  void render();
+
  private:
   std::unique_ptr<MonitorObjectCollection> mMonitorObjects;
   std::string mTaskName;
@@ -177,6 +200,7 @@ class ObjectsManager
   std::unique_ptr<ServiceDiscovery> mServiceDiscovery;
   bool mUpdateServiceDiscovery;
   int mCurrentRunNumber = 0;
+  std::vector<std::function<void()>> mRenderers;
 };
 
 } // namespace o2::quality_control::core
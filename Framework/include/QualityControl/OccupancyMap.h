@@ -0,0 +1,126 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   OccupancyMap.h
+///
+
+#ifndef QC_CORE_OCCUPANCYMAP_H
+#define QC_CORE_OCCUPANCYMAP_H
+
+#include <TNamed.h>
+#include <TH2I.h>
+#include <Mergers/MergeInterface.h>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace o2::quality_control::core
+{
+
+/// \brief Hits per pixel of a sensor, stored sparsely.
+///
+/// This is the alternative to a TH2 for pixel hit maps, which are mostly empty at low occupancy. The pixels are
+/// numbered row by row and split by the upper 16 bits of their number in containers, as in roaring bitmaps. A
+/// container holds the sorted numbers of its fired pixels with their hits, or the hits of all its pixels once more
+/// than 4096 of them are fired. Only the containers which were hit take memory, so reset() and merge() cost as much
+/// as the fired pixels and not as the whole sensor. The map is merged by the Mergers as any MergeInterface and is
+/// converted to a TH2I for drawing and storage.
+class OccupancyMap : public TNamed, public mergers::MergeInterface
+{
+ public:
+  OccupancyMap() = default;
+  OccupancyMap(const char* name, const char* title, unsigned int columns, unsigned int rows);
+  ~OccupancyMap() override;
+
+  /// Adds hits to a pixel, the pixels outside of the map are ignored.
+  void fill(unsigned int column, unsigned int row, uint32_t hits = 1);
+  uint32_t getHits(unsigned int column, unsigned int row) const;
+  /// Calls function(column, row, hits) for each pixel with hits, row by row.
+  template <typename Function>
+  void forEachFiredPixel(Function function) const;
+  /// Removes all the hits
+  void reset();
+
+  unsigned int getColumns() const { return mColumns; }
+  unsigned int getRows() const { return mRows; }
+  /// \return the total number of hits
+  uint64_t getEntries() const { return mEntries; }
+  size_t getNumberOfFiredPixels() const;
+  /// \param axis - 1 for the columns, 2 for the rows, as in TH1::GetMean
+  double getMean(int axis) const;
+  /// \param axis - 1 for the columns, 2 for the rows, as in TH1::GetStdDev
+  double getStdDev(int axis) const;
+
+  /// \throw std::runtime_error if the other object is not an OccupancyMap with the same dimensions
+  void merge(mergers::MergeInterface* const other) override;
+  /// \return a TH2I with one bin per pixel, not attached to any directory
+  std::unique_ptr<TH2I> toHistogram() const;
+  /// Draws the map as a TH2I, which is only created then.
+  void Draw(Option_t* option = "") override;
+  /// Sets whether the statistics box of the histogram is drawn, as TH1::SetStats
+  void setStats(bool stats) { mStats = stats; }
+
+ private:
+  static constexpr unsigned int ContainerBits = 16;
+  static constexpr size_t ContainerSize = size_t(1) << ContainerBits;
+  static constexpr size_t MaxSparseSize = 4096; // beyond, the dense array of hits is smaller
+
+  bool isDense(size_t container) const { return mLows[container].empty() && !mHits[container].empty(); }
+  /// \return the index of the container, -1 if there is none
+  long findContainer(uint16_t key) const;
+  size_t findOrAddContainer(uint16_t key);
+  void add(size_t container, uint16_t low, uint32_t hits);
+  void toDense(size_t container);
+
+  uint32_t mColumns = 0;
+  uint32_t mRows = 0;
+  std::vector<uint16_t> mKeys;               // upper bits of the pixel numbers of each container, sorted
+  std::vector<std::vector<uint16_t>> mLows;  // sorted lower bits of the fired pixels of each container, empty if dense
+  std::vector<std::vector<uint32_t>> mHits;  // hits of the fired pixels of each container, or of all its pixels
+  uint64_t mEntries = 0;
+  double mSumColumns = 0; // the sums weighted by the hits give the statistics, as in TH2
+  double mSumColumns2 = 0;
+  double mSumRows = 0;
+  double mSumRows2 = 0;
+  double mSumColumnsRows = 0;
+  bool mStats = true;
+  size_t mLastContainer = 0;          //! the hits of a sensor usually come in clusters
+  std::unique_ptr<TH2I> mHistogram;   //! the last drawn histogram
+
+  ClassDefOverride(OccupancyMap, 1);
+};
+
+template <typename Function>
+void OccupancyMap::forEachFiredPixel(Function function) const
+{
+  for (size_t container = 0; container < mKeys.size(); container++) {
+    const uint32_t base = uint32_t(mKeys[container]) << ContainerBits;
+    const auto& hits = mHits[container];
+    if (isDense(container)) {
+      for (size_t low = 0; low < hits.size(); low++) {
+        if (hits[low] > 0) {
+          const uint32_t pixel = base + low;
+          function(pixel % mColumns, pixel / mColumns, hits[low]);
+        }
+      }
+    } else {
+      const auto& lows = mLows[container];
+      for (size_t index = 0; index < lows.size(); index++) {
+        const uint32_t pixel = base + lows[index];
+        function(pixel % mColumns, pixel / mColumns, hits[index]);
+      }
+    }
+  }
+}
+
+} // namespace o2::quality_control::core
+
+#endif // QC_CORE_OCCUPANCYMAP_H
@@ -19,6 +19,17 @@
 #include <InfoLogger/InfoLogger.hxx>
 #include <InfoLogger/InfoLoggerMacros.hxx>
 #include <boost/property_tree/ptree_fwd.hpp>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <memory>
+
+// The messages with a level equal or above QC_INFOLOGGER_DISCARD_FROM_LEVEL are removed at compile time,
+// as well as the Debug messages if QC_INFOLOGGER_DISCARD_DEBUG is defined.
+#ifndef QC_INFOLOGGER_DISCARD_FROM_LEVEL
+#define QC_INFOLOGGER_DISCARD_FROM_LEVEL 100
+#endif
 
 typedef AliceO2::InfoLogger::InfoLogger infologger; // not to have to type the full stuff each time
 typedef AliceO2::InfoLogger::InfoLoggerContext infoContext;
@@ -37,6 +48,10 @@ namespace o2::quality_control::core
 ///           ILOG_INST << InfoLogger::InfoLoggerMessageOption{ InfoLogger::Fatal, 1, 1, "asdf", 3 }
 ///                     << "fatal message with extra fields" << ENDM; // complex version
 ///           ILOG(Info, Ops) << "Test message with severity Info and level Ops, see InfoLoggerMacros.hxx" << ENDM;
+///           ILOG_THROTTLED(10, Warning, Support) << "at most one message every 10 seconds" << ENDM;
+///
+/// The ILOG macros do not evaluate nor format the message if its severity and level are discarded
+/// by the filters, so they can be used in hot loops.
 ///
 /// \author Barthelemy von Haller
 class QcInfoLogger : public AliceO2::InfoLogger::InfoLogger
@@ -60,6 +75,44 @@ class QcInfoLogger : public AliceO2::InfoLogger::InfoLogger
             const boost::property_tree::ptree& config,
             AliceO2::InfoLogger::InfoLoggerContext* dplContext = nullptr);
 
+  /// Whether a message would pass the discard filters set in init().
+  bool isEnabled(AliceO2::InfoLogger::InfoLogger::Severity severity, int level) const
+  {
+    return (severity != AliceO2::InfoLogger::InfoLogger::Severity::Debug || !mDiscardDebug) && level < mDiscardFromLevel;
+  }
+
+  /// Whether a message is kept at compile time.
+  static constexpr bool isCompiledIn(AliceO2::InfoLogger::InfoLogger::Severity severity, int level)
+  {
+    return (severity != AliceO2::InfoLogger::InfoLogger::Severity::Debug || !DiscardDebugAtCompileTime) &&
+           level < QC_INFOLOGGER_DISCARD_FROM_LEVEL;
+  }
+
+  /// Returns true if at least `seconds` passed since `last`, which is then updated. Used by ILOG_THROTTLED.
+  static bool throttle(std::atomic<int64_t>& last, double seconds)
+  {
+    int64_t now = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    int64_t previous = last.load(std::memory_order_relaxed);
+    if (previous != 0 && now - previous < static_cast<int64_t>(seconds * 1e9)) {
+      return false;
+    }
+    return last.compare_exchange_strong(previous, now, std::memory_order_relaxed);
+  }
+
+  const AliceO2::InfoLogger::InfoLoggerContext& getContext() const { return *mContext; }
+
+#ifdef QC_INFOLOGGER_DISCARD_DEBUG
+  static constexpr bool DiscardDebugAtCompileTime = true;
+#else
+  static constexpr bool DiscardDebugAtCompileTime = false;
+#endif
+
+  /// Turns a stream expression into void, to be used in the conditional expression of the macros.
+  struct Voidify {
+    template <typename T>
+    void operator&(T&) {}
+  };
+
  private:
   QcInfoLogger();
   ~QcInfoLogger() override = default;
@@ -71,6 +124,9 @@ class QcInfoLogger : public AliceO2::InfoLogger::InfoLogger
   // remember the contexts
   std::shared_ptr<AliceO2::InfoLogger::InfoLoggerContext> mContext = nullptr;
   AliceO2::InfoLogger::InfoLoggerContext* mDplContext = nullptr;
+  // copies of the filters given to InfoLogger, which does not expose them
+  bool mDiscardDebug = false;
+  int mDiscardFromLevel = std::numeric_limits<int>::max();
 };
 
 } // namespace o2::quality_control::core
@@ -94,11 +150,25 @@ class QcInfoLogger : public AliceO2::InfoLogger::InfoLogger
 #define ILOG(...) VA_MACRO(ILOG, void, void, __VA_ARGS__)
 // TODO understand why the zero argument does not work.
 // the code is derived from https://stackoverflow.com/questions/16683146/can-macros-be-overloaded-by-number-of-arguments
-#define ILOG0(s, t) \
-  ILOG_INST << AliceO2::InfoLogger::InfoLogger::InfoLoggerMessageOption { AliceO2::InfoLogger::InfoLogger::Severity::Info, AliceO2::InfoLogger::InfoLogger::Level::Support, AliceO2::InfoLogger::InfoLogger::undefinedMessageOption.errorCode, __FILE__, __LINE__ }
-#define ILOG1(s, t, severity) \
-  ILOG_INST << AliceO2::InfoLogger::InfoLogger::InfoLoggerMessageOption { AliceO2::InfoLogger::InfoLogger::Severity::severity, AliceO2::InfoLogger::InfoLogger::Level::Support, AliceO2::InfoLogger::InfoLogger::undefinedMessageOption.errorCode, __FILE__, __LINE__ }
-#define ILOG2(s, t, severity, level) \
-  ILOG_INST << AliceO2::InfoLogger::InfoLogger::InfoLoggerMessageOption { AliceO2::InfoLogger::InfoLogger::Severity::severity, AliceO2::InfoLogger::InfoLogger::Level::level, AliceO2::InfoLogger::InfoLogger::undefinedMessageOption.errorCode, __FILE__, __LINE__ }
+#define ILOG_SEVERITY(severity) AliceO2::InfoLogger::InfoLogger::Severity::severity
+#define ILOG_LEVEL(level) AliceO2::InfoLogger::InfoLogger::Level::level
+#define ILOG_OPTION(severity, level) \
+  AliceO2::InfoLogger::InfoLogger::InfoLoggerMessageOption { ILOG_SEVERITY(severity), ILOG_LEVEL(level), AliceO2::InfoLogger::InfoLogger::undefinedMessageOption.errorCode, __FILE__, __LINE__ }
+#define ILOG_ENABLED(severity, level)                                                                  \
+  (o2::quality_control::core::QcInfoLogger::isCompiledIn(ILOG_SEVERITY(severity), ILOG_LEVEL(level)) && \
+   ILOG_INST.isEnabled(ILOG_SEVERITY(severity), ILOG_LEVEL(level)))
+// The message is neither evaluated nor formatted if the condition is false
+#define ILOG_IF(condition, severity, level) \
+  !(condition) ? (void)0 : o2::quality_control::core::QcInfoLogger::Voidify() & ILOG_INST << ILOG_OPTION(severity, level)
+
+#define ILOG0(s, t) ILOG_IF(ILOG_ENABLED(Info, Support), Info, Support)
+#define ILOG1(s, t, severity) ILOG_IF(ILOG_ENABLED(severity, Support), severity, Support)
+#define ILOG2(s, t, severity, level) ILOG_IF(ILOG_ENABLED(severity, level), severity, level)
+
+// Logs at most once every `seconds` from the place where it is used. The lambda gives each place its own state.
+#define ILOG_THROTTLE_STATE() \
+  []() -> std::atomic<int64_t>& { static std::atomic<int64_t> last{ 0 }; return last; }()
+#define ILOG_THROTTLED(seconds, severity, level) \
+  ILOG_IF(ILOG_ENABLED(severity, level) && o2::quality_control::core::QcInfoLogger::throttle(ILOG_THROTTLE_STATE(), seconds), severity, level)
 
 #endif // QC_CORE_QCINFOLOGGER_H
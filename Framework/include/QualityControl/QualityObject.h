@@ -19,6 +19,7 @@
 #include <Common/Exceptions.h>
 // QC
 #include "QualityControl/Quality.h"
+#include "QualityControl/Tracer.h"
 
 namespace o2::quality_control::core
 {
@@ -125,6 +126,10 @@ class QualityObject : public TObject
   const std::vector<std::string> getMonitorObjectsNames() const;
   int getRunNumber() const;
   void setRunNumber(int mRunNumber);
+  /// \brief Stamps of the processing stages of the object, see Tracer.
+  void setTrace(const TraceStamps& trace) { mTrace = trace; }
+  TraceStamps& getTrace() { return mTrace; }
+  const TraceStamps& getTrace() const { return mTrace; }
 
  private:
   Quality mQuality;
@@ -134,8 +139,9 @@ class QualityObject : public TObject
   std::vector<std::string> mInputs;
   std::vector<std::string> mMonitorObjectsNames;
   int mRunNumber;
+  TraceStamps mTrace; // empty unless tracing is enabled
 
-  ClassDefOverride(QualityObject, 4);
+  ClassDefOverride(QualityObject, 5);
 };
 
 using QualityObjectsType = std::vector<std::shared_ptr<QualityObject>>;
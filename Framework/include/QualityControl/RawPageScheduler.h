@@ -0,0 +1,154 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   RawPageScheduler.h
+///
+
+#ifndef QC_CORE_RAWPAGESCHEDULER_H
+#define QC_CORE_RAWPAGESCHEDULER_H
+
+#include <Framework/InputSpec.h>
+#include <Headers/DataHeader.h>
+#include <Headers/RDHAny.h>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace o2::framework
+{
+class InputRecord;
+}
+
+namespace o2::quality_control::core
+{
+
+/// \brief A raw data page of an input, as found by the DPLRawParser.
+struct RawPage {
+  const o2::header::RDHAny* rdh = nullptr;            ///< RDH of the page, to be read with o2::raw::RDHUtils
+  const char* payload = nullptr;                      ///< data following the RDH
+  size_t payloadSize = 0;                             ///< size of the data following the RDH
+  const o2::header::DataHeader* dataHeader = nullptr; ///< header of the input which contains the page
+  size_t index = 0;                                   ///< position of the page among all the pages of the inputs
+};
+
+/// \brief Decodes the raw data pages of the inputs of a task in parallel, link by link.
+///
+/// The pages are grouped in work units, one per FEE and link of each input subspecification, since the pages of a
+/// link usually have to be decoded in order while the links are independent. The work units are processed by a pool
+/// of workers, the largest first. Each worker updates its own state, e.g. counters or a decoder, so the processing
+/// needs no locks. The states are then merged by the calling thread, typically into the histograms of the task:
+///
+///   mScheduler.run(ctx.inputs(), mWorkerStates,
+///                  [](WorkerState& state, const RawPage& page) { ... },
+///                  [this](WorkerState& state) { ... state.clear(); });
+///
+/// The workers are created once and wait for the next inputs, the work units keep their memory across inputs.
+/// With one worker, all the pages are processed by the calling thread.
+class RawPageScheduler
+{
+ public:
+  /// \brief The pages of one link of an input subspecification, in the order of the inputs.
+  struct WorkUnit {
+    uint64_t key = 0;
+    uint16_t feeId = 0;
+    uint8_t linkId = 0;
+    size_t size = 0; ///< total size of the payloads of the pages
+    std::vector<RawPage> pages;
+  };
+
+  /// \param nWorkers - number of workers including the calling thread, at least 1
+  explicit RawPageScheduler(size_t nWorkers = 1);
+  ~RawPageScheduler();
+  RawPageScheduler(const RawPageScheduler&) = delete;
+  RawPageScheduler& operator=(const RawPageScheduler&) = delete;
+
+  size_t getNumberOfWorkers() const { return mThreads.size() + 1; }
+
+  /// Removes the pages of the previous inputs.
+  void clear();
+  /// Adds a page to the work unit of its link.
+  void addPage(const RawPage& page);
+  /// Replaces the pages with the ones of the inputs which match the filter, all the raw inputs if it is empty.
+  void split(framework::InputRecord& inputs, const std::vector<framework::InputSpec>& filter = {});
+
+  /// \return the work units with pages, the largest first
+  std::vector<const WorkUnit*> getWorkUnits() const;
+  size_t getNumberOfPages() const { return mNumberOfPages; }
+
+  /// Calls process(states[worker], page) for all the pages. The pages of a work unit are processed in order by the
+  /// same worker. The first exception thrown by process() is rethrown once all the workers are done.
+  /// \throw std::invalid_argument if there are less states than workers
+  template <typename State, typename Process>
+  void process(std::vector<State>& states, Process process)
+  {
+    if (states.size() < getNumberOfWorkers()) {
+      throw std::invalid_argument("RawPageScheduler needs one state per worker, got " + std::to_string(states.size()) +
+                                  " for " + std::to_string(getNumberOfWorkers()) + " workers");
+    }
+    dispatch([&states, &process](const WorkUnit& unit, size_t worker) {
+      auto& state = states[worker];
+      for (const auto& page : unit.pages) {
+        process(state, page);
+      }
+    });
+  }
+
+  /// Splits the inputs, processes their pages and calls merge(state) for each worker state, in the calling thread.
+  template <typename State, typename Process, typename Merge>
+  void run(framework::InputRecord& inputs, std::vector<State>& states, Process process, Merge merge,
+           const std::vector<framework::InputSpec>& filter = {})
+  {
+    split(inputs, filter);
+    this->process(states, process);
+    for (auto& state : states) {
+      merge(state);
+    }
+  }
+
+ private:
+  using UnitFunction = std::function<void(const WorkUnit&, size_t)>;
+
+  /// Runs the function on all the work units with pages, with all the workers.
+  void dispatch(const UnitFunction& function);
+  /// Takes work units until there are none left.
+  void processUnits(size_t worker);
+  /// Loop of the threads of the pool.
+  void work(size_t worker);
+
+  std::vector<WorkUnit> mWorkUnits;                  // all the links seen so far, with or without pages
+  std::unordered_map<uint64_t, size_t> mUnitIndices; // key -> index in mWorkUnits
+  std::vector<size_t> mActiveUnits;                  // indices of the work units with pages, the largest first
+  bool mSorted = true;
+  size_t mNumberOfPages = 0;
+
+  std::vector<std::thread> mThreads;
+  std::mutex mMutex;
+  std::condition_variable mStartCondition;
+  std::condition_variable mDoneCondition;
+  uint64_t mGeneration = 0;   // incremented for each dispatch, wakes up the threads
+  size_t mRunningThreads = 0; // threads which did not finish the current dispatch
+  bool mStop = false;
+  const UnitFunction* mFunction = nullptr;
+  std::atomic<size_t> mNextUnit{ 0 };
+  std::exception_ptr mException;
+};
+
+} // namespace o2::quality_control::core
+
+#endif // QC_CORE_RAWPAGESCHEDULER_H
@@ -16,10 +16,15 @@
 #define QC_SERVICEDISCOVERY_H
 
 #include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <curl/curl.h>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <string>
 #include <thread>
+#include <vector>
 #include <boost/asio/ip/host_name.hpp>
 
 namespace o2::quality_control::core
@@ -29,6 +34,10 @@ namespace o2::quality_control::core
 ///
 /// Register a endpoint to Consul which then performs health checks it
 /// Allow to publish list of online objects
+///
+/// The registrations are sent by a background thread, so that a slow Consul never stalls the caller.
+/// Requests arriving within RegistrationDelay are merged and only the latest list of objects is sent,
+/// if it differs from the one already registered.
 class ServiceDiscovery
 {
  public:
@@ -43,11 +52,16 @@ class ServiceDiscovery
   /// Stops the health thread and deregisteres from Consul health checks
   ~ServiceDiscovery();
 
-  /// Registers list of online objects by sending HTTP PUT request to Consul server
+  /// Requests the registration of the list of online objects, it is sent as an HTTP PUT request to Consul
+  /// by the registration thread.
   /// \param objects 		List of comma separated objects
   void _register(const std::string& objects);
 
-  /// Deregisters service
+  /// Requests the registration of the list of online objects
+  /// \param objects 		List of objects
+  void _register(std::vector<std::string> objects);
+
+  /// Deregisters service, the pending registration, if any, is dropped
   void deregister();
 
   static inline std::string GetDefaultUrl() ///< Provides default health check URL
@@ -61,6 +75,7 @@ class ServiceDiscovery
   }
 
   static constexpr size_t DefaultHealthPort = 7777; ///< Health check default port
+  static constexpr std::chrono::milliseconds RegistrationDelay{ 500 }; ///< Delay during which registrations are merged
 
  private:
   /// Custom deleter of CURL object
@@ -76,14 +91,29 @@ class ServiceDiscovery
   std::thread mHealthThread;        ///< Health check thread
   std::atomic<bool> mThreadRunning; ///< Health check thread running flag
 
+  std::thread mRegistrationThread;                        ///< Registration thread
+  bool mRegistrationRunning = true;                       ///< Registration thread running flag, guarded by mRegistrationMutex
+  std::mutex mRegistrationMutex;                          ///< Guards the pending registration
+  std::condition_variable mRegistrationCondition;         ///< Wakes up the registration thread
+  std::optional<std::vector<std::string>> mPendingObjects; ///< Latest objects list which was not registered yet
+  std::string mRegisteredPayload;                         ///< Last payload sent, guarded by mCurlMutex
+  std::mutex mCurlMutex;                                  ///< Serializes the requests
+
   /// Initializes CURL
   CURL* initCurl();
 
-  /// Sends PUT request
-  void send(const std::string& path, std::string&& request);
+  /// Sends PUT request, mCurlMutex must be held
+  /// \return The error message, empty if the request succeeded
+  std::string send(const std::string& path, std::string&& request);
+
+  /// Builds the JSON registration request
+  std::string createRegistrationPayload(const std::vector<std::string>& objects) const;
 
   /// Health check thread loop
   void runHealthServer(unsigned int port);
+
+  /// Registration thread loop
+  void runRegistration();
 };
 
 } // namespace o2::quality_control::core
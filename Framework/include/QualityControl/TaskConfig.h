@@ -28,6 +28,10 @@ struct TaskConfig {
   std::string moduleName;
   std::string className;
   int cycleDurationSeconds;
+  // adaptive cycle duration, enabled if the budget is positive
+  double cyclePublicationBudget = 0; // maximum fraction of the time spent publishing
+  int minCycleDurationSeconds = 0;
+  int maxCycleDurationSeconds = 0;
   int maxNumberCycles;
   std::string consulUrl;
   std::string conditionUrl = "";
@@ -29,7 +29,10 @@
 #include <Framework/InitContext.h>
 // QC
 #include "QualityControl/TaskConfig.h"
+#include "QualityControl/CycleDurationController.h"
+#include "QualityControl/MonitorObjectTable.h"
 #include "QualityControl/TaskInterface.h"
+#include "QualityControl/Tracer.h"
 
 namespace o2::configuration
 {
@@ -90,6 +93,10 @@ class TaskRunner : public framework::Task
   const framework::Options getOptions() { return mOptions; };
 
   void setResetAfterPublish(bool);
+  /// \brief Publish the objects as a MonitorObjectTable instead of a MonitorObjectCollection.
+  /// Only for a CheckRunner on the same node, Mergers cannot read it.
+  /// \param compactHistograms - write the common histograms with the HistogramCodec instead of the ROOT streamers
+  void setPublishObjectTable(bool publishObjectTable, bool compactHistograms = false);
 
   /// \brief ID string for all TaskRunner devices
   static std::string createTaskRunnerIdString();
@@ -115,6 +122,7 @@ class TaskRunner : public framework::Task
   void startOfActivity();
   void endOfActivity();
   void startCycle();
+  bool isCycleOver();
   void finishCycle(framework::DataAllocator& outputs);
   int publish(framework::DataAllocator& outputs);
   void publishCycleStats();
@@ -127,6 +135,9 @@ class TaskRunner : public framework::Task
   std::shared_ptr<monitoring::Monitoring> mCollector;
   std::shared_ptr<TaskInterface> mTask;
   bool mResetAfterPublish = false;
+  bool mPublishObjectTable = false;
+  bool mCompactHistograms = false;
+  std::unique_ptr<MonitorObjectTable> mObjectTable; // reused from one cycle to the next
   std::shared_ptr<ObjectsManager> mObjectsManager;
   int mRunNumber;
 
@@ -143,6 +154,7 @@ class TaskRunner : public framework::Task
   bool mCycleOn = false;
   bool mNoMoreCycles = false;
   int mCycleNumber = 0;
+  std::unique_ptr<CycleDurationController> mCycleDurationController; // null unless the cycle duration is adaptive
 
   // stats
   int mNumberMessagesReceivedInCycle = 0;
@@ -152,6 +164,10 @@ class TaskRunner : public framework::Task
   uint64_t mDataReceivedInCycle = 0;
   AliceO2::Common::Timer mTimerTotalDurationActivity;
   AliceO2::Common::Timer mTimerDurationCycle;
+
+  // tracing
+  Tracer mTracer;
+  TraceStamps mTrace; // stamps of the current cycle
 };
 
 } // namespace o2::quality_control::core
@@ -42,8 +42,11 @@ class TaskRunnerFactory
   /// \param configurationSource - absolute path to configuration file, preceded with backend (f.e. "json://")
   /// \param id - subSpecification for taskRunner's OutputSpec, useful to avoid outputs collisions one more complex topologies
   /// \param resetAfterPublish - should taskRunner reset the user's task after each MO publication
+  /// \param publishObjectTable - should taskRunner publish a MonitorObjectTable, only for a CheckRunner on the same node
+  /// \param compactHistograms - should the MonitorObjectTable contain the common histograms in the compact encoding
   o2::framework::DataProcessorSpec
-    create(std::string taskName, std::string configurationSource, size_t id = 0, bool resetAfterPublish = false);
+    create(std::string taskName, std::string configurationSource, size_t id = 0, bool resetAfterPublish = false,
+           bool publishObjectTable = false, bool compactHistograms = false);
 
   /// \brief Provides necessary customization of the TaskRunners.
   ///
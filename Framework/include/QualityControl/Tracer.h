@@ -0,0 +1,89 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   Tracer.h
+///
+
+#ifndef QC_CORE_TRACER_H
+#define QC_CORE_TRACER_H
+
+#include <cstdint>
+#include <fstream>
+#include <initializer_list>
+#include <map>
+#include <string>
+#include <unordered_map>
+
+namespace o2::quality_control::core
+{
+
+/// Cycle of the task which produced an object and times, in microseconds since epoch, at which the object
+/// completed each of its processing stages. The cycle is stored under the key Tracer::CycleKey.
+using TraceStamps = std::map<std::string, uint64_t>;
+
+/// \brief Exports the processing stages of the objects as spans in the Chrome trace event format.
+///
+/// The MonitorObjectCollections and QualityObjects carry TraceStamps along the topology. Each device stamps the
+/// stages it performs and exports the corresponding spans to its own file, which can be opened in chrome://tracing
+/// or ui.perfetto.dev. The span of a stage starts at the previous stamp of the object, so that it includes the
+/// waiting and the transport and the spans of a cycle are contiguous along the critical path.
+/// The files of the devices can be merged by concatenating their events.
+/// Tracing is enabled by setting "qc.config.tracing.directory". When it is disabled, the devices do not stamp.
+class Tracer
+{
+ public:
+  /// Processing stages, in the order in which an object goes through them.
+  enum class Stage {
+    StartOfCycle,
+    MonitorData, // end of the last monitorData() of the cycle
+    Publish,
+    Merge,
+    Check,
+    Store,
+    Aggregate
+  };
+  static constexpr const char* CycleKey = "cycle";
+
+  Tracer() = default;
+  ~Tracer();
+  Tracer(const Tracer&) = delete;
+  Tracer& operator=(const Tracer&) = delete;
+  Tracer(Tracer&&) = default;
+  Tracer& operator=(Tracer&&) = default;
+
+  /// Opens the file <directory>/qc-trace-<deviceName>.json. Tracing stays disabled if the directory is empty.
+  void init(const std::string& directory, const std::string& deviceName);
+  bool isEnabled() const { return mFile.is_open(); }
+
+  /// Writes the spans of the given stages of an object, if they were stamped.
+  void exportSpans(const TraceStamps& stamps, const std::string& objectName, std::initializer_list<Stage> stages);
+
+  static const char* getStageName(Stage stage);
+  /// Records that the stage is completed now.
+  static void stamp(TraceStamps& stamps, Stage stage);
+  /// \return the stamp of the stage, 0 if it was not stamped
+  static uint64_t getStamp(const TraceStamps& stamps, Stage stage);
+  /// \return the most recent stamp, 0 if there is none
+  static uint64_t getLastStamp(const TraceStamps& stamps);
+
+ private:
+  int getThreadId(const std::string& objectName);
+  void writeEvent(const std::string& event);
+
+  std::ofstream mFile;
+  int mProcessId = 0;
+  bool mFirstEvent = true;
+  std::unordered_map<std::string, int> mThreadIds; // one row per object in the trace viewer
+};
+
+} // namespace o2::quality_control::core
+
+#endif // QC_CORE_TRACER_H
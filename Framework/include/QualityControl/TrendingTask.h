@@ -39,6 +39,9 @@ namespace o2::quality_control::postprocessing
 /// class exposes the TTree::Draw interface to the user. The TTree and plots are stored in the QCDB. The class is
 /// configured with configuration files, see Framework/postprocessing.json as an example.
 ///
+/// With the option "resumeTrend", the task continues the last TTree stored in the QCDB if its branches match the
+/// data sources. Only the versions of the data sources stored after its last entry are trended at initialization.
+///
 /// \author Piotr Konopka
 class TrendingTask : public PostProcessingInterface
 {
@@ -57,8 +60,16 @@ class TrendingTask : public PostProcessingInterface
   };
 
   void trendValues(uint64_t timestamp, repository::DatabaseInterface&);
+  void updateReductor(const TrendingTaskConfig::DataSource&, uint64_t timestamp, repository::DatabaseInterface&);
   void generatePlots();
 
+  /// Retrieves the last stored trend and continues it if its branches match the data sources.
+  /// \return true if the trend was resumed
+  bool resumeTrend(repository::DatabaseInterface&);
+  bool isCompatible(TTree& trend) const;
+  /// Trends the versions of the data sources stored since the last entry of the resumed trend, up to the timestamp.
+  void backfillTrend(uint64_t until, repository::DatabaseInterface&);
+
   TrendingTaskConfig mConfig;
   MetaData mMetaData;
   UInt_t mTime;
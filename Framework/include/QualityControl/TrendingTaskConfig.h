@@ -49,6 +49,7 @@ struct TrendingTaskConfig : PostProcessingConfig {
 
   std::vector<Plot> plots;
   std::vector<DataSource> dataSources;
+  bool resumeTrend = false; // continue the trend stored in the repository instead of starting a new one
 };
 
 } // namespace o2::quality_control::postprocessing
@@ -63,6 +63,7 @@ Aggregator::Aggregator(const std::string& aggregatorName, const boost::property_
           source.objects.push_back(name);
         }
       }
+      mSourcesObjects[source.name].insert(source.objects.begin(), source.objects.end());
       mSources.emplace_back(source); // keep track of the sources
     }
   }
@@ -95,51 +96,69 @@ void Aggregator::init()
   }
 }
 
-QualityObjectsMapType Aggregator::filter(QualityObjectsMapType& qoMap)
+bool Aggregator::accepts(const std::string& name, const QualityObject& qo) const
 {
-  // This is a basic implementation, if it needs to be more efficient it will have to be rethought.
-  // for each qo in the list we receive, check if a source of this aggregator contains it (or rather
-  // contains the first part of its checkName before `/`).
+  // find the source for this qo, i.e. the first part of its checkName before `/`
+  const auto& checkName = qo.getCheckName();
+  auto source = mSourcesObjects.find(checkName.substr(0, checkName.find('/')));
+  if (source == mSourcesObjects.end()) {
+    return false;
+  }
+  // if the source has no qos specified we accept it, otherwise it must be one of them.
+  return source->second.empty() || source->second.count(name) > 0;
+}
 
+QualityObjectsMapType Aggregator::filter(QualityObjectsMapType& qoMap)
+{
   QualityObjectsMapType result;
   for (auto const& [name, qo] : qoMap) {
-
-    // find the source for this qo
-    shared_ptr<const QualityObject> local = qo;
-    auto it = std::find_if(mSources.begin(), mSources.end(),
-                           [&local](const AggregatorSource source) {
-                             std::string token = local->getCheckName().substr(0, local->getCheckName().find("/"));
-                             return token == source.name;
-                           });
-
-    // if no source found, it is not here
-    if (it == mSources.end()) {
-      continue;
-    }
-
-    // search the qo in the objects of the source, if found we accept it.
-    // if the source has no qos specified we accept it.
-    auto source = *it;
-    if (source.objects.empty() ||
-        find(source.objects.begin(), source.objects.end(), name) != source.objects.end()) { // no qo specified, we accept all
+    if (accepts(name, *qo)) {
       result[name] = qo;
     }
   }
-
   return result;
 }
 
+bool Aggregator::update(const std::shared_ptr<const QualityObject>& qo)
+{
+  if (!accepts(qo->getName(), *qo)) {
+    return false;
+  }
+  mInputs[qo->getName()] = qo;
+  return true;
+}
+
 QualityObjectsType Aggregator::aggregate(QualityObjectsMapType& qoMap)
 {
   auto filtered = filter(qoMap);
-  auto results = mAggregatorInterface->aggregate(filtered);
+  return createQualityObjects(mAggregatorInterface->aggregate(filtered));
+}
+
+QualityObjectsType Aggregator::aggregate()
+{
+  return createQualityObjects(mAggregatorInterface->aggregate(mInputs));
+}
+
+QualityObjectsType Aggregator::createQualityObjects(const std::map<std::string, Quality>& qualities) const
+{
+  // The outputs are traced as the latest of the inputs, it is the one which delayed the aggregation.
+  const TraceStamps* latest = nullptr;
+  for (const auto& [name, qo] : mInputs) {
+    if (!qo->getTrace().empty() && (latest == nullptr || Tracer::getLastStamp(qo->getTrace()) > Tracer::getLastStamp(*latest))) {
+      latest = &qo->getTrace();
+    }
+  }
+
   QualityObjectsType qualityObjects;
-  for (auto const& [qualityName, quality] : results) {
+  for (auto const& [qualityName, quality] : qualities) {
     qualityObjects.emplace_back(std::make_shared<QualityObject>(
       quality,
       mAggregatorConfig.name + "/" + qualityName,
       mAggregatorConfig.detectorName,
       mAggregatorConfig.policyType));
+    if (latest != nullptr) {
+      qualityObjects.back()->setTrace(*latest);
+    }
   }
   return qualityObjects;
 }
@@ -103,6 +103,7 @@ void AggregatorRunner::init(framework::InitContext& iCtx)
     initDatabase();
     initMonitoring();
     initServiceDiscovery();
+    mTracer.init(mConfigFile->get<std::string>("qc.config.tracing.directory", ""), mDeviceName);
     initAggregators();
   } catch (...) {
     ILOG(Fatal) << "Unexpected exception during initialization:\n"
@@ -126,9 +127,9 @@ void AggregatorRunner::run(framework::ProcessingContext& ctx)
     shared_ptr<const QualityObject> qo = inputs.get<QualityObject*>(ref);
     if (qo != nullptr) {
       ILOG(Debug, Trace) << "   It is a qo: " << qo->getName() << ENDM;
-      mQualityObjects[qo->getName()] = qo;
       mTotalNumberObjectsReceived++;
       updatePolicyManager.updateObjectRevision(qo->getName());
+      dispatch(qo);
     }
   }
 
@@ -140,34 +141,55 @@ void AggregatorRunner::run(framework::ProcessingContext& ctx)
   sendPeriodicMonitoring();
 }
 
-QualityObjectsType AggregatorRunner::aggregate()
+void AggregatorRunner::dispatch(const std::shared_ptr<const QualityObject>& qo)
 {
-  ILOG(Debug, Trace) << "Aggregate called in AggregatorRunner, QOs in cache: " << mQualityObjects.size() << ENDM;
+  const auto& checkName = qo->getCheckName();
+  auto readers = mAggregatorsBySource.find(checkName.substr(0, checkName.find('/')));
+  if (readers == mAggregatorsBySource.end()) {
+    return;
+  }
+  for (auto index : readers->second) {
+    if (mAggregators[index]->update(qo)) {
+      mAggregatorsToUpdate[index] = true;
+    }
+  }
+}
 
+QualityObjectsType AggregatorRunner::aggregate()
+{
   QualityObjectsType allQOs;
-  for (auto const& aggregator : mAggregators) {
+  // The aggregators are sorted such that the sources of an aggregator always come before it. Executing
+  // one of them can thus only mark for update the ones which are further in the list.
+  for (size_t index = 0; index < mAggregators.size(); index++) {
+    if (!mAggregatorsToUpdate[index]) {
+      continue; // none of its inputs changed since its last execution
+    }
+    auto const& aggregator = mAggregators[index];
     string aggregatorName = aggregator->getName();
-    ILOG(Info, Devel) << "Processing aggregator: " << aggregatorName << ENDM;
+    ILOG(Debug, Devel) << "Processing aggregator: " << aggregatorName << ENDM;
 
     if (updatePolicyManager.isReady(aggregatorName)) {
-      ILOG(Info, Devel) << "   Quality Objects for the aggregator '" << aggregatorName << "' are  ready, aggregating" << ENDM;
-      auto newQOs = aggregator->aggregate(mQualityObjects); // we give the whole list
+      ILOG(Debug, Devel) << "   Quality Objects for the aggregator '" << aggregatorName << "' are  ready, aggregating" << ENDM;
+      auto newQOs = aggregator->aggregate(); // it only sees the QOs of its sources
       mTotalNumberObjectsProduced += newQOs.size();
       mTotalNumberAggregatorExecuted++;
+      mAggregatorsToUpdate[index] = false;
       // we consider the output of the aggregators the same way we do the output of a check
       for (const auto& qo : newQOs) {
-        mQualityObjects[qo->getName()] = qo;
+        qo->setRunNumber(mRunNumber);
+        if (mTracer.isEnabled()) {
+          Tracer::stamp(qo->getTrace(), Tracer::Stage::Aggregate);
+        }
         updatePolicyManager.updateObjectRevision(qo->getName());
+        dispatch(qo);
       }
-      // set the run number on all objects
-      for_each(newQOs.begin(), newQOs.end(), [&mRunNumber = mRunNumber](std::shared_ptr<QualityObject>& qo) -> void { qo->setRunNumber(mRunNumber); });
 
       allQOs.insert(allQOs.end(), std::make_move_iterator(newQOs.begin()), std::make_move_iterator(newQOs.end()));
       newQOs.clear();
 
       updatePolicyManager.updateActorRevision(aggregatorName); // Was aggregated, update latest revision
     } else {
-      ILOG(Info, Devel) << "   Quality Objects for the aggregator '" << aggregatorName << "' are not ready, ignoring" << ENDM;
+      ILOG(Debug, Devel) << "   Quality Objects for the aggregator '" << aggregatorName << "' are not ready, ignoring" << ENDM;
     }
   }
   return allQOs;
@@ -175,10 +197,11 @@ QualityObjectsType AggregatorRunner::aggregate()
 
 void AggregatorRunner::store(QualityObjectsType& qualityObjects)
 {
-  ILOG(Info, Devel) << "Storing " << qualityObjects.size() << " QualityObjects" << ENDM;
+  ILOG(Debug, Devel) << "Storing " << qualityObjects.size() << " QualityObjects" << ENDM;
   try {
     for (auto& qo : qualityObjects) {
       mDatabase->storeQO(qo);
+      mTracer.exportSpans(qo->getTrace(), qo->getName(), { Tracer::Stage::Aggregate });
     }
   } catch (boost::exception& e) {
     ILOG(Info, Devel) << "Unable to " << diagnostic_information(e) << ENDM;
@@ -249,6 +272,15 @@ void AggregatorRunner::initAggregators()
   }
 
   reorderAggregators();
+
+  // index the aggregators by the name of their sources, so that a QO is only given to the ones reading it
+  mAggregatorsBySource.clear();
+  for (size_t index = 0; index < mAggregators.size(); index++) {
+    for (const auto& source : mAggregators[index]->getSources()) {
+      mAggregatorsBySource[source.name].push_back(index);
+    }
+  }
+  mAggregatorsToUpdate.assign(mAggregators.size(), false);
 }
 
 bool AggregatorRunner::areSourcesIn(const std::vector<AggregatorSource>& sources,
@@ -0,0 +1,112 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   AsyncLogSink.cxx
+///
+
+#include "QualityControl/AsyncLogSink.h"
+
+#include <chrono>
+
+namespace o2::quality_control::core
+{
+
+AsyncLogSink::AsyncLogSink() : mCells(new Cell[Capacity])
+{
+  for (size_t i = 0; i < Capacity; i++) {
+    mCells[i].sequence.store(i, std::memory_order_relaxed);
+  }
+  mThread = std::thread([this] { run(); });
+}
+
+AsyncLogSink::~AsyncLogSink()
+{
+  mRunning = false;
+  if (mThread.joinable()) {
+    mThread.join();
+  }
+}
+
+// The ring buffer follows the bounded queue of D. Vyukov: each cell carries a sequence number telling
+// whether it can be written (sequence == position) or read (sequence == position + 1) for a given position.
+bool AsyncLogSink::push(Message&& message)
+{
+  size_t position = mEnqueuePosition.load(std::memory_order_relaxed);
+  while (true) {
+    Cell& cell = mCells[position & (Capacity - 1)];
+    size_t sequence = cell.sequence.load(std::memory_order_acquire);
+    auto difference = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position);
+    if (difference == 0) {
+      if (mEnqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+        cell.message = std::move(message);
+        cell.sequence.store(position + 1, std::memory_order_release);
+        return true;
+      }
+    } else if (difference < 0) {
+      mDropped.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    } else {
+      position = mEnqueuePosition.load(std::memory_order_relaxed);
+    }
+  }
+}
+
+bool AsyncLogSink::pop(Message& message)
+{
+  size_t position = mDequeuePosition.load(std::memory_order_relaxed);
+  Cell& cell = mCells[position & (Capacity - 1)];
+  size_t sequence = cell.sequence.load(std::memory_order_acquire);
+  if (sequence != position + 1) {
+    return false; // empty, or the producer is still writing the message
+  }
+  message = std::move(cell.message);
+  cell.sequence.store(position + Capacity, std::memory_order_release);
+  mDequeuePosition.store(position + 1, std::memory_order_release);
+  return true;
+}
+
+void AsyncLogSink::flush()
+{
+  size_t target = mEnqueuePosition.load(std::memory_order_acquire);
+  while (mDequeuePosition.load(std::memory_order_acquire) < target && mThread.joinable()) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+}
+
+void AsyncLogSink::run()
+{
+  // InfoLogger is not thread safe, we create a new instance for this thread.
+  AliceO2::InfoLogger::InfoLogger threadInfoLogger;
+  threadInfoLogger.setContext(ILOG_INST.getContext());
+
+  size_t reportedDropped = 0;
+  Message message;
+  bool running = true;
+  while (running) {
+    running = mRunning.load(); // read before draining, so that the messages pushed before stopping are sent
+    bool received = false;
+    while (pop(message)) {
+      threadInfoLogger << AliceO2::InfoLogger::InfoLogger::InfoLoggerMessageOption{ message.severity, message.level, AliceO2::InfoLogger::InfoLogger::undefinedMessageOption.errorCode, message.file, message.line }
+                       << message.text << AliceO2::InfoLogger::InfoLogger::endm;
+      received = true;
+    }
+    if (size_t dropped = getNumberDropped(); dropped != reportedDropped) {
+      threadInfoLogger << AliceO2::InfoLogger::InfoLogger::Severity::Warning << (dropped - reportedDropped)
+                       << " log messages were dropped because the asynchronous buffer was full" << AliceO2::InfoLogger::InfoLogger::endm;
+      reportedDropped = dropped;
+    }
+    if (!received && running) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+  }
+}
+
+} // namespace o2::quality_control::core
@@ -0,0 +1,102 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   BitCounter.cxx
+///
+
+#include "QualityControl/BitCounter.h"
+
+#include <TH1.h>
+#include <TH2.h>
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+namespace o2::quality_control::core
+{
+
+BitCounter::BitCounter(size_t nChannels, unsigned int nBits)
+  : mNChannels(nChannels), mNBits(nBits), mCounts(nChannels * nBits, 0)
+{
+  if (nBits > 64) {
+    throw std::invalid_argument("BitCounter counts at most 64 bits, got " + std::to_string(nBits));
+  }
+  mMask = nBits == 64 ? ~uint64_t(0) : (uint64_t(1) << nBits) - 1;
+}
+
+uint64_t BitCounter::getTotal(unsigned int bit) const
+{
+  uint64_t total = 0;
+  for (size_t channel = 0; channel < mNChannels; channel++) {
+    total += mCounts[channel * mNBits + bit];
+  }
+  return total;
+}
+
+void BitCounter::add(const BitCounter& other)
+{
+  if (other.mNChannels != mNChannels || other.mNBits != mNBits) {
+    throw std::invalid_argument("BitCounter can only add a counter of the same dimensions");
+  }
+  if (other.mEntries == 0) {
+    return;
+  }
+  for (size_t i = 0; i < mCounts.size(); i++) {
+    mCounts[i] += other.mCounts[i];
+  }
+  mEntries += other.mEntries;
+}
+
+void BitCounter::clear()
+{
+  if (mEntries > 0) {
+    std::fill(mCounts.begin(), mCounts.end(), 0);
+    mEntries = 0;
+  }
+}
+
+void BitCounter::transfer(TH2* perChannel, TH1* totals)
+{
+  if (mEntries == 0) {
+    return;
+  }
+  const double perChannelEntries = perChannel ? perChannel->GetEntries() : 0;
+  std::vector<uint64_t> bitTotals(mNBits, 0);
+  for (size_t channel = 0; channel < mNChannels; channel++) {
+    const uint32_t* counts = mCounts.data() + channel * mNBits;
+    for (unsigned int bit = 0; bit < mNBits; bit++) {
+      if (counts[bit] == 0) {
+        continue;
+      }
+      bitTotals[bit] += counts[bit];
+      if (perChannel) {
+        const int bin = perChannel->GetBin(channel + 1, bit + 1);
+        perChannel->SetBinContent(bin, perChannel->GetBinContent(bin) + counts[bit]);
+      }
+    }
+  }
+  if (perChannel) {
+    // SetBinContent counts one entry per call, the entries are set once all the bins are updated
+    perChannel->SetEntries(perChannelEntries + mEntries);
+  }
+  if (totals) {
+    const double entries = totals->GetEntries();
+    for (unsigned int bit = 0; bit < mNBits; bit++) {
+      if (bitTotals[bit] > 0) {
+        totals->SetBinContent(bit + 1, totals->GetBinContent(bit + 1) + bitTotals[bit]);
+      }
+    }
+    totals->SetEntries(entries + mEntries);
+  }
+  clear();
+}
+
+} // namespace o2::quality_control::core
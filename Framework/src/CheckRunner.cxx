@@ -25,6 +25,9 @@
 #include <Monitoring/Monitoring.h>
 // QC
 #include "QualityControl/DatabaseFactory.h"
+#include "QualityControl/MonitorObjectCollection.h"
+#include "QualityControl/MonitorObjectTable.h"
+#include "QualityControl/OccupancyMap.h"
 #include "QualityControl/ServiceDiscovery.h"
 #include "QualityControl/runnerUtils.h"
 // Fairlogger
@@ -189,6 +192,7 @@ void CheckRunner::init(framework::InitContext& iCtx)
     initDatabase();
     initMonitoring();
     initServiceDiscovery();
+    mTracer.init(mConfigFile->get<std::string>("qc.config.tracing.directory", ""), mDeviceName);
 
     // registering state machine callbacks
     iCtx.services().get<CallbackService>().set(CallbackService::Id::Start, [this, &services = iCtx.services()]() { start(services); });
@@ -196,6 +200,10 @@ void CheckRunner::init(framework::InitContext& iCtx)
     for (auto& check : mChecks) {
       check.init();
       updatePolicyManager.addPolicy(check.getName(), check.getPolicyName(), check.getObjectsNames(), check.getAllObjectsOption(), false);
+      mAllObjectsChecked = mAllObjectsChecked || check.getAllObjectsOption();
+      for (const auto& name : check.getObjectsNames()) {
+        mCheckedObjectsNames.insert(name);
+      }
     }
   } catch (...) {
     // catch the exceptions and print it (the ultimate caller might not know how to display it)
@@ -229,6 +237,14 @@ void CheckRunner::prepareCacheData(framework::InputRecord& inputRecord)
   for (const auto& input : mInputs) {
     auto dataRef = inputRecord.get(input.binding.c_str());
     if (dataRef.header != nullptr && dataRef.payload != nullptr) {
+      bool store = mInputStoreSet.count(DataSpecUtils::label(input)) > 0; // Check if this CheckRunner stores this input
+
+      // A TaskRunner on the same node might send a MonitorObjectTable, which is not serialized as a whole.
+      const auto* dataHeader = header::get<header::DataHeader*>(dataRef.header);
+      if (dataHeader != nullptr && dataHeader->payloadSerializationMethod == header::gSerializationMethodNone) {
+        readObjectTable(MonitorObjectTable::View{ dataRef.payload, dataHeader->payloadSize }, store, input.binding);
+        continue;
+      }
 
       // We don't know what we receive, so we test for an array and then try a tobject.
       // If we received a tobject, it gets encapsulated in the tobjarray.
@@ -237,48 +253,84 @@ void CheckRunner::prepareCacheData(framework::InputRecord& inputRecord)
       // if the object has not been found, it will raise an exception that we just let go.
       if (tobj->InheritsFrom("TObjArray")) {
         array = dynamic_pointer_cast<const TObjArray>(tobj);
-        mLogger << AliceO2::InfoLogger::InfoLogger::Info << "CheckRunner " << mDeviceName
-                << " received an array with " << array->GetEntries()
-                << " entries from " << input.binding << ENDM;
+        ILOG(Debug, Trace) << "CheckRunner " << mDeviceName
+                           << " received an array with " << array->GetEntries()
+                           << " entries from " << input.binding << ENDM;
       } else {
         // it is just a TObject not embedded in a TObjArray. We build a TObjArray for it.
         auto* newArray = new TObjArray();    // we cannot use `array` to add an object as it is const
         TObject* newTObject = tobj->Clone(); // we need a copy to avoid that it gets deleted behind our back.
         newArray->Add(newTObject);
         array.reset(newArray); // now that the array is ready we can adopt it.
-        mLogger << AliceO2::InfoLogger::InfoLogger::Info << "CheckRunner " << mDeviceName
-                << " received a tobject named " << tobj->GetName()
-                << " from " << input.binding << ENDM;
+        ILOG(Debug, Trace) << "CheckRunner " << mDeviceName
+                           << " received a tobject named " << tobj->GetName()
+                           << " from " << input.binding << ENDM;
+      }
+
+      // The stages up to the merger are traced once per collection, the collection is the unit they work on.
+      shared_ptr<const TraceStamps> trace = nullptr;
+      if (auto collection = dynamic_cast<const MonitorObjectCollection*>(tobj.get()); mTracer.isEnabled() && collection != nullptr && !collection->getTrace().empty()) {
+        trace = make_shared<const TraceStamps>(collection->getTrace());
+        mTracer.exportSpans(*trace, input.binding, { Tracer::Stage::Merge });
       }
 
       // for each item of the array, check whether it is a MonitorObject. If not, create one and encapsulate.
       // Then, store the MonitorObject in the various maps and vectors we will use later.
-      bool store = mInputStoreSet.count(DataSpecUtils::label(input)) > 0; // Check if this CheckRunner stores this input
       for (const auto tObject : *array) {
         std::shared_ptr<MonitorObject> mo{ dynamic_cast<MonitorObject*>(tObject) };
 
         if (mo == nullptr) {
-          mLogger << AliceO2::InfoLogger::InfoLogger::Info << "The MO is null, probably a TObject could not be casted into an MO." << ENDM;
-          mLogger << AliceO2::InfoLogger::InfoLogger::Info << "    Creating an ad hoc MO." << ENDM;
+          ILOG_THROTTLED(10, Warning, Support) << "The MO is null, probably a TObject could not be casted into an MO."
+                                               << " Creating an ad hoc MO." << ENDM;
           header::DataOrigin origin = DataSpecUtils::asConcreteOrigin(input);
           mo = std::make_shared<MonitorObject>(tObject, input.binding, origin.str);
         }
 
         if (mo) {
-          mo->setIsOwner(true);
-          mMonitorObjects[mo->getFullName()] = mo;
-          updatePolicyManager.updateObjectRevision(mo->getFullName());
-          mTotalNumberObjectsReceived++;
-
-          if (store) { // Monitor Object will be stored later, after possible beautification
-            mMonitorObjectStoreVector.push_back(mo);
-          }
+          cacheMonitorObject(mo, store, trace);
         }
       }
     }
   }
 }
 
+void CheckRunner::readObjectTable(const MonitorObjectTable::View& table, bool store, const std::string& binding)
+{
+  ILOG(Debug, Trace) << "CheckRunner " << mDeviceName << " received a table with " << table.size() << " entries" << ENDM;
+  shared_ptr<const TraceStamps> trace = nullptr;
+  if (mTracer.isEnabled()) {
+    if (auto stamps = table.getTrace(); !stamps.empty()) {
+      trace = make_shared<const TraceStamps>(std::move(stamps));
+      mTracer.exportSpans(*trace, binding, { Tracer::Stage::Merge });
+    }
+  }
+  for (size_t index = 0; index < table.size(); index++) {
+    // the objects which are neither checked nor stored here are not deserialized at all
+    if (!store && !mAllObjectsChecked && mCheckedObjectsNames.count(table.getName(index)) == 0) {
+      mTotalNumberObjectsReceived++;
+    } else if (auto mo = table.materialize(index)) {
+      cacheMonitorObject(std::move(mo), store, trace);
+    } else {
+      ILOG_THROTTLED(10, Warning, Support) << "Could not deserialize the object " << table.getName(index) << ENDM;
+    }
+  }
+}
+
+void CheckRunner::cacheMonitorObject(std::shared_ptr<MonitorObject> mo, bool store, const std::shared_ptr<const TraceStamps>& trace)
+{
+  mo->setIsOwner(true);
+  mMonitorObjects[mo->getFullName()] = mo;
+  if (trace) {
+    mMonitorObjectsTraces[mo->getFullName()] = trace;
+  }
+  updatePolicyManager.updateObjectRevision(mo->getFullName());
+  mTotalNumberObjectsReceived++;
+
+  if (store) { // Monitor Object will be stored later, after possible beautification
+    mMonitorObjectStoreVector.push_back(mo);
+  }
+}
+
 void CheckRunner::sendPeriodicMonitoring()
 {
   if (mTimer.isTimeout()) {
@@ -292,8 +344,8 @@ void CheckRunner::sendPeriodicMonitoring()
 
 QualityObjectsType CheckRunner::check()
 {
-  mLogger << "Trying " << mChecks.size() << " checks for " << mMonitorObjects.size() << " monitor objects"
-          << ENDM;
+  ILOG(Debug, Trace) << "Trying " << mChecks.size() << " checks for " << mMonitorObjects.size() << " monitor objects"
+                     << ENDM;
 
   QualityObjectsType allQOs;
   for (auto& check : mChecks) {
@@ -302,6 +354,11 @@ QualityObjectsType CheckRunner::check()
       mTotalNumberCheckExecuted += newQOs.size();
       // set the run number on all objects
       for_each(newQOs.begin(), newQOs.end(), [&mRunNumber = mRunNumber](std::shared_ptr<QualityObject>& qo) -> void { qo->setRunNumber(mRunNumber); });
+      if (mTracer.isEnabled()) {
+        for (auto& qo : newQOs) {
+          traceCheck(*qo);
+        }
+      }
 
       allQOs.insert(allQOs.end(), std::make_move_iterator(newQOs.begin()), std::make_move_iterator(newQOs.end()));
       newQOs.clear();
@@ -309,19 +366,39 @@ QualityObjectsType CheckRunner::check()
       // Was checked, update latest revision
       updatePolicyManager.updateActorRevision(check.getName());
     } else {
-      mLogger << "Monitor Objects for the check '" << check.getName() << "' are not ready, ignoring" << ENDM;
+      ILOG(Debug, Trace) << "Monitor Objects for the check '" << check.getName() << "' are not ready, ignoring" << ENDM;
     }
   }
   return allQOs;
 }
 
+void CheckRunner::traceCheck(QualityObject& qo)
+{
+  // A QO is traced as the latest of the MOs it was checked on, they are the critical path.
+  const TraceStamps* latest = nullptr;
+  for (const auto& moName : qo.getMonitorObjectsNames()) {
+    auto trace = mMonitorObjectsTraces.find(moName);
+    if (trace != mMonitorObjectsTraces.end() && (latest == nullptr || Tracer::getLastStamp(*trace->second) > Tracer::getLastStamp(*latest))) {
+      latest = trace->second.get();
+    }
+  }
+  if (latest != nullptr) {
+    qo.setTrace(*latest);
+  }
+  Tracer::stamp(qo.getTrace(), Tracer::Stage::Check);
+}
+
 void CheckRunner::store(QualityObjectsType& qualityObjects)
 {
-  mLogger << "Storing " << qualityObjects.size() << " QualityObjects" << ENDM;
+  ILOG(Debug, Devel) << "Storing " << qualityObjects.size() << " QualityObjects" << ENDM;
   try {
     for (auto& qo : qualityObjects) {
       mDatabase->storeQO(qo);
       mTotalNumberQOStored++;
+      if (mTracer.isEnabled()) {
+        Tracer::stamp(qo->getTrace(), Tracer::Stage::Store);
+        mTracer.exportSpans(qo->getTrace(), qo->getName(), { Tracer::Stage::Check, Tracer::Stage::Store });
+      }
     }
   } catch (boost::exception& e) {
     mLogger << "Unable to " << diagnostic_information(e) << ENDM;
@@ -330,10 +407,18 @@ void CheckRunner::store(QualityObjectsType& qualityObjects)
 
 void CheckRunner::store(std::vector<std::shared_ptr<MonitorObject>>& monitorObjects)
 {
-  mLogger << "Storing " << monitorObjects.size() << " MonitorObjects" << ENDM;
+  ILOG(Debug, Devel) << "Storing " << monitorObjects.size() << " MonitorObjects" << ENDM;
   try {
     for (auto& mo : monitorObjects) {
-      mDatabase->storeMO(mo);
+      if (auto occupancyMap = dynamic_cast<OccupancyMap*>(mo->getObject())) {
+        // the GUI and the other readers of the repository only know the usual ROOT classes
+        auto converted = std::make_shared<MonitorObject>(*mo);
+        converted->setObject(occupancyMap->toHistogram().release());
+        converted->setIsOwner(true);
+        mDatabase->storeMO(converted);
+      } else {
+        mDatabase->storeMO(mo);
+      }
       mTotalNumberMOStored++;
     }
   } catch (boost::exception& e) {
@@ -346,7 +431,7 @@ void CheckRunner::send(QualityObjectsType& qualityObjects, framework::DataAlloca
   // Note that we might send multiple QOs in one output, as separate parts.
   // This should be fine if they are retrieved on the other side with InputRecordWalker.
 
-  mLogger << "Sending " << qualityObjects.size() << " quality objects" << ENDM;
+  ILOG(Debug, Devel) << "Sending " << qualityObjects.size() << " quality objects" << ENDM;
   for (const auto& qo : qualityObjects) {
 
     const auto& correspondingCheck = std::find_if(mChecks.begin(), mChecks.end(), [checkName = qo->getCheckName()](const auto& check) {
@@ -373,22 +458,27 @@ void CheckRunner::updateServiceDiscovery(const QualityObjectsType& qualityObject
   // A possible optimization would be to collect the list of QOs for all checks where it is possible (i.e.
   // all but OnEachSeparately with "All" MOs). If we can get all of them, then no need to update the list
   // after initialization. Otherwise, we set the list we know in init and then add to it as we go.
-  size_t formerNumberQOsNames = mListAllQOPaths.size();
-  for (const auto& qo : qualityObjects) {
-    mListAllQOPaths.insert(qo->getPath());
-  }
+  // The names are checked first, so that the paths are only built for the QOs which are new.
   // if nothing was inserted, no need to update
-  if (mListAllQOPaths.size() == formerNumberQOsNames) {
+  if (!addQualityObjectPaths(qualityObjects, mListAllQONames, mListAllQOPaths)) {
     return;
   }
 
-  // prepare the string of comma separated objects and publish it
-  std::string objects;
-  for (auto path : mListAllQOPaths) {
-    objects += path + ",";
+  // publish the list, the registration itself is done in the background
+  mServiceDiscovery->_register(mListAllQOPaths);
+}
+
+bool CheckRunner::addQualityObjectPaths(const QualityObjectsType& qualityObjects,
+                                        std::unordered_set<std::string>& names, std::vector<std::string>& paths)
+{
+  bool inserted = false;
+  for (const auto& qo : qualityObjects) {
+    if (names.insert(qo->getName()).second) {
+      paths.push_back(qo->getPath());
+      inserted = true;
+    }
   }
-  objects.pop_back(); // remove last comma
-  mServiceDiscovery->_register(objects);
+  return inserted;
 }
 
 void CheckRunner::initDatabase()
@@ -0,0 +1,40 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   CycleDurationController.cxx
+///
+
+#include "QualityControl/CycleDurationController.h"
+
+#include <algorithm>
+
+namespace o2::quality_control::core
+{
+
+CycleDurationController::CycleDurationController(double initialDuration, double minDuration, double maxDuration, double budget)
+  : mMinDuration(minDuration),
+    mMaxDuration(std::max(minDuration, maxDuration)),
+    mBudget(std::clamp(budget, 0.001, 0.999)),
+    mCycleDuration(std::clamp(initialDuration, mMinDuration, mMaxDuration))
+{
+}
+
+void CycleDurationController::update(double publicationDuration)
+{
+  constexpr double smoothing = 0.3; // weight of the last publication
+  mPublicationCost = mPublicationCost < 0 ? publicationDuration : (1 - smoothing) * mPublicationCost + smoothing * publicationDuration;
+
+  double target = mPublicationCost * (1 - mBudget) / mBudget;
+  target = std::clamp(target, mCycleDuration / 2, mCycleDuration * 2);
+  mCycleDuration = std::clamp(target, mMinDuration, mMaxDuration);
+}
+
+} // namespace o2::quality_control::core
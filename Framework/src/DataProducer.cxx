@@ -15,7 +15,13 @@
 #include "QualityControl/DataProducer.h"
 #include "QualityControl/QcInfoLogger.h"
 
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
 #include <random>
+#include <thread>
+#include <Common/Exceptions.h>
 #include <Common/Timer.h>
 #include <Monitoring/MonitoringFactory.h>
 #include <Framework/ControlService.h>
@@ -106,4 +112,150 @@ AlgorithmSpec getDataProducerAlgorithm(ConcreteDataMatcher output, size_t minSiz
   };
 }
 
+namespace
+{
+std::vector<std::vector<char>> generatePayloadPool(size_t poolSize, size_t minSize, size_t maxSize)
+{
+  std::mt19937_64 generator(time(nullptr));
+  std::vector<std::vector<char>> pool(std::max<size_t>(poolSize, 1));
+  for (auto& payload : pool) {
+    payload.resize((minSize == maxSize) ? minSize : (minSize + (generator() % (maxSize - minSize))));
+    // 8 bytes at a time, it is done only once anyway
+    size_t i = 0;
+    for (; i + sizeof(uint64_t) <= payload.size(); i += sizeof(uint64_t)) {
+      uint64_t word = generator();
+      std::memcpy(payload.data() + i, &word, sizeof(uint64_t));
+    }
+    for (; i < payload.size(); i++) {
+      payload[i] = static_cast<char>(generator());
+    }
+  }
+  return pool;
+}
+
+/// Cuts the file in messages of maxSize bytes. It should be a multiple of the page size to keep pages unbroken.
+std::vector<std::vector<char>> readPayloadPool(const std::string& replayFile, size_t maxSize)
+{
+  std::ifstream file(replayFile, std::ios::binary);
+  if (!file.good() || maxSize == 0) {
+    BOOST_THROW_EXCEPTION(AliceO2::Common::FatalException() << AliceO2::Common::errinfo_details("Could not read the replay file '" + replayFile + "'"));
+  }
+  std::vector<std::vector<char>> pool;
+  while (file.good()) {
+    std::vector<char> payload(maxSize);
+    file.read(payload.data(), maxSize);
+    payload.resize(file.gcount());
+    if (!payload.empty()) {
+      pool.push_back(std::move(payload));
+    }
+  }
+  if (pool.empty()) {
+    BOOST_THROW_EXCEPTION(AliceO2::Common::FatalException() << AliceO2::Common::errinfo_details("The replay file '" + replayFile + "' is empty"));
+  }
+  return pool;
+}
+} // namespace
+
+DataProcessorSpec getPooledDataProducerSpec(const PooledDataProducerConfig& config, size_t index, size_t timepipeline)
+{
+  std::vector<ConcreteDataMatcher> matchers;
+  Outputs outputs;
+  for (size_t i = 0; i < std::max<size_t>(config.fanOut, 1); i++) {
+    auto subSpec = static_cast<SubSpec>(index * std::max<size_t>(config.fanOut, 1) + i);
+    matchers.push_back({ "TST", "RAWDATA", subSpec });
+    outputs.push_back({ { "out" + std::to_string(i) }, "TST", "RAWDATA", subSpec });
+  }
+
+  DataProcessorSpec spec{
+    "producer-" + std::to_string(index),
+    Inputs{},
+    outputs,
+    getPooledDataProducerAlgorithm(matchers, config)
+  };
+  spec.maxInputTimeslices = timepipeline;
+
+  return spec;
+}
+
+AlgorithmSpec getPooledDataProducerAlgorithm(std::vector<ConcreteDataMatcher> outputs, const PooledDataProducerConfig& config)
+{
+  return AlgorithmSpec{
+    [=](InitContext&) {
+      // this is the initialization code, we prepare all the payloads here so the processing only copies them
+      auto pool = std::make_shared<std::vector<std::vector<char>>>(
+        config.replayFile.empty() ? generatePayloadPool(config.poolSize, config.minSize, config.maxSize)
+                                  : readPayloadPool(config.replayFile, config.maxSize));
+      ILOG(Info, Devel) << "Prepared a pool of " << pool->size() << " payloads" << ENDM;
+
+      std::default_random_engine generator(time(nullptr));
+      std::exponential_distribution<double> poissonIntervals(config.rate > 0 ? config.rate : 1.0);
+      std::chrono::steady_clock::time_point nextTime{};
+      size_t poolIndex = 0;
+      uint64_t messageCounter = 0;
+      uint64_t bytesCounter = 0;
+      std::shared_ptr<monitoring::Monitoring> collector;
+      if (!config.monitoringUrl.empty()) {
+        collector = MonitoringFactory::Get(config.monitoringUrl);
+        collector->enableProcessMonitoring();
+      }
+
+      // after the initialization, we return the processing callback
+      return [=](ProcessingContext& processingContext) mutable {
+        // everything inside this lambda function is invoked in a loop, because it this Data Processor has no inputs
+
+        // checking if we have reached the maximum amount of messages
+        if (config.amount != 0 && messageCounter >= config.amount) {
+          ILOG(Info, Ops) << "Reached the maximum number of messages, requesting to quit the producer and sending an EndOfStream" << ENDM;
+          processingContext.services().get<ControlService>().endOfStream();
+          processingContext.services().get<ControlService>().readyToQuit(QuitRequest::Me);
+          return;
+        }
+
+        // keeping the message rate, the deadlines are absolute so that the sleep accuracy does not accumulate
+        if (config.rate > 0) {
+          auto now = std::chrono::steady_clock::now();
+          if (nextTime == std::chrono::steady_clock::time_point{}) {
+            nextTime = now;
+          }
+          if (nextTime > now) {
+            std::this_thread::sleep_until(nextTime);
+          }
+          double interval = 0;
+          switch (config.rateProfile) {
+            case RateProfile::Constant:
+              interval = 1.0 / config.rate;
+              break;
+            case RateProfile::Poisson:
+              interval = poissonIntervals(generator);
+              break;
+            case RateProfile::Bursty:
+              interval = (messageCounter + 1) % std::max<size_t>(config.burstSize, 1) == 0 ? config.burstSize / config.rate : 0;
+              break;
+          }
+          nextTime += std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(interval));
+        }
+
+        // sending pooled data
+        for (const auto& output : outputs) {
+          const auto& payload = (*pool)[poolIndex];
+          poolIndex = (poolIndex + 1) % pool->size();
+          auto data = processingContext.outputs().make<char>({ output.origin, output.description, output.subSpec },
+                                                             payload.size());
+          std::memcpy(data.data(), payload.data(), payload.size());
+          bytesCounter += payload.size();
+        }
+        ++messageCounter;
+
+        // send metrics
+        if (collector) {
+          collector->send({ messageCounter, "Data_producer_" + std::to_string(outputs[0].subSpec) + "_message_" },
+                          DerivedMetricMode::RATE);
+          collector->send({ bytesCounter, "Data_producer_" + std::to_string(outputs[0].subSpec) + "_bytes_" },
+                          DerivedMetricMode::RATE);
+        }
+      };
+    }
+  };
+}
+
 } // namespace o2::quality_control::core
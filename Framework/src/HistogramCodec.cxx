@@ -0,0 +1,515 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   HistogramCodec.cxx
+///
+
+#include "QualityControl/HistogramCodec.h"
+
+#include <TDirectory.h>
+#include <TH1F.h>
+#include <TH1D.h>
+#include <TH1I.h>
+#include <TH2F.h>
+#include <TH2D.h>
+#include <TH2I.h>
+#include <TList.h>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+namespace o2::quality_control::core
+{
+
+namespace
+{
+
+constexpr char Magic[3] = { 'Q', 'H', 'C' };
+constexpr uint32_t HistogramBits = 0x00fffe00; // the bits of TH1, e.g. kNoStats
+constexpr uint32_t AxisBits = 0x00ffff80;      // the bits of TAxis, e.g. kCenterTitle
+constexpr size_t NumberOfStats = 7;            // enough for TH2
+
+enum class Type : uint8_t {
+  TH1F = 1,
+  TH1D,
+  TH1I,
+  TH2F,
+  TH2D,
+  TH2I
+};
+
+enum class ArrayEncoding : uint8_t {
+  Raw = 0,
+  ZeroRuns
+};
+
+Type getType(const TObject* object)
+{
+  const TClass* type = object->IsA();
+  if (type == TH1F::Class()) {
+    return Type::TH1F;
+  } else if (type == TH1D::Class()) {
+    return Type::TH1D;
+  } else if (type == TH1I::Class()) {
+    return Type::TH1I;
+  } else if (type == TH2F::Class()) {
+    return Type::TH2F;
+  } else if (type == TH2D::Class()) {
+    return Type::TH2D;
+  } else if (type == TH2I::Class()) {
+    return Type::TH2I;
+  }
+  return Type{ 0 };
+}
+
+bool isTwoDimensional(Type type)
+{
+  return type == Type::TH2F || type == Type::TH2D || type == Type::TH2I;
+}
+
+class Writer
+{
+ public:
+  explicit Writer(std::vector<char>& output) : mOutput(output) {}
+
+  template <typename T>
+  void value(T value)
+  {
+    bytes(&value, sizeof(T));
+  }
+
+  void varint(uint64_t value)
+  {
+    while (value >= 0x80) {
+      mOutput.push_back(static_cast<char>(value | 0x80));
+      value >>= 7;
+    }
+    mOutput.push_back(static_cast<char>(value));
+  }
+
+  void string(const char* text)
+  {
+    size_t length = std::strlen(text);
+    varint(length);
+    bytes(text, length);
+  }
+
+  void bytes(const void* data, size_t size)
+  {
+    const char* begin = static_cast<const char*>(data);
+    mOutput.insert(mOutput.end(), begin, begin + size);
+  }
+
+  /// Writes the array raw, or as runs of zeros and literals if it is smaller.
+  void array(const char* data, size_t count, size_t elementSize)
+  {
+    varint(count);
+    size_t start = mOutput.size();
+    value(ArrayEncoding::ZeroRuns);
+    size_t rawSize = count * elementSize;
+    size_t index = 0;
+    while (index < count && mOutput.size() - start <= rawSize) {
+      size_t zeros = 0;
+      while (index + zeros < count && isZero(data + (index + zeros) * elementSize, elementSize)) {
+        zeros++;
+      }
+      size_t literals = 0;
+      while (index + zeros + literals < count && !isZero(data + (index + zeros + literals) * elementSize, elementSize)) {
+        literals++;
+      }
+      varint(zeros);
+      varint(literals);
+      bytes(data + (index + zeros) * elementSize, literals * elementSize);
+      index += zeros + literals;
+    }
+    if (mOutput.size() - start > rawSize) {
+      mOutput.resize(start);
+      value(ArrayEncoding::Raw);
+      bytes(data, rawSize);
+    }
+  }
+
+ private:
+  static bool isZero(const char* element, size_t elementSize)
+  {
+    if (elementSize == sizeof(uint64_t)) {
+      uint64_t bits;
+      std::memcpy(&bits, element, sizeof(bits));
+      return bits == 0;
+    }
+    uint32_t bits;
+    std::memcpy(&bits, element, sizeof(bits));
+    return bits == 0;
+  }
+
+  std::vector<char>& mOutput;
+};
+
+class Reader
+{
+ public:
+  Reader(const char* data, size_t size) : mData(data), mSize(size) {}
+
+  template <typename T>
+  T value()
+  {
+    T result;
+    std::memcpy(&result, bytes(sizeof(T)), sizeof(T));
+    return result;
+  }
+
+  uint64_t varint()
+  {
+    uint64_t result = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+      auto byte = value<uint8_t>();
+      result |= static_cast<uint64_t>(byte & 0x7f) << shift;
+      if ((byte & 0x80) == 0) {
+        return result;
+      }
+    }
+    throw std::runtime_error("Invalid varint in an encoded histogram");
+  }
+
+  std::string string()
+  {
+    size_t length = varint();
+    return { bytes(length), length };
+  }
+
+  const char* bytes(size_t size)
+  {
+    if (size > mSize - mPosition) {
+      throw std::runtime_error("The encoded histogram is truncated");
+    }
+    const char* result = mData + mPosition;
+    mPosition += size;
+    return result;
+  }
+
+  /// Reads an array written by Writer::array into the destination, which must have the same number of elements.
+  void array(char* destination, size_t count, size_t elementSize)
+  {
+    if (varint() != count) {
+      throw std::runtime_error("The size of an array does not match the bins of the encoded histogram");
+    }
+    auto encoding = value<ArrayEncoding>();
+    if (encoding == ArrayEncoding::Raw) {
+      std::memcpy(destination, bytes(count * elementSize), count * elementSize);
+      return;
+    }
+    size_t index = 0;
+    while (index < count) {
+      size_t zeros = varint();
+      size_t literals = varint();
+      if (zeros > count - index || literals > count - index - zeros) {
+        throw std::runtime_error("Invalid run in an encoded histogram");
+      }
+      std::memset(destination + index * elementSize, 0, zeros * elementSize);
+      index += zeros;
+      std::memcpy(destination + index * elementSize, bytes(literals * elementSize), literals * elementSize);
+      index += literals;
+    }
+  }
+
+ private:
+  const char* mData;
+  size_t mSize;
+  size_t mPosition = 0;
+};
+
+/// The content of an encoded axis, read before the histogram which it is used to create
+struct AxisSpec {
+  std::string title;
+  int bins = 1;
+  double min = 0;
+  double max = 1;
+  std::vector<double> edges; // empty for fixed bins
+  uint32_t bits = 0;
+  int first = 0;
+  int last = 0;
+  int divisions = 510;
+  int16_t axisColor = 1;
+  int16_t labelColor = 1;
+  int16_t labelFont = 42;
+  float labelOffset = 0.005;
+  float labelSize = 0.035;
+  float tickLength = 0.03;
+  float titleOffset = 1;
+  float titleSize = 0.035;
+  int16_t titleColor = 1;
+  int16_t titleFont = 42;
+};
+
+void writeAxis(Writer& writer, const TAxis& axis)
+{
+  writer.string(axis.GetTitle());
+  writer.value<int32_t>(axis.GetNbins());
+  writer.value<double>(axis.GetXmin());
+  writer.value<double>(axis.GetXmax());
+  const TArrayD* edges = axis.GetXbins();
+  writer.value<uint8_t>(edges->GetSize() > 0);
+  if (edges->GetSize() > 0) {
+    writer.bytes(edges->GetArray(), edges->GetSize() * sizeof(double));
+  }
+  writer.value<uint32_t>(axis.TestBits(AxisBits));
+  writer.value<int32_t>(axis.GetFirst());
+  writer.value<int32_t>(axis.GetLast());
+  writer.value<int32_t>(axis.GetNdivisions());
+  writer.value<int16_t>(axis.GetAxisColor());
+  writer.value<int16_t>(axis.GetLabelColor());
+  writer.value<int16_t>(axis.GetLabelFont());
+  writer.value<float>(axis.GetLabelOffset());
+  writer.value<float>(axis.GetLabelSize());
+  writer.value<float>(axis.GetTickLength());
+  writer.value<float>(axis.GetTitleOffset());
+  writer.value<float>(axis.GetTitleSize());
+  writer.value<int16_t>(axis.GetTitleColor());
+  writer.value<int16_t>(axis.GetTitleFont());
+}
+
+AxisSpec readAxis(Reader& reader)
+{
+  AxisSpec axis;
+  axis.title = reader.string();
+  axis.bins = reader.value<int32_t>();
+  axis.min = reader.value<double>();
+  axis.max = reader.value<double>();
+  if (axis.bins <= 0) {
+    throw std::runtime_error("Invalid number of bins in an encoded histogram");
+  }
+  if (reader.value<uint8_t>()) {
+    axis.edges.resize(axis.bins + 1);
+    std::memcpy(axis.edges.data(), reader.bytes(axis.edges.size() * sizeof(double)), axis.edges.size() * sizeof(double));
+  }
+  axis.bits = reader.value<uint32_t>();
+  axis.first = reader.value<int32_t>();
+  axis.last = reader.value<int32_t>();
+  axis.divisions = reader.value<int32_t>();
+  axis.axisColor = reader.value<int16_t>();
+  axis.labelColor = reader.value<int16_t>();
+  axis.labelFont = reader.value<int16_t>();
+  axis.labelOffset = reader.value<float>();
+  axis.labelSize = reader.value<float>();
+  axis.tickLength = reader.value<float>();
+  axis.titleOffset = reader.value<float>();
+  axis.titleSize = reader.value<float>();
+  axis.titleColor = reader.value<int16_t>();
+  axis.titleFont = reader.value<int16_t>();
+  return axis;
+}
+
+void applyAxisAttributes(const AxisSpec& spec, TAxis& axis)
+{
+  axis.SetTitle(spec.title.c_str());
+  if (spec.bits & TAxis::kAxisRange) {
+    axis.SetRange(spec.first, spec.last);
+  }
+  axis.SetBit(spec.bits, true);
+  axis.SetNdivisions(std::abs(spec.divisions), spec.divisions >= 0);
+  axis.SetAxisColor(spec.axisColor);
+  axis.SetLabelColor(spec.labelColor);
+  axis.SetLabelFont(spec.labelFont);
+  axis.SetLabelOffset(spec.labelOffset);
+  axis.SetLabelSize(spec.labelSize);
+  axis.SetTickLength(spec.tickLength);
+  axis.SetTitleOffset(spec.titleOffset);
+  axis.SetTitleSize(spec.titleSize);
+  axis.SetTitleColor(spec.titleColor);
+  axis.SetTitleFont(spec.titleFont);
+}
+
+template <typename H>
+std::unique_ptr<TH1> create(const std::string& name, const std::string& title, const AxisSpec& x)
+{
+  if (x.edges.empty()) {
+    return std::make_unique<H>(name.c_str(), title.c_str(), x.bins, x.min, x.max);
+  }
+  return std::make_unique<H>(name.c_str(), title.c_str(), x.bins, x.edges.data());
+}
+
+template <typename H>
+std::unique_ptr<TH1> create(const std::string& name, const std::string& title, const AxisSpec& x, const AxisSpec& y)
+{
+  if (x.edges.empty() && y.edges.empty()) {
+    return std::make_unique<H>(name.c_str(), title.c_str(), x.bins, x.min, x.max, y.bins, y.min, y.max);
+  } else if (x.edges.empty()) {
+    return std::make_unique<H>(name.c_str(), title.c_str(), x.bins, x.min, x.max, y.bins, y.edges.data());
+  } else if (y.edges.empty()) {
+    return std::make_unique<H>(name.c_str(), title.c_str(), x.bins, x.edges.data(), y.bins, y.min, y.max);
+  }
+  return std::make_unique<H>(name.c_str(), title.c_str(), x.bins, x.edges.data(), y.bins, y.edges.data());
+}
+
+std::unique_ptr<TH1> create(Type type, const std::string& name, const std::string& title, const AxisSpec& x, const AxisSpec& y)
+{
+  switch (type) {
+    case Type::TH1F:
+      return create<TH1F>(name, title, x);
+    case Type::TH1D:
+      return create<TH1D>(name, title, x);
+    case Type::TH1I:
+      return create<TH1I>(name, title, x);
+    case Type::TH2F:
+      return create<TH2F>(name, title, x, y);
+    case Type::TH2D:
+      return create<TH2D>(name, title, x, y);
+    case Type::TH2I:
+      return create<TH2I>(name, title, x, y);
+  }
+  throw std::runtime_error("Unknown type of encoded histogram");
+}
+
+/// \return the array of bin contents and the size of its elements
+std::pair<char*, size_t> getContents(TH1& histogram, Type type)
+{
+  switch (type) {
+    case Type::TH1F:
+    case Type::TH2F:
+      return { reinterpret_cast<char*>(dynamic_cast<TArrayF&>(histogram).GetArray()), sizeof(Float_t) };
+    case Type::TH1D:
+    case Type::TH2D:
+      return { reinterpret_cast<char*>(dynamic_cast<TArrayD&>(histogram).GetArray()), sizeof(Double_t) };
+    case Type::TH1I:
+    case Type::TH2I:
+      return { reinterpret_cast<char*>(dynamic_cast<TArrayI&>(histogram).GetArray()), sizeof(Int_t) };
+  }
+  throw std::runtime_error("Unknown type of encoded histogram");
+}
+
+} // namespace
+
+bool HistogramCodec::canEncode(const TObject* object)
+{
+  if (object == nullptr || getType(object) == Type{ 0 }) {
+    return false;
+  }
+  auto histogram = static_cast<const TH1*>(object);
+  return histogram->GetBuffer() == nullptr // the buffer would have to be flushed first
+         && (histogram->GetListOfFunctions() == nullptr || histogram->GetListOfFunctions()->GetSize() == 0)
+         && histogram->GetXaxis()->GetLabels() == nullptr && histogram->GetYaxis()->GetLabels() == nullptr;
+}
+
+void HistogramCodec::encode(const TH1& histogram, std::vector<char>& output)
+{
+  Type type = getType(&histogram);
+  Writer writer(output);
+  writer.bytes(Magic, sizeof(Magic));
+  writer.value(Version);
+  writer.value(type);
+
+  writer.string(histogram.GetName());
+  writer.string(histogram.GetTitle());
+  writer.string(histogram.GetOption());
+  writer.value<double>(histogram.GetEntries());
+  double stats[TH1::kNstat] = {};
+  histogram.GetStats(stats);
+  writer.bytes(stats, NumberOfStats * sizeof(double));
+  writer.value<double>(histogram.GetMinimumStored());
+  writer.value<double>(histogram.GetMaximumStored());
+  writer.value<uint32_t>(histogram.TestBits(HistogramBits));
+  writer.value<int16_t>(histogram.GetLineColor());
+  writer.value<int16_t>(histogram.GetLineStyle());
+  writer.value<int16_t>(histogram.GetLineWidth());
+  writer.value<int16_t>(histogram.GetFillColor());
+  writer.value<int16_t>(histogram.GetFillStyle());
+  writer.value<int16_t>(histogram.GetMarkerColor());
+  writer.value<int16_t>(histogram.GetMarkerStyle());
+  writer.value<float>(histogram.GetMarkerSize());
+
+  writeAxis(writer, *histogram.GetXaxis());
+  if (isTwoDimensional(type)) {
+    writeAxis(writer, *histogram.GetYaxis());
+  }
+
+  // the arrays are not modified, the cast only avoids duplicating getContents
+  auto [contents, elementSize] = getContents(const_cast<TH1&>(histogram), type);
+  writer.array(contents, histogram.GetNcells(), elementSize);
+  writer.value<uint8_t>(histogram.GetSumw2N() > 0);
+  if (histogram.GetSumw2N() > 0) {
+    writer.array(reinterpret_cast<const char*>(histogram.GetSumw2()->GetArray()), histogram.GetSumw2N(), sizeof(double));
+  }
+}
+
+std::unique_ptr<TH1> HistogramCodec::decode(const char* data, size_t size)
+{
+  Reader reader(data, size);
+  if (std::memcmp(reader.bytes(sizeof(Magic)), Magic, sizeof(Magic)) != 0) {
+    throw std::runtime_error("The data is not an encoded histogram");
+  }
+  if (auto version = reader.value<unsigned char>(); version != Version) {
+    throw std::runtime_error("Unsupported version of encoded histogram: " + std::to_string(version));
+  }
+  auto type = reader.value<Type>();
+
+  auto name = reader.string();
+  auto title = reader.string();
+  auto option = reader.string();
+  auto entries = reader.value<double>();
+  double stats[TH1::kNstat] = {};
+  std::memcpy(stats, reader.bytes(NumberOfStats * sizeof(double)), NumberOfStats * sizeof(double));
+  auto minimum = reader.value<double>();
+  auto maximum = reader.value<double>();
+  auto bits = reader.value<uint32_t>();
+  auto lineColor = reader.value<int16_t>();
+  auto lineStyle = reader.value<int16_t>();
+  auto lineWidth = reader.value<int16_t>();
+  auto fillColor = reader.value<int16_t>();
+  auto fillStyle = reader.value<int16_t>();
+  auto markerColor = reader.value<int16_t>();
+  auto markerStyle = reader.value<int16_t>();
+  auto markerSize = reader.value<float>();
+
+  auto xAxis = readAxis(reader);
+  AxisSpec yAxis;
+  if (isTwoDimensional(type)) {
+    yAxis = readAxis(reader);
+  }
+
+  std::unique_ptr<TH1> histogram;
+  {
+    TDirectory::TContext context(nullptr); // so that the histogram is not attached to the current directory
+    histogram = create(type, name, title, xAxis, yAxis);
+  }
+  applyAxisAttributes(xAxis, *histogram->GetXaxis());
+  if (isTwoDimensional(type)) {
+    applyAxisAttributes(yAxis, *histogram->GetYaxis());
+  }
+
+  auto [contents, elementSize] = getContents(*histogram, type);
+  reader.array(contents, histogram->GetNcells(), elementSize);
+  if (reader.value<uint8_t>()) {
+    if (histogram->GetSumw2N() == 0) {
+      histogram->Sumw2();
+    }
+    reader.array(reinterpret_cast<char*>(histogram->GetSumw2()->GetArray()), histogram->GetSumw2N(), sizeof(double));
+  }
+
+  histogram->SetOption(option.c_str());
+  histogram->PutStats(stats);
+  histogram->SetEntries(entries);
+  histogram->SetMinimum(minimum);
+  histogram->SetMaximum(maximum);
+  histogram->SetBit(bits, true);
+  histogram->SetLineColor(lineColor);
+  histogram->SetLineStyle(lineStyle);
+  histogram->SetLineWidth(lineWidth);
+  histogram->SetFillColor(fillColor);
+  histogram->SetFillStyle(fillStyle);
+  histogram->SetMarkerColor(markerColor);
+  histogram->SetMarkerStyle(markerStyle);
+  histogram->SetMarkerSize(markerSize);
+  return histogram;
+}
+
+} // namespace o2::quality_control::core
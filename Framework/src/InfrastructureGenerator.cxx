@@ -54,11 +54,10 @@ framework::WorkflowSpec InfrastructureGenerator::generateStandaloneInfrastructur
   auto config = ConfigurationFactory::getConfiguration(configurationSource);
   printVersion();
 
-  TaskRunnerFactory taskRunnerFactory;
   if (config->getRecursive("qc").count("tasks")) {
     for (const auto& [taskName, taskConfig] : config->getRecursive("qc.tasks")) {
       if (taskConfig.get<bool>("active", true)) {
-        workflow.emplace_back(taskRunnerFactory.create(taskName, configurationSource, 0));
+        workflow.emplace_back(generateTaskRunner(taskName, configurationSource, taskConfig));
       }
     }
   }
@@ -155,7 +154,6 @@ o2::framework::WorkflowSpec InfrastructureGenerator::generateRemoteInfrastructur
   printVersion();
 
   if (config->getRecursive("qc").count("tasks")) {
-    TaskRunnerFactory taskRunnerFactory;
     for (const auto& [taskName, taskConfig] : config->getRecursive("qc.tasks")) {
       if (taskConfig.get<bool>("active", true)) {
 
@@ -191,8 +189,8 @@ o2::framework::WorkflowSpec InfrastructureGenerator::generateRemoteInfrastructur
             throw std::runtime_error("Configuration error: dataSource type unknown : " + type);
           }
 
-          // Creating the remote task
-          workflow.emplace_back(taskRunnerFactory.create(taskName, configurationSource, 0));
+          // Creating the remote task, its CheckRunners run on the same node
+          workflow.emplace_back(generateTaskRunner(taskName, configurationSource, taskConfig));
         }
       }
     }
@@ -511,4 +509,19 @@ void InfrastructureGenerator::generatePostProcessing(WorkflowSpec& workflow, std
   }
 }
 
+framework::DataProcessorSpec InfrastructureGenerator::generateTaskRunner(std::string taskName, std::string configurationSource, const ptree& taskConfig)
+{
+  // the CheckRunners run on the same node, they can read a MonitorObjectTable
+  auto publicationFormat = taskConfig.get<std::string>("publicationFormat", "collection");
+  if (publicationFormat != "collection" && publicationFormat != "objectTable" && publicationFormat != "compactObjectTable") {
+    throw std::runtime_error("Configuration error: publicationFormat of the task " + taskName + " unknown : " + publicationFormat +
+                             ", it should be collection, objectTable or compactObjectTable");
+  }
+  bool compactHistograms = publicationFormat == "compactObjectTable";
+  bool publishObjectTable = publicationFormat == "objectTable" || compactHistograms;
+
+  TaskRunnerFactory taskRunnerFactory;
+  return taskRunnerFactory.create(taskName, configurationSource, 0, false, publishObjectTable, compactHistograms);
+}
+
 } // namespace o2::quality_control::core
@@ -48,6 +48,14 @@ void MonitorObjectCollection::merge(mergers::MergeInterface* const other)
     }
   }
   delete otherIterator;
+
+  // The merged collection is traced as its latest published input, the others were ready before it.
+  if (!otherCollection->mTrace.empty()) {
+    if (Tracer::getStamp(otherCollection->mTrace, Tracer::Stage::Publish) > Tracer::getStamp(mTrace, Tracer::Stage::Publish)) {
+      mTrace = otherCollection->mTrace;
+    }
+    Tracer::stamp(mTrace, Tracer::Stage::Merge);
+  }
 }
 
 } // namespace o2::quality_control::core
@@ -0,0 +1,161 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   MonitorObjectTable.cxx
+///
+
+#include "QualityControl/MonitorObjectTable.h"
+#include "QualityControl/MonitorObject.h"
+#include "QualityControl/HistogramCodec.h"
+
+#include <TH1.h>
+#include <TObjArray.h>
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+
+namespace o2::quality_control::core
+{
+
+void MonitorObjectTable::write(const TObjArray& objects, const TraceStamps& trace)
+{
+  uint32_t numberOfObjects = 0;
+  for (const auto* object : objects) {
+    numberOfObjects += dynamic_cast<const MonitorObject*>(object) != nullptr;
+  }
+  Header header{ Magic, numberOfObjects, 0, 0 };
+  mBuffer.resize(sizeof(Header) + numberOfObjects * sizeof(Entry));
+
+  size_t index = 0;
+  for (const auto* object : objects) {
+    const auto* mo = dynamic_cast<const MonitorObject*>(object);
+    if (mo == nullptr) {
+      continue;
+    }
+    Entry entry{};
+    auto name = mo->getFullName();
+    entry.nameOffset = mBuffer.size();
+    entry.nameSize = name.size();
+    mBuffer.insert(mBuffer.end(), name.begin(), name.end());
+
+    bool compact = mCompactHistograms && HistogramCodec::canEncode(mo->getObject());
+    mObjectBuffer.Reset();
+    if (compact) {
+      // only the metadata of the MonitorObject is streamed, the histogram follows
+      MonitorObject shell(*mo);
+      shell.setObject(nullptr);
+      mObjectBuffer.WriteObjectAny(&shell, MonitorObject::Class());
+    } else {
+      mObjectBuffer.WriteObjectAny(mo, MonitorObject::Class());
+    }
+    mBuffer.resize((mBuffer.size() + 7) & ~size_t(7)); // ROOT reads the objects faster when they are aligned
+    entry.objectOffset = mBuffer.size();
+    entry.objectSize = mObjectBuffer.Length();
+    mBuffer.insert(mBuffer.end(), mObjectBuffer.Buffer(), mObjectBuffer.Buffer() + mObjectBuffer.Length());
+
+    if (compact) {
+      mBuffer.resize((mBuffer.size() + 7) & ~size_t(7));
+      entry.histogramOffset = mBuffer.size();
+      HistogramCodec::encode(*static_cast<const TH1*>(mo->getObject()), mBuffer);
+      entry.histogramSize = mBuffer.size() - entry.histogramOffset;
+    }
+
+    std::memcpy(mBuffer.data() + sizeof(Header) + index * sizeof(Entry), &entry, sizeof(Entry));
+    index++;
+  }
+
+  header.traceOffset = mBuffer.size();
+  for (const auto& [key, value] : trace) {
+    const uint32_t keySize = key.size();
+    const size_t offset = mBuffer.size();
+    mBuffer.resize(offset + sizeof(keySize) + keySize + sizeof(value));
+    std::memcpy(mBuffer.data() + offset, &keySize, sizeof(keySize));
+    std::memcpy(mBuffer.data() + offset + sizeof(keySize), key.data(), keySize);
+    std::memcpy(mBuffer.data() + offset + sizeof(keySize) + keySize, &value, sizeof(value));
+  }
+  header.traceSize = mBuffer.size() - header.traceOffset;
+  std::memcpy(mBuffer.data(), &header, sizeof(Header));
+}
+
+MonitorObjectTable::View::View(const char* data, size_t size) : mData(data), mSize(size)
+{
+  if (data == nullptr || size < sizeof(Header)) {
+    throw std::runtime_error("The data is not a MonitorObjectTable");
+  }
+  Header header{};
+  std::memcpy(&header, data, sizeof(Header));
+  if (header.magic != Magic) {
+    throw std::runtime_error("The data is not a MonitorObjectTable");
+  }
+  if ((size - sizeof(Header)) / sizeof(Entry) < header.numberOfObjects || header.traceOffset > size || header.traceSize > size - header.traceOffset) {
+    throw std::runtime_error("The MonitorObjectTable is truncated");
+  }
+  for (size_t index = 0; index < header.numberOfObjects; index++) {
+    Entry entry{};
+    std::memcpy(&entry, data + sizeof(Header) + index * sizeof(Entry), sizeof(Entry));
+    if (entry.nameOffset > size || entry.nameSize > size - entry.nameOffset || entry.objectOffset > size || entry.objectSize > size - entry.objectOffset
+        || entry.histogramOffset > size || entry.histogramSize > size - entry.histogramOffset) {
+      throw std::runtime_error("The MonitorObjectTable is truncated");
+    }
+  }
+}
+
+size_t MonitorObjectTable::View::size() const
+{
+  Header header{};
+  std::memcpy(&header, mData, sizeof(Header));
+  return header.numberOfObjects;
+}
+
+std::string_view MonitorObjectTable::View::getName(size_t index) const
+{
+  Entry entry{};
+  std::memcpy(&entry, mData + sizeof(Header) + index * sizeof(Entry), sizeof(Entry));
+  return { mData + entry.nameOffset, entry.nameSize };
+}
+
+std::unique_ptr<MonitorObject> MonitorObjectTable::View::materialize(size_t index) const
+{
+  Entry entry{};
+  std::memcpy(&entry, mData + sizeof(Header) + index * sizeof(Entry), sizeof(Entry));
+  // the buffer does not own the data, it reads the message in place
+  TBufferFile buffer(TBuffer::kRead, entry.objectSize, const_cast<char*>(mData + entry.objectOffset), kFALSE);
+  std::unique_ptr<MonitorObject> mo(static_cast<MonitorObject*>(buffer.ReadObjectAny(MonitorObject::Class())));
+  if (mo && entry.histogramSize > 0) {
+    mo->setObject(HistogramCodec::decode(mData + entry.histogramOffset, entry.histogramSize).release());
+    mo->setIsOwner(true);
+  }
+  return mo;
+}
+
+TraceStamps MonitorObjectTable::View::getTrace() const
+{
+  Header header{};
+  std::memcpy(&header, mData, sizeof(Header));
+  TraceStamps trace;
+  const char* data = mData + header.traceOffset;
+  const char* end = data + header.traceSize;
+  while (end - data >= static_cast<ptrdiff_t>(sizeof(uint32_t))) {
+    uint32_t keySize = 0;
+    std::memcpy(&keySize, data, sizeof(keySize));
+    data += sizeof(keySize);
+    if (static_cast<size_t>(end - data) < keySize + sizeof(uint64_t)) {
+      throw std::runtime_error("The trace of the MonitorObjectTable is truncated");
+    }
+    std::string key(data, keySize);
+    data += keySize;
+    std::memcpy(&trace[key], data, sizeof(uint64_t));
+    data += sizeof(uint64_t);
+  }
+  return trace;
+}
+
+} // namespace o2::quality_control::core
@@ -30,6 +30,7 @@ namespace o2::quality_control::core
 
 const std::string ObjectsManager::gDrawOptionsKey = "drawOptions";
 const std::string ObjectsManager::gDisplayHintsKey = "displayHints";
+const std::string ObjectsManager::gCycleDurationKey = "cycleDurationSeconds";
 
 ObjectsManager::ObjectsManager(std::string taskName, std::string detectorName, std::string consulUrl, int parallelTaskID, bool noDiscovery)
   : mTaskName(taskName), mDetectorName(detectorName), mUpdateServiceDiscovery(false), mCurrentRunNumber(0)
@@ -66,18 +67,18 @@ void ObjectsManager::updateServiceDiscovery()
   if (!mUpdateServiceDiscovery || mServiceDiscovery == nullptr) {
     return;
   }
-  // prepare the string of comma separated objects and publish it
-  string objects;
+  // prepare the list of objects and publish it, the registration itself is done in the background
+  std::vector<std::string> objects;
+  objects.reserve(mMonitorObjects->GetEntries());
   for (auto tobj : *mMonitorObjects) {
     MonitorObject* mo = dynamic_cast<MonitorObject*>(tobj);
     if (mo) {
-      objects += mo->getPath() + ",";
+      objects.push_back(mo->getPath());
     } else {
       ILOG(Error, Devel) << "ObjectsManager::updateServiceDiscovery : dynamic_cast returned nullptr." << ENDM;
     }
   }
-  objects.pop_back();
-  mServiceDiscovery->_register(objects);
+  mServiceDiscovery->_register(std::move(objects));
   mUpdateServiceDiscovery = false;
 }
 
@@ -86,7 +87,7 @@ void ObjectsManager::removeAllFromServiceDiscovery()
   if (mServiceDiscovery == nullptr) {
     return;
   }
-  mServiceDiscovery->_register("");
+  mServiceDiscovery->_register(std::vector<std::string>{});
   mUpdateServiceDiscovery = true;
 }
 
@@ -181,4 +182,29 @@ void ObjectsManager::updateRunNumber(int runNumber)
   }
 }
 
+void ObjectsManager::updateCycleDuration(double seconds)
+{
+  auto value = std::to_string(static_cast<int>(seconds + 0.5));
+  for (auto tobj : *mMonitorObjects) {
+    auto* mo = dynamic_cast<MonitorObject*>(tobj);
+    if (mo) {
+      mo->addOrUpdateMetadata(gCycleDurationKey, value);
+    } else {
+      ILOG(Error, Devel) << "ObjectsManager::updateCycleDuration : dynamic_cast returned nullptr." << ENDM;
+    }
+  }
+}
+
+void ObjectsManager::registerRenderer(std::function<void()> renderer)
+{
+  mRenderers.push_back(std::move(renderer));
+}
+
+void ObjectsManager::render()
+{
+  for (const auto& renderer : mRenderers) {
+    renderer();
+  }
+}
+
 } // namespace o2::quality_control::core
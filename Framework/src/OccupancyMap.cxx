@@ -0,0 +1,229 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   OccupancyMap.cxx
+///
+
+#include "QualityControl/OccupancyMap.h"
+
+#include <TDirectory.h>
+#include <TH2I.h>
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+ClassImp(o2::quality_control::core::OccupancyMap)
+
+namespace o2::quality_control::core
+{
+
+OccupancyMap::OccupancyMap(const char* name, const char* title, unsigned int columns, unsigned int rows)
+  : TNamed(name, title), mColumns(columns), mRows(rows)
+{
+  if (uint64_t(columns) * rows > uint64_t(UINT32_MAX)) {
+    throw std::invalid_argument("An OccupancyMap cannot have more than 2^32 pixels");
+  }
+}
+
+OccupancyMap::~OccupancyMap() = default;
+
+void OccupancyMap::fill(unsigned int column, unsigned int row, uint32_t hits)
+{
+  if (column >= mColumns || row >= mRows || hits == 0) {
+    return;
+  }
+  const uint32_t pixel = row * mColumns + column;
+  add(findOrAddContainer(pixel >> ContainerBits), pixel & (ContainerSize - 1), hits);
+
+  mEntries += hits;
+  mSumColumns += double(hits) * column;
+  mSumColumns2 += double(hits) * column * column;
+  mSumRows += double(hits) * row;
+  mSumRows2 += double(hits) * row * row;
+  mSumColumnsRows += double(hits) * column * row;
+}
+
+uint32_t OccupancyMap::getHits(unsigned int column, unsigned int row) const
+{
+  if (column >= mColumns || row >= mRows) {
+    return 0;
+  }
+  const uint32_t pixel = row * mColumns + column;
+  long container = findContainer(pixel >> ContainerBits);
+  if (container < 0) {
+    return 0;
+  }
+  const uint16_t low = pixel & (ContainerSize - 1);
+  if (isDense(container)) {
+    return mHits[container][low];
+  }
+  const auto& lows = mLows[container];
+  auto it = std::lower_bound(lows.begin(), lows.end(), low);
+  return it != lows.end() && *it == low ? mHits[container][it - lows.begin()] : 0;
+}
+
+void OccupancyMap::reset()
+{
+  mKeys.clear();
+  mLows.clear();
+  mHits.clear();
+  mEntries = 0;
+  mSumColumns = mSumColumns2 = mSumRows = mSumRows2 = mSumColumnsRows = 0;
+  mLastContainer = 0;
+}
+
+size_t OccupancyMap::getNumberOfFiredPixels() const
+{
+  size_t fired = 0;
+  for (size_t container = 0; container < mKeys.size(); container++) {
+    if (isDense(container)) {
+      fired += std::count_if(mHits[container].begin(), mHits[container].end(), [](uint32_t hits) { return hits > 0; });
+    } else {
+      fired += mLows[container].size();
+    }
+  }
+  return fired;
+}
+
+double OccupancyMap::getMean(int axis) const
+{
+  if (mEntries == 0) {
+    return 0;
+  }
+  return (axis == 1 ? mSumColumns : mSumRows) / mEntries;
+}
+
+double OccupancyMap::getStdDev(int axis) const
+{
+  if (mEntries == 0) {
+    return 0;
+  }
+  double mean = getMean(axis);
+  double variance = (axis == 1 ? mSumColumns2 : mSumRows2) / mEntries - mean * mean;
+  return variance > 0 ? std::sqrt(variance) : 0;
+}
+
+void OccupancyMap::merge(mergers::MergeInterface* const other)
+{
+  auto otherMap = dynamic_cast<const OccupancyMap*>(other);
+  if (otherMap == nullptr) {
+    throw std::runtime_error("The other object is not an OccupancyMap");
+  }
+  if (otherMap->mColumns != mColumns || otherMap->mRows != mRows) {
+    throw std::runtime_error("Cannot merge the OccupancyMap '" + std::string(otherMap->GetName()) + "' into '" +
+                             GetName() + "', their dimensions differ");
+  }
+
+  for (size_t otherContainer = 0; otherContainer < otherMap->mKeys.size(); otherContainer++) {
+    size_t container = findOrAddContainer(otherMap->mKeys[otherContainer]);
+    const auto& otherHits = otherMap->mHits[otherContainer];
+    if (otherMap->isDense(otherContainer)) {
+      toDense(container);
+      auto& hits = mHits[container];
+      for (size_t low = 0; low < ContainerSize; low++) {
+        hits[low] += otherHits[low];
+      }
+    } else {
+      const auto& otherLows = otherMap->mLows[otherContainer];
+      for (size_t index = 0; index < otherLows.size(); index++) {
+        add(container, otherLows[index], otherHits[index]);
+      }
+    }
+  }
+
+  mEntries += otherMap->mEntries;
+  mSumColumns += otherMap->mSumColumns;
+  mSumColumns2 += otherMap->mSumColumns2;
+  mSumRows += otherMap->mSumRows;
+  mSumRows2 += otherMap->mSumRows2;
+  mSumColumnsRows += otherMap->mSumColumnsRows;
+}
+
+std::unique_ptr<TH2I> OccupancyMap::toHistogram() const
+{
+  std::unique_ptr<TH2I> histogram;
+  {
+    TDirectory::TContext context(nullptr); // so that the histogram is not attached to the current directory
+    histogram = std::make_unique<TH2I>(GetName(), GetTitle(), mColumns, -0.5, mColumns - 0.5, mRows, -0.5, mRows - 0.5);
+  }
+  forEachFiredPixel([&](unsigned int column, unsigned int row, uint32_t hits) {
+    histogram->SetBinContent(column + 1, row + 1, hits);
+  });
+  double stats[TH1::kNstat] = { double(mEntries), double(mEntries), mSumColumns, mSumColumns2, mSumRows, mSumRows2, mSumColumnsRows };
+  histogram->PutStats(stats);
+  histogram->SetEntries(mEntries);
+  histogram->SetStats(mStats);
+  return histogram;
+}
+
+void OccupancyMap::Draw(Option_t* option)
+{
+  mHistogram = toHistogram();
+  mHistogram->Draw(option);
+}
+
+long OccupancyMap::findContainer(uint16_t key) const
+{
+  auto it = std::lower_bound(mKeys.begin(), mKeys.end(), key);
+  return it != mKeys.end() && *it == key ? it - mKeys.begin() : -1;
+}
+
+size_t OccupancyMap::findOrAddContainer(uint16_t key)
+{
+  if (mLastContainer < mKeys.size() && mKeys[mLastContainer] == key) {
+    return mLastContainer;
+  }
+  auto it = std::lower_bound(mKeys.begin(), mKeys.end(), key);
+  size_t container = it - mKeys.begin();
+  if (it == mKeys.end() || *it != key) {
+    mKeys.insert(it, key);
+    mLows.emplace(mLows.begin() + container);
+    mHits.emplace(mHits.begin() + container);
+  }
+  mLastContainer = container;
+  return container;
+}
+
+void OccupancyMap::add(size_t container, uint16_t low, uint32_t hits)
+{
+  if (isDense(container)) {
+    mHits[container][low] += hits;
+    return;
+  }
+  auto& lows = mLows[container];
+  auto it = std::lower_bound(lows.begin(), lows.end(), low);
+  size_t index = it - lows.begin();
+  if (it != lows.end() && *it == low) {
+    mHits[container][index] += hits;
+  } else if (lows.size() < MaxSparseSize) {
+    lows.insert(it, low);
+    mHits[container].insert(mHits[container].begin() + index, hits);
+  } else {
+    toDense(container);
+    mHits[container][low] += hits;
+  }
+}
+
+void OccupancyMap::toDense(size_t container)
+{
+  if (isDense(container)) {
+    return;
+  }
+  std::vector<uint32_t> dense(ContainerSize, 0);
+  const auto& lows = mLows[container];
+  for (size_t index = 0; index < lows.size(); index++) {
+    dense[lows[index]] = mHits[container][index];
+  }
+  mHits[container].swap(dense);
+  mLows[container] = std::vector<uint16_t>();
+}
+
+} // namespace o2::quality_control::core
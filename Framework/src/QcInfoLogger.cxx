@@ -59,6 +59,8 @@ void QcInfoLogger::init(const std::string& facility, bool discardDebug, int disc
   // Set the proper discard filters
   ILOG_INST.filterDiscardDebug(discardDebug);
   ILOG_INST.filterDiscardLevel(discardFromLevel);
+  mDiscardDebug = discardDebug;
+  mDiscardFromLevel = discardFromLevel;
   // we use cout because we might have just muted ourselves
   std::cout << "Discard debug ? " << discardDebug << std::endl;
   std::cout << "Discard from level " << discardFromLevel << std::endl;
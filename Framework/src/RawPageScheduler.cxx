@@ -0,0 +1,184 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   RawPageScheduler.cxx
+///
+
+#include "QualityControl/RawPageScheduler.h"
+
+#include <DetectorsRaw/RDHUtils.h>
+#include <DPLUtils/DPLRawParser.h>
+#include <Framework/InputRecord.h>
+#include <algorithm>
+#include <limits>
+
+using namespace o2::raw;
+
+namespace o2::quality_control::core
+{
+
+RawPageScheduler::RawPageScheduler(size_t nWorkers)
+{
+  for (size_t worker = 1; worker < nWorkers; worker++) {
+    mThreads.emplace_back([this, worker] { work(worker); });
+  }
+}
+
+RawPageScheduler::~RawPageScheduler()
+{
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mStop = true;
+  }
+  mStartCondition.notify_all();
+  for (auto& thread : mThreads) {
+    thread.join();
+  }
+}
+
+void RawPageScheduler::clear()
+{
+  for (auto index : mActiveUnits) {
+    mWorkUnits[index].pages.clear();
+    mWorkUnits[index].size = 0;
+  }
+  mActiveUnits.clear();
+  mSorted = true;
+  mNumberOfPages = 0;
+}
+
+void RawPageScheduler::addPage(const RawPage& page)
+{
+  const uint16_t feeId = RDHUtils::getFEEID(page.rdh);
+  const uint8_t linkId = RDHUtils::getLinkID(page.rdh);
+  const uint64_t subSpecification = page.dataHeader ? page.dataHeader->subSpecification : 0;
+  const uint64_t key = (subSpecification << 32) | (uint64_t(feeId) << 8) | linkId;
+
+  auto [entry, inserted] = mUnitIndices.try_emplace(key, mWorkUnits.size());
+  if (inserted) {
+    auto& unit = mWorkUnits.emplace_back();
+    unit.key = key;
+    unit.feeId = feeId;
+    unit.linkId = linkId;
+  }
+  auto& unit = mWorkUnits[entry->second];
+  if (unit.pages.empty()) {
+    mActiveUnits.push_back(entry->second);
+  }
+  unit.pages.push_back(page);
+  unit.size += page.payloadSize;
+  mSorted = false;
+  mNumberOfPages++;
+}
+
+void RawPageScheduler::split(framework::InputRecord& inputs, const std::vector<framework::InputSpec>& filter)
+{
+  clear();
+  framework::DPLRawParser parser(inputs, filter);
+  for (auto it = parser.begin(), end = parser.end(); it != end; ++it) {
+    RawPage page;
+    page.rdh = reinterpret_cast<const o2::header::RDHAny*>(it.raw());
+    page.payload = reinterpret_cast<const char*>(it.data());
+    page.payloadSize = it.size();
+    page.dataHeader = it.o2DataHeader();
+    page.index = mNumberOfPages;
+    addPage(page);
+  }
+}
+
+std::vector<const RawPageScheduler::WorkUnit*> RawPageScheduler::getWorkUnits() const
+{
+  std::vector<const WorkUnit*> units;
+  units.reserve(mActiveUnits.size());
+  for (auto index : mActiveUnits) {
+    units.push_back(&mWorkUnits[index]);
+  }
+  std::stable_sort(units.begin(), units.end(), [](const WorkUnit* a, const WorkUnit* b) { return a->size > b->size; });
+  return units;
+}
+
+void RawPageScheduler::dispatch(const UnitFunction& function)
+{
+  if (!mSorted) {
+    // the largest units are started first, so that they do not end up alone at the end
+    std::stable_sort(mActiveUnits.begin(), mActiveUnits.end(),
+                     [this](size_t a, size_t b) { return mWorkUnits[a].size > mWorkUnits[b].size; });
+    mSorted = true;
+  }
+
+  if (mThreads.empty() || mActiveUnits.size() < 2) {
+    for (auto index : mActiveUnits) {
+      function(mWorkUnits[index], 0);
+    }
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mFunction = &function;
+    mNextUnit = 0;
+    mRunningThreads = mThreads.size();
+    mGeneration++;
+  }
+  mStartCondition.notify_all();
+  processUnits(0);
+
+  std::exception_ptr exception;
+  {
+    std::unique_lock<std::mutex> lock(mMutex);
+    mDoneCondition.wait(lock, [this] { return mRunningThreads == 0; });
+    mFunction = nullptr;
+    std::swap(exception, mException);
+  }
+  if (exception) {
+    std::rethrow_exception(exception);
+  }
+}
+
+void RawPageScheduler::processUnits(size_t worker)
+{
+  try {
+    for (size_t next = mNextUnit++; next < mActiveUnits.size(); next = mNextUnit++) {
+      (*mFunction)(mWorkUnits[mActiveUnits[next]], worker);
+    }
+  } catch (...) {
+    // the other workers stop after their current unit
+    mNextUnit = std::numeric_limits<size_t>::max() / 2;
+    std::lock_guard<std::mutex> lock(mMutex);
+    if (!mException) {
+      mException = std::current_exception();
+    }
+  }
+}
+
+void RawPageScheduler::work(size_t worker)
+{
+  uint64_t generation = 0;
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(mMutex);
+      mStartCondition.wait(lock, [this, generation] { return mStop || mGeneration != generation; });
+      if (mStop) {
+        return;
+      }
+      generation = mGeneration;
+    }
+    processUnits(worker);
+    {
+      std::lock_guard<std::mutex> lock(mMutex);
+      if (--mRunningThreads == 0) {
+        mDoneCondition.notify_one();
+      }
+    }
+  }
+}
+
+} // namespace o2::quality_control::core
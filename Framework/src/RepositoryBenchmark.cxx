@@ -15,10 +15,15 @@
 
 #include "RepositoryBenchmark.h"
 
+#include <algorithm>
 #include <chrono>
 #include <thread> // this_thread::sleep_for
 
 #include <TH2F.h>
+#include <TProfile.h>
+#include <THnSparse.h>
+#include <TTree.h>
+#include <TROOT.h>
 
 #include <fairmq/FairMQLogger.h>
 #include <options/FairMQProgOptions.h> // device->fConfig
@@ -37,52 +42,144 @@ using namespace o2::monitoring;
 namespace o2::quality_control::core
 {
 
-TH1* RepositoryBenchmark::createHisto(uint64_t sizeObjects, string name)
+namespace
 {
-  TH1* myHisto;
-
-  // Prepare objects (and clean up existing ones)
-  switch (sizeObjects) {
-    case 1:
-      myHisto = new TH1F(name.c_str(), "h", 100, 0, 99); // 1kB
-      break;
-    case 10:
-      myHisto = new TH1F(name.c_str(), "h", 2400, 0, 99); // 10kB
-      break;
-    case 100:
-      myHisto = new TH2F(name.c_str(), "h", 260, 0, 99, 100, 0, 99); // 100kB
-      break;
-    case 500:
-      myHisto = new TH2F(name.c_str(), "h", 1250, 0, 99, 100, 0, 99); // 500kB
-      break;
-    case 1000:
-      myHisto = new TH2F(name.c_str(), "h", 2500, 0, 99, 100, 0, 99); // 1MB
-      break;
-    case 2500:
-      myHisto = new TH2F(name.c_str(), "h", 6250, 0, 99, 100, 0, 99); // 2.5MB
-      break;
-    case 5000:
-      myHisto = new TH2F(name.c_str(), "h", 12500, 0, 99, 100, 0, 99); // 5MB
-      break;
-    default:
-      BOOST_THROW_EXCEPTION(
-        FatalException() << errinfo_details(
-          "size of histo must be 1, 10, 100, 500, 1000, 2500 or 5000 (was: " + to_string(mSizeObjects) + ")"));
+/// Returns the value below which the given fraction of the (partially sorted in place) samples fall.
+uint64_t percentile(std::vector<uint64_t>& samples, double fraction)
+{
+  if (samples.empty()) {
+    return 0;
+  }
+  auto index = std::min(samples.size() - 1, static_cast<size_t>(fraction * samples.size()));
+  std::nth_element(samples.begin(), samples.begin() + index, samples.end());
+  return samples[index];
+}
+} // namespace
+
+RepositoryBenchmark::Mode RepositoryBenchmark::modeFromString(const std::string& mode)
+{
+  if (mode == "store") {
+    return Mode::Store;
+  } else if (mode == "retrieve") {
+    return Mode::Retrieve;
+  } else if (mode == "retrieve-json") {
+    return Mode::RetrieveJson;
+  } else if (mode == "list") {
+    return Mode::List;
+  } else if (mode == "mixed") {
+    return Mode::Mixed;
+  }
+  BOOST_THROW_EXCEPTION(
+    FatalException() << errinfo_details(
+      "mode must be store, retrieve, retrieve-json, list or mixed (was: " + mode + ")"));
+}
+
+TObject* RepositoryBenchmark::createHisto(uint64_t sizeObjects, string name)
+{
+  TObject* myHisto;
+
+  if (mObjectType == "TH1") {
+    // Prepare objects (and clean up existing ones)
+    switch (sizeObjects) {
+      case 1:
+        myHisto = new TH1F(name.c_str(), "h", 100, 0, 99); // 1kB
+        break;
+      case 10:
+        myHisto = new TH1F(name.c_str(), "h", 2400, 0, 99); // 10kB
+        break;
+      case 100:
+        myHisto = new TH2F(name.c_str(), "h", 260, 0, 99, 100, 0, 99); // 100kB
+        break;
+      case 500:
+        myHisto = new TH2F(name.c_str(), "h", 1250, 0, 99, 100, 0, 99); // 500kB
+        break;
+      case 1000:
+        myHisto = new TH2F(name.c_str(), "h", 2500, 0, 99, 100, 0, 99); // 1MB
+        break;
+      case 2500:
+        myHisto = new TH2F(name.c_str(), "h", 6250, 0, 99, 100, 0, 99); // 2.5MB
+        break;
+      case 5000:
+        myHisto = new TH2F(name.c_str(), "h", 12500, 0, 99, 100, 0, 99); // 5MB
+        break;
+      default:
+        BOOST_THROW_EXCEPTION(
+          FatalException() << errinfo_details(
+            "size of histo must be 1, 10, 100, 500, 1000, 2500 or 5000 (was: " + to_string(mSizeObjects) + ")"));
+    }
+  } else if (mObjectType == "TProfile") {
+    // contents, entries and sum of squares of weights: 24 bytes per bin
+    auto nBins = static_cast<int>(sizeObjects * 1000 / 24);
+    myHisto = new TProfile(name.c_str(), "h", nBins, 0, 99);
+  } else if (mObjectType == "THnSparse") {
+    // the size of a sparse histogram depends on the number of filled bins, ~20 bytes each (content, coordinates, index)
+    auto nFilledBins = static_cast<int>(sizeObjects * 1000 / 20);
+    const Int_t bins[2] = { 1024, 1024 };
+    const Double_t min[2] = { 0, 0 };
+    const Double_t max[2] = { 1024, 1024 };
+    auto* sparse = new THnSparseF(name.c_str(), "h", 2, bins, min, max);
+    for (int i = 0; i < nFilledBins; i++) {
+      const Double_t coordinates[2] = { static_cast<Double_t>(i % 1024), static_cast<Double_t>((i / 1024) % 1024) };
+      sparse->Fill(coordinates);
+    }
+    myHisto = sparse;
+  } else if (mObjectType == "TTree") {
+    auto nEntries = static_cast<int>(sizeObjects * 1000 / sizeof(Double_t));
+    auto* tree = new TTree(name.c_str(), "h");
+    tree->SetDirectory(nullptr);
+    Double_t value = 0;
+    tree->Branch("value", &value);
+    for (int i = 0; i < nEntries; i++) {
+      value = i;
+      tree->Fill();
+    }
+    tree->ResetBranchAddresses();
+    myHisto = tree;
+  } else {
+    BOOST_THROW_EXCEPTION(
+      FatalException() << errinfo_details(
+        "type of objects must be TH1, TProfile, THnSparse or TTree (was: " + mObjectType + ")"));
   }
   return myHisto;
 }
 
+std::unique_ptr<DatabaseInterface> RepositoryBenchmark::createDatabase()
+{
+  auto database = o2::quality_control::repository::DatabaseFactory::create(fConfig->GetValue<string>("database-backend"));
+  database->connect(fConfig->GetValue<string>("database-url"), fConfig->GetValue<string>("database-name"),
+                    fConfig->GetValue<string>("database-username"), fConfig->GetValue<string>("database-password"));
+  return database;
+}
+
 void RepositoryBenchmark::InitTask()
 {
+  // parse arguments
+  mMaxIterations = fConfig->GetValue<uint64_t>("max-iterations");
+  mNumberObjects = fConfig->GetValue<uint64_t>("number-objects");
+  mSizeObjects = fConfig->GetValue<uint64_t>("size-objects");
+  mObjectType = fConfig->GetValue<string>("object-type");
+  mDeletionMode = static_cast<bool>(fConfig->GetValue<int>("delete"));
+  mObjectName = fConfig->GetValue<string>("object-name");
+  mMode = modeFromString(fConfig->GetValue<string>("mode"));
+  mReadFraction = fConfig->GetValue<double>("read-fraction");
+  mNumberThreads = std::max<uint64_t>(1, fConfig->GetValue<uint64_t>("number-threads"));
+  mPeriodMs = fConfig->GetValue<uint64_t>("period-ms");
+  auto numberTasks = fConfig->GetValue<uint64_t>("number-tasks");
+  if (mNumberThreads > 1) {
+    // the workers serialize and deserialize the objects concurrently
+    ROOT::EnableThreadSafety();
+  }
+
   // parse arguments database
-  string dbUrl = fConfig->GetValue<string>("database-url");
-  string dbBackend = fConfig->GetValue<string>("database-backend");
   mTaskName = fConfig->GetValue<string>("task-name");
+  mMoFolder = "qc/BMK/MO/" + mTaskName;
   try {
-    mDatabase = o2::quality_control::repository::DatabaseFactory::create(dbBackend);
-    mDatabase->connect(fConfig->GetValue<string>("database-url"), fConfig->GetValue<string>("database-name"),
-                       fConfig->GetValue<string>("database-username"), fConfig->GetValue<string>("database-password"));
+    mDatabase = createDatabase();
     mDatabase->prepareTaskDataContainer(mTaskName);
+    // each thread gets its own connection, the backends are not meant to be shared between threads
+    for (uint64_t i = 1; i < mNumberThreads; i++) {
+      mWorkerDatabases.push_back(createDatabase());
+    }
   } catch (boost::exception& exc) {
     string diagnostic = boost::current_exception_diagnostic_information();
     ILOG(Error, Support) << "Unexpected exception, diagnostic information follows:\n"
@@ -92,14 +189,6 @@ void RepositoryBenchmark::InitTask()
     }
   }
 
-  // parse other arguments
-  mMaxIterations = fConfig->GetValue<uint64_t>("max-iterations");
-  mNumberObjects = fConfig->GetValue<uint64_t>("number-objects");
-  mSizeObjects = fConfig->GetValue<uint64_t>("size-objects");
-  mDeletionMode = static_cast<bool>(fConfig->GetValue<int>("delete"));
-  mObjectName = fConfig->GetValue<string>("object-name");
-  auto numberTasks = fConfig->GetValue<uint64_t>("number-tasks");
-
   // monitoring
   mMonitoring = MonitoringFactory::Get(fConfig->GetValue<string>("monitoring-url"));
   mThreadedMonitoring = static_cast<bool>(fConfig->GetValue<int>("monitoring-threaded"));
@@ -108,11 +197,15 @@ void RepositoryBenchmark::InitTask()
   mMonitoring->addGlobalTag("taskName", mTaskName);
   mMonitoring->addGlobalTag("numberObject", to_string(mNumberObjects));
   mMonitoring->addGlobalTag("sizeObject", to_string(mSizeObjects));
+  mMonitoring->addGlobalTag("typeObject", mObjectType);
+  mMonitoring->addGlobalTag("mode", fConfig->GetValue<string>("mode"));
+  mMonitoring->addGlobalTag("numberThreads", to_string(mNumberThreads));
   if (mTaskName == "benchmarkTask_0") { // send these parameters to monitoring only once per benchmark run
     mMonitoring->send(Metric{ "ccdb_benchmark" }
                         .addValue(mNumberObjects, "number_objects")
                         .addValue(mSizeObjects * 1000, "size_objects")
-                        .addValue(numberTasks, "number_tasks"));
+                        .addValue(numberTasks, "number_tasks")
+                        .addValue(mNumberThreads, "number_threads"));
   }
 
   if (mDeletionMode) {
@@ -122,12 +215,23 @@ void RepositoryBenchmark::InitTask()
 
   // prepare objects
   for (uint64_t i = 0; i < mNumberObjects; i++) {
-    TH1* histo = createHisto(mSizeObjects, mObjectName + to_string(i));
+    TObject* histo = createHisto(mSizeObjects, mObjectName + to_string(i));
     shared_ptr<MonitorObject> mo = make_shared<MonitorObject>(histo, mTaskName, "BMK");
     mo->setIsOwner(true);
     mMyObjects.push_back(mo);
   }
 
+  // the read modes need something to read
+  if (mMode != Mode::Store && !mDeletionMode) {
+    for (const auto& mo : mMyObjects) {
+      mDatabase->storeMO(mo);
+    }
+  }
+
+  for (uint64_t i = 0; i < mNumberThreads; i++) {
+    mWorkerGenerators.emplace_back(i);
+  }
+
   // start a timer in a thread to send monitoring metrics, if needed
   if (mThreadedMonitoring) {
     mTimer = new boost::asio::deadline_timer(io, boost::posix_time::seconds(mThreadedMonitoringInterval));
@@ -136,15 +240,86 @@ void RepositoryBenchmark::InitTask()
   }
 }
 
+void RepositoryBenchmark::sendMetrics()
+{
+  mMonitoring->send({ mTotalNumberObjects.load(), "ccdb_benchmark_objects_sent" }, DerivedMetricMode::RATE);
+  mMonitoring->send({ mTotalNumberRetrieved.load(), "ccdb_benchmark_objects_retrieved" }, DerivedMetricMode::RATE);
+
+  std::vector<uint64_t> latencies;
+  {
+    std::lock_guard<std::mutex> lock(mLatenciesMutex);
+    latencies.swap(mLatenciesUs);
+  }
+  if (!latencies.empty()) {
+    mMonitoring->send(Metric{ "ccdb_benchmark_latency_us" }
+                        .addValue(percentile(latencies, 0.5), "p50")
+                        .addValue(percentile(latencies, 0.99), "p99")
+                        .addValue(percentile(latencies, 0.999), "p999")
+                        .addValue(static_cast<uint64_t>(latencies.size()), "count"));
+  }
+}
+
 void RepositoryBenchmark::checkTimedOut()
 {
-  mMonitoring->send({ mTotalNumberObjects, "ccdb_benchmark_objects_sent" }, DerivedMetricMode::RATE);
+  sendMetrics();
 
   // restart timer
   mTimer->expires_at(mTimer->expires_at() + boost::posix_time::seconds(mThreadedMonitoringInterval));
   mTimer->async_wait(boost::bind(&RepositoryBenchmark::checkTimedOut, this));
 }
 
+void RepositoryBenchmark::runWorker(size_t workerIndex)
+{
+  auto* database = workerIndex == 0 ? mDatabase.get() : mWorkerDatabases[workerIndex - 1].get();
+  auto& generator = mWorkerGenerators[workerIndex];
+  std::uniform_real_distribution<double> distribution(0.0, 1.0);
+  std::vector<uint64_t> latencies;
+  latencies.reserve(mNumberObjects);
+  uint64_t totalLatencyUs = 0;
+
+  for (unsigned int i = 0; i < mNumberObjects; i++) {
+    high_resolution_clock::time_point t1 = high_resolution_clock::now();
+    switch (mMode) {
+      case Mode::Store:
+        database->storeMO(mMyObjects[i]);
+        mTotalNumberObjects++;
+        break;
+      case Mode::Retrieve:
+        database->retrieveMO(mMoFolder, mMyObjects[i]->getName());
+        mTotalNumberRetrieved++;
+        break;
+      case Mode::RetrieveJson:
+        database->retrieveJson(mMyObjects[i]->getPath());
+        mTotalNumberRetrieved++;
+        break;
+      case Mode::List:
+        database->getPublishedObjectNames(mMoFolder);
+        mTotalNumberRetrieved++;
+        break;
+      case Mode::Mixed:
+        // reads are shared equally between the trending-like (MO) and the QCG-like (JSON) accesses
+        if (distribution(generator) < mReadFraction) {
+          if (i % 2 == 0) {
+            database->retrieveMO(mMoFolder, mMyObjects[i]->getName());
+          } else {
+            database->retrieveJson(mMyObjects[i]->getPath());
+          }
+          mTotalNumberRetrieved++;
+        } else {
+          database->storeMO(mMyObjects[i]);
+          mTotalNumberObjects++;
+        }
+        break;
+    }
+    latencies.push_back(duration_cast<microseconds>(high_resolution_clock::now() - t1).count());
+    totalLatencyUs += latencies.back();
+  }
+  mIterationLatencyUs += totalLatencyUs;
+
+  std::lock_guard<std::mutex> lock(mLatenciesMutex);
+  mLatenciesUs.insert(mLatenciesUs.end(), latencies.begin(), latencies.end());
+}
+
 bool RepositoryBenchmark::ConditionalRun()
 {
   if (mDeletionMode) { // the only way to not run is to return false from here.
@@ -152,28 +327,41 @@ bool RepositoryBenchmark::ConditionalRun()
   }
 
   high_resolution_clock::time_point t1 = high_resolution_clock::now();
+  mIterationLatencyUs = 0;
 
-  // Store the object
-  for (unsigned int i = 0; i < mNumberObjects; i++) {
-    mDatabase->storeMO(mMyObjects[i]);
-    mTotalNumberObjects++;
+  // Run the operations, each thread goes through all the objects
+  if (mNumberThreads == 1) {
+    runWorker(0);
+  } else {
+    std::vector<std::thread> workers;
+    for (size_t w = 0; w < mNumberThreads; w++) {
+      workers.emplace_back(&RepositoryBenchmark::runWorker, this, w);
+    }
+    for (auto& worker : workers) {
+      worker.join();
+    }
   }
   if (!mThreadedMonitoring) {
-    mMonitoring->send({ mTotalNumberObjects, "ccdb_benchmark_objects_sent" }, DerivedMetricMode::RATE);
+    sendMetrics();
   }
 
   high_resolution_clock::time_point t2 = high_resolution_clock::now();
   long duration = duration_cast<milliseconds>(t2 - t1).count();
-  mMonitoring->send({ duration / mNumberObjects, "ccdb_benchmark_store_duration_for_one_object_ms" });
-
-  // determine how long we should wait till next iteration in order to have 1 sec between storage
-  auto duration2 = duration_cast<microseconds>(t2 - t1);
-  auto remaining = duration_cast<microseconds>(std::chrono::seconds(1) - duration2);
-  //  QcInfoLogger::GetInstance() << "Remaining duration : " << remaining.count() << " us" << infologger::endm;
-  if (remaining.count() < 0) {
-    QcInfoLogger::GetInstance() << "Remaining duration is negative, we don't sleep " << infologger::endm;
-  } else {
-    this_thread::sleep_for(chrono::microseconds(remaining));
+  string operation = mMode == Mode::Store ? "store" : mMode == Mode::List ? "list" : mMode == Mode::Mixed ? "mixed" : "retrieve";
+  // the mean latency of an operation, the wall time of the iteration is shared by the threads
+  mMonitoring->send({ mIterationLatencyUs / 1000.0 / (mNumberObjects * mNumberThreads), "ccdb_benchmark_" + operation + "_duration_for_one_object_ms" });
+  mMonitoring->send({ duration > 0 ? 1000.0 * mNumberObjects * mNumberThreads / duration : 0.0, "ccdb_benchmark_" + operation + "_objects_per_second" });
+
+  // determine how long we should wait till next iteration in order to have the requested period between iterations
+  if (mPeriodMs > 0) {
+    auto duration2 = duration_cast<microseconds>(t2 - t1);
+    auto remaining = duration_cast<microseconds>(std::chrono::milliseconds(mPeriodMs) - duration2);
+    //  QcInfoLogger::GetInstance() << "Remaining duration : " << remaining.count() << " us" << infologger::endm;
+    if (remaining.count() < 0) {
+      QcInfoLogger::GetInstance() << "Remaining duration is negative, we don't sleep " << infologger::endm;
+    } else {
+      this_thread::sleep_for(chrono::microseconds(remaining));
+    }
   }
 
   if (mMaxIterations > 0 && ++mNumIterations >= mMaxIterations) {
@@ -18,47 +18,84 @@
 
 #include "QualityControl/DatabaseInterface.h"
 #include <fairmq/FairMQDevice.h>
-#include <TH1.h>
+#include <TObject.h>
 #include <Monitoring/MonitoringFactory.h>
 #include <boost/asio.hpp>
+#include <atomic>
+#include <mutex>
+#include <random>
 #include <thread>
 #include <string>
 
 namespace o2::quality_control::core
 {
 
+/// \brief Device simulating a client of the QC repository.
+///
+/// Depending on the mode, each iteration stores, retrieves (as MO or as JSON), lists or does a mix of
+/// reads and writes on `number-objects` objects, from `number-threads` threads in parallel. Iterations
+/// are paced to `period-ms` (1 s by default) or run back to back if it is 0. The latency of every single
+/// operation is recorded and its percentiles are sent to monitoring together with the objects rates.
 class RepositoryBenchmark : public FairMQDevice
 {
  public:
   RepositoryBenchmark() = default;
   virtual ~RepositoryBenchmark() = default;
 
+  enum class Mode {
+    Store,
+    Retrieve,
+    RetrieveJson,
+    List,
+    Mixed
+  };
+
+  static Mode modeFromString(const std::string& mode);
+
  protected:
   virtual void InitTask();
   virtual bool ConditionalRun();
   void emptyDatabase();
   void checkTimedOut();
-  TH1* createHisto(uint64_t sizeObjects, std::string name);
+  TObject* createHisto(uint64_t sizeObjects, std::string name);
 
  private:
+  std::unique_ptr<o2::quality_control::repository::DatabaseInterface> createDatabase();
+  /// Executes one operation per object with the database dedicated to this worker.
+  void runWorker(size_t workerIndex);
+  /// Sends the objects rates and the latency percentiles accumulated since the last call, then resets the latter.
+  void sendMetrics();
+
   // user params
   uint64_t mMaxIterations = 0;
   uint64_t mNumIterations = 0;
   uint64_t mNumberObjects = 1;
   uint64_t mSizeObjects = 1;
+  std::string mObjectType = "TH1";
   std::string mTaskName;
   std::string mObjectName;
   bool mDeletionMode = false; // todo: is false ok as default?
+  Mode mMode = Mode::Store;
+  double mReadFraction = 0.5; // only used in Mode::Mixed
+  uint64_t mNumberThreads = 1;
+  uint64_t mPeriodMs = 1000; // 0 means unpaced
 
   // monitoring
   std::unique_ptr<o2::monitoring::Monitoring> mMonitoring;
-  uint64_t mTotalNumberObjects = 0;
+  std::atomic<uint64_t> mTotalNumberObjects{ 0 };   // stored
+  std::atomic<uint64_t> mTotalNumberRetrieved{ 0 }; // retrieved or listed
+  std::atomic<uint64_t> mIterationLatencyUs{ 0 };   // sum of the latencies of the operations of the iteration
   bool mThreadedMonitoring = true;
   uint64_t mThreadedMonitoringInterval = 10;
+  std::vector<uint64_t> mLatenciesUs; // latencies of the operations since the last report
+  std::mutex mLatenciesMutex;
 
   // internal state
   std::unique_ptr<o2::quality_control::repository::DatabaseInterface> mDatabase;
+  std::vector<std::unique_ptr<o2::quality_control::repository::DatabaseInterface>> mWorkerDatabases; // one per additional thread
+  std::vector<std::mt19937> mWorkerGenerators;
   std::vector<std::shared_ptr<MonitorObject>> mMyObjects;
+  std::string mMoFolder;
   //  TH1* mMyHisto;
 
   // variables for the timer
@@ -33,7 +33,8 @@ ServiceDiscovery::ServiceDiscovery(const std::string& url, const std::string& na
   }
 
   mHealthThread = std::thread([=] { runHealthServer(std::stoi(mHealthEndpoint.substr(mHealthEndpoint.find(":") + 1))); });
-  _register("");
+  mRegistrationThread = std::thread([=] { runRegistration(); });
+  _register(std::vector<std::string>{});
 }
 
 ServiceDiscovery::~ServiceDiscovery()
@@ -42,6 +43,14 @@ ServiceDiscovery::~ServiceDiscovery()
   if (mHealthThread.joinable()) {
     mHealthThread.join();
   }
+  {
+    std::lock_guard<std::mutex> lock(mRegistrationMutex);
+    mRegistrationRunning = false;
+  }
+  mRegistrationCondition.notify_one();
+  if (mRegistrationThread.joinable()) {
+    mRegistrationThread.join();
+  }
   deregister();
 }
 
@@ -64,12 +73,28 @@ CURL* ServiceDiscovery::initCurl()
 
 void ServiceDiscovery::_register(const std::string& objects)
 {
-  boost::property_tree::ptree pt;
+  std::vector<std::string> objectsVec;
   if (!objects.empty()) {
-    std::vector<std::string> objectsVec;
     boost::split(objectsVec, objects, boost::is_any_of(","), boost::token_compress_on);
+  }
+  _register(std::move(objectsVec));
+}
+
+void ServiceDiscovery::_register(std::vector<std::string> objects)
+{
+  {
+    std::lock_guard<std::mutex> lock(mRegistrationMutex);
+    mPendingObjects = std::move(objects);
+  }
+  mRegistrationCondition.notify_one();
+}
+
+std::string ServiceDiscovery::createRegistrationPayload(const std::vector<std::string>& objects) const
+{
+  boost::property_tree::ptree pt;
+  if (!objects.empty()) {
     boost::property_tree::ptree tag, tags;
-    for (auto& object : objectsVec) {
+    for (auto& object : objects) {
       tag.put("", object);
       tags.push_back(std::make_pair("", tag));
     }
@@ -89,17 +114,70 @@ void ServiceDiscovery::_register(const std::string& objects)
 
   std::stringstream ss;
   boost::property_tree::json_parser::write_json(ss, pt);
-
-  send("/v1/agent/service/register", ss.str());
-  ILOG(Info, Devel) << "Registration to ServiceDiscovery: " << objects << ENDM;
+  return ss.str();
 }
 
 void ServiceDiscovery::deregister()
 {
-  send("/v1/agent/service/deregister/" + mId, "");
+  {
+    std::lock_guard<std::mutex> lock(mRegistrationMutex);
+    mPendingObjects.reset();
+  }
+  std::string error;
+  {
+    std::lock_guard<std::mutex> lock(mCurlMutex);
+    mRegisteredPayload.clear(); // so that a following registration is sent even if it is the same
+    error = send("/v1/agent/service/deregister/" + mId, "");
+  }
+  if (!error.empty()) {
+    ILOG(Error, Devel) << "ServiceDiscovery::deregister() " << error << ENDM;
+  }
   ILOG(Info, Devel) << "Deregistration from ServiceDiscovery" << ENDM;
 }
 
+void ServiceDiscovery::runRegistration()
+{
+  // InfoLogger is not thread safe, we create a new instance for this thread.
+  AliceO2::InfoLogger::InfoLogger threadInfoLogger;
+  infoContext context;
+  context.setField(infoContext::FieldName::Facility, "ServiceDiscovery");
+  context.setField(infoContext::FieldName::System, "QC");
+  threadInfoLogger.setContext(context);
+
+  std::unique_lock<std::mutex> lock(mRegistrationMutex);
+  while (true) {
+    mRegistrationCondition.wait(lock, [this] { return !mRegistrationRunning || mPendingObjects.has_value(); });
+    // let the following requests arrive, only the latest one is sent
+    mRegistrationCondition.wait_for(lock, RegistrationDelay, [this] { return !mRegistrationRunning; });
+    if (!mRegistrationRunning) {
+      return;
+    }
+    if (!mPendingObjects.has_value()) {
+      continue; // dropped by deregister()
+    }
+    auto objects = std::move(*mPendingObjects);
+    mPendingObjects.reset();
+    lock.unlock();
+
+    auto payload = createRegistrationPayload(objects);
+    std::unique_lock<std::mutex> curlLock(mCurlMutex);
+    if (payload != mRegisteredPayload) {
+      auto error = send("/v1/agent/service/register", std::string(payload));
+      if (error.empty()) {
+        mRegisteredPayload = std::move(payload);
+      }
+      curlLock.unlock();
+      if (error.empty()) {
+        threadInfoLogger << AliceO2::InfoLogger::InfoLogger::Severity::Info << "Registration to ServiceDiscovery: " << objects.size() << " objects" << ENDM;
+      } else {
+        threadInfoLogger << AliceO2::InfoLogger::InfoLogger::Severity::Error << "ServiceDiscovery::send(...) " << error << ENDM;
+      }
+    }
+
+    lock.lock();
+  }
+}
+
 void ServiceDiscovery::runHealthServer(unsigned int port)
 {
   using boost::asio::ip::tcp;
@@ -142,7 +220,7 @@ void ServiceDiscovery::deleteCurl(CURL* curl)
   curl_global_cleanup();
 }
 
-void ServiceDiscovery::send(const std::string& path, std::string&& post)
+std::string ServiceDiscovery::send(const std::string& path, std::string&& post)
 {
   std::string uri = mConsulUrl + path;
   CURLcode response;
@@ -153,11 +231,11 @@ void ServiceDiscovery::send(const std::string& path, std::string&& post)
   response = curl_easy_perform(curl);
   curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &responseCode);
   if (response != CURLE_OK) {
-    ILOG(Error, Devel) << "ServiceDiscovery::send(...) " << curl_easy_strerror(response) << ENDM;
-    ILOG(Error, Devel) << "   URI: " << uri << ENDM;
+    return std::string(curl_easy_strerror(response)) + ", URI: " + uri;
   }
   if (responseCode < 200 || responseCode > 206) {
-    ILOG(Error, Devel) << "ServiceDiscovery::send(...) Response code: " << responseCode << ENDM;
+    return "Response code: " + std::to_string(responseCode) + ", URI: " + uri;
   }
+  return {};
 }
 } // namespace o2::quality_control::core
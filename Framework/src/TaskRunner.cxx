@@ -16,6 +16,7 @@
 
 #include "QualityControl/TaskRunner.h"
 
+#include <algorithm>
 #include <memory>
 
 // O2
@@ -104,9 +105,24 @@ void TaskRunner::init(InitContext& iCtx)
   mCollector->addGlobalTag(tags::Key::Subsystem, tags::Value::QC);
   mCollector->addGlobalTag("TaskName", mTaskConfig.taskName);
 
+  // setup tracing
+  mTracer.init(mConfigFile->get<std::string>("qc.config.tracing.directory", ""), mDeviceName);
+
   // setup publisher
   mObjectsManager = std::make_shared<ObjectsManager>(mTaskConfig.taskName, mTaskConfig.detectorName, mTaskConfig.consulUrl, mTaskConfig.parallelTaskID);
 
+  // setup the adaptive cycle duration
+  if (mTaskConfig.cyclePublicationBudget > 0) {
+    mCycleDurationController = std::make_unique<CycleDurationController>(mTaskConfig.cycleDurationSeconds,
+                                                                         mTaskConfig.minCycleDurationSeconds,
+                                                                         mTaskConfig.maxCycleDurationSeconds,
+                                                                         mTaskConfig.cyclePublicationBudget);
+  }
+
+  if (mPublishObjectTable) {
+    mObjectTable = std::make_unique<MonitorObjectTable>(mCompactHistograms);
+  }
+
   // setup user's task
   TaskFactory f;
   mTask.reset(f.create(mTaskConfig, mObjectsManager));
@@ -139,7 +155,7 @@ void TaskRunner::run(ProcessingContext& pCtx)
     updateMonitoringStats(pCtx);
   }
 
-  if (timerReady) {
+  if (timerReady && isCycleOver()) {
     finishCycle(pCtx.outputs());
     if (mResetAfterPublish) {
       mTask->reset();
@@ -192,6 +208,12 @@ CompletionPolicy::CompletionOp TaskRunner::completionPolicyCallback(o2::framewor
 
 void TaskRunner::setResetAfterPublish(bool resetAfterPublish) { mResetAfterPublish = resetAfterPublish; }
 
+void TaskRunner::setPublishObjectTable(bool publishObjectTable, bool compactHistograms)
+{
+  mPublishObjectTable = publishObjectTable;
+  mCompactHistograms = compactHistograms;
+}
+
 std::string TaskRunner::createTaskRunnerIdString()
 {
   return std::string("QC-TASK-RUNNER");
@@ -322,7 +344,15 @@ void TaskRunner::loadTopologyConfig()
 
   // needed to avoid having looping at the maximum speed
   mTaskConfig.cycleDurationSeconds = taskConfigTree.get<int>("cycleDurationSeconds", 10);
-  mOptions.push_back({ "period-timer-cycle", framework::VariantType::Int, static_cast<int>(mTaskConfig.cycleDurationSeconds * 1000000), { "timer period" } });
+  int timerPeriodSeconds = mTaskConfig.cycleDurationSeconds;
+  if (auto adaptiveCycle = taskConfigTree.get_child_optional("adaptiveCycle")) {
+    mTaskConfig.cyclePublicationBudget = adaptiveCycle->get<double>("publicationBudget", 0.05);
+    mTaskConfig.minCycleDurationSeconds = std::max(1, adaptiveCycle->get<int>("minSeconds", 1));
+    mTaskConfig.maxCycleDurationSeconds = adaptiveCycle->get<int>("maxSeconds", 10 * mTaskConfig.cycleDurationSeconds);
+    // the timer only gives the granularity, the TaskRunner decides when the cycle is over
+    timerPeriodSeconds = 1;
+  }
+  mOptions.push_back({ "period-timer-cycle", framework::VariantType::Int, static_cast<int>(timerPeriodSeconds * 1000000), { "timer period" } });
   mOptions.push_back({ "runNumber", framework::VariantType::String, { "Run number" } });
 }
 
@@ -362,6 +392,11 @@ void TaskRunner::loadTaskConfig()
   ILOG(Info, Support) << ">> Module name : " << mTaskConfig.moduleName << ENDM;
   ILOG(Info, Support) << ">> Detector name : " << mTaskConfig.detectorName << ENDM;
   ILOG(Info, Support) << ">> Cycle duration seconds : " << mTaskConfig.cycleDurationSeconds << ENDM;
+  if (mTaskConfig.cyclePublicationBudget > 0) {
+    ILOG(Info, Support) << ">> Adaptive cycle duration between " << mTaskConfig.minCycleDurationSeconds << " and "
+                        << mTaskConfig.maxCycleDurationSeconds << " seconds, publication budget : "
+                        << mTaskConfig.cyclePublicationBudget << ENDM;
+  }
   ILOG(Info, Support) << ">> Max number cycles : " << mTaskConfig.maxNumberCycles << ENDM;
   ILOG(Info, Support) << ">> Save to file : " << mTaskConfig.saveToFile << ENDM;
 }
@@ -427,12 +462,33 @@ void TaskRunner::startCycle()
   mDataReceivedInCycle = 0;
   mTimerDurationCycle.reset();
   mCycleOn = true;
+  if (mTracer.isEnabled()) {
+    mTrace = { { Tracer::CycleKey, static_cast<uint64_t>(mCycleNumber) } };
+    Tracer::stamp(mTrace, Tracer::Stage::StartOfCycle);
+  }
+}
+
+bool TaskRunner::isCycleOver()
+{
+  if (mCycleDurationController == nullptr) {
+    return true;
+  }
+  // the timer ticks every second, half of it is kept as a margin against its jitter
+  return mTimerDurationCycle.getTime() + 0.5 >= mCycleDurationController->getCycleDuration();
 }
 
 void TaskRunner::finishCycle(DataAllocator& outputs)
 {
+  AliceO2::Common::Timer finishCycleTimer;
+  if (mTracer.isEnabled()) {
+    Tracer::stamp(mTrace, Tracer::Stage::MonitorData);
+  }
   mTask->endOfCycle();
+  mObjectsManager->render();
 
+  if (mCycleDurationController) {
+    mObjectsManager->updateCycleDuration(mTimerDurationCycle.getTime());
+  }
   mNumberObjectsPublishedInCycle += publish(outputs);
   mTotalNumberObjectsPublished += mNumberObjectsPublishedInCycle;
   saveToFile();
@@ -440,6 +496,11 @@ void TaskRunner::finishCycle(DataAllocator& outputs)
   publishCycleStats();
   mObjectsManager->updateServiceDiscovery();
 
+  if (mCycleDurationController) {
+    // endOfCycle is part of the cost, as it is paid once per cycle as well
+    mCycleDurationController->update(finishCycleTimer.getTime());
+  }
+
   mCycleNumber++;
   mCycleOn = false;
 
@@ -482,6 +543,10 @@ void TaskRunner::publishCycleStats()
                      .addValue(mLastPublicationDuration, "publication")
                      .addValue(totalDurationActivity, "activity_whole_run"));
 
+  if (mCycleDurationController) {
+    mCollector->send(Metric{ "qc_adaptive_cycle" }.addValue(mCycleDurationController->getCycleDuration(), "next_cycle_duration"));
+  }
+
   mCollector->send(Metric{ "qc_objects_published" }
                      .addValue(mNumberObjectsPublishedInCycle, "in_cycle")
                      .addValue(rate, "per_second")
@@ -499,15 +564,25 @@ int TaskRunner::publish(DataAllocator& outputs)
   // owning them. The array is created by new and must be cleaned up by the caller
   std::unique_ptr<MonitorObjectCollection> array(mObjectsManager->getNonOwningArray());
   int objectsPublished = array->GetEntries();
+  if (mTracer.isEnabled()) {
+    // stamped before the snapshot, so that it travels with the objects
+    Tracer::stamp(mTrace, Tracer::Stage::Publish);
+    array->setTrace(mTrace);
+  }
 
-  outputs.snapshot(
-    Output{ concreteOutput.origin,
-            concreteOutput.description,
-            concreteOutput.subSpec,
-            mMonitorObjectsSpec.lifetime },
-    *array);
+  Output output{ concreteOutput.origin,
+                 concreteOutput.description,
+                 concreteOutput.subSpec,
+                 mMonitorObjectsSpec.lifetime };
+  if (mObjectTable) {
+    mObjectTable->write(*array, array->getTrace());
+    outputs.snapshot(output, mObjectTable->getBuffer());
+  } else {
+    outputs.snapshot(output, *array);
+  }
 
   mLastPublicationDuration = publicationDurationTimer.getTime();
+  mTracer.exportSpans(mTrace, mTaskConfig.taskName, { Tracer::Stage::MonitorData, Tracer::Stage::Publish });
   return objectsPublished;
 }
 
@@ -0,0 +1,155 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   Tracer.cxx
+///
+
+#include "QualityControl/Tracer.h"
+#include "QualityControl/QcInfoLogger.h"
+
+#include <algorithm>
+#include <chrono>
+#include <unistd.h>
+
+namespace o2::quality_control::core
+{
+
+namespace
+{
+std::string escape(const std::string& text)
+{
+  std::string escaped;
+  escaped.reserve(text.size());
+  for (char c : text) {
+    if (c == '"' || c == '\\') {
+      escaped += '\\';
+    }
+    escaped += c;
+  }
+  return escaped;
+}
+} // namespace
+
+Tracer::~Tracer()
+{
+  if (isEnabled()) {
+    mFile << "\n]\n";
+  }
+}
+
+void Tracer::init(const std::string& directory, const std::string& deviceName)
+{
+  if (directory.empty()) {
+    return;
+  }
+  std::string path = directory + "/qc-trace-" + deviceName + ".json";
+  mFile.open(path, std::ios::trunc);
+  if (!mFile.is_open()) {
+    ILOG(Error, Support) << "Could not open the trace file " << path << ", tracing is disabled" << ENDM;
+    return;
+  }
+  ILOG(Info, Support) << "Tracing the processing stages to " << path << ENDM;
+  mProcessId = getpid();
+  mFile << "[";
+  writeEvent(R"({"name":"process_name","ph":"M","pid":)" + std::to_string(mProcessId) + R"(,"args":{"name":")" + escape(deviceName) + R"("}})");
+}
+
+void Tracer::exportSpans(const TraceStamps& stamps, const std::string& objectName, std::initializer_list<Stage> stages)
+{
+  if (!isEnabled()) {
+    return;
+  }
+  auto cycle = stamps.find(CycleKey);
+  for (auto stage : stages) {
+    auto end = stamps.find(getStageName(stage));
+    if (end == stamps.end()) {
+      continue;
+    }
+    // the span starts at the closest previous stage which was stamped
+    uint64_t begin = end->second;
+    for (int previous = static_cast<int>(stage) - 1; previous >= 0; previous--) {
+      auto found = stamps.find(getStageName(static_cast<Stage>(previous)));
+      if (found != stamps.end()) {
+        begin = std::min(found->second, end->second);
+        break;
+      }
+    }
+    writeEvent(R"({"name":")" + std::string(getStageName(stage)) + R"(","cat":"qc","ph":"X","ts":)" + std::to_string(begin) +
+               R"(,"dur":)" + std::to_string(end->second - begin) + R"(,"pid":)" + std::to_string(mProcessId) +
+               R"(,"tid":)" + std::to_string(getThreadId(objectName)) + R"(,"args":{"object":")" + escape(objectName) +
+               R"(","cycle":)" + (cycle != stamps.end() ? std::to_string(cycle->second) : "null") + "}}");
+  }
+}
+
+const char* Tracer::getStageName(Stage stage)
+{
+  switch (stage) {
+    case Stage::StartOfCycle:
+      return "start_of_cycle";
+    case Stage::MonitorData:
+      return "monitor_data";
+    case Stage::Publish:
+      return "publish";
+    case Stage::Merge:
+      return "merge";
+    case Stage::Check:
+      return "check";
+    case Stage::Store:
+      return "store";
+    case Stage::Aggregate:
+      return "aggregate";
+  }
+  return "unknown";
+}
+
+void Tracer::stamp(TraceStamps& stamps, Stage stage)
+{
+  auto now = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now().time_since_epoch());
+  stamps[getStageName(stage)] = now.count();
+}
+
+uint64_t Tracer::getStamp(const TraceStamps& stamps, Stage stage)
+{
+  auto found = stamps.find(getStageName(stage));
+  return found != stamps.end() ? found->second : 0;
+}
+
+uint64_t Tracer::getLastStamp(const TraceStamps& stamps)
+{
+  uint64_t last = 0;
+  for (const auto& [key, value] : stamps) {
+    if (key != CycleKey) {
+      last = std::max(last, value);
+    }
+  }
+  return last;
+}
+
+int Tracer::getThreadId(const std::string& objectName)
+{
+  auto [it, inserted] = mThreadIds.emplace(objectName, static_cast<int>(mThreadIds.size()) + 1);
+  if (inserted) {
+    writeEvent(R"({"name":"thread_name","ph":"M","pid":)" + std::to_string(mProcessId) + R"(,"tid":)" + std::to_string(it->second) +
+               R"(,"args":{"name":")" + escape(objectName) + R"("}})");
+  }
+  return it->second;
+}
+
+void Tracer::writeEvent(const std::string& event)
+{
+  mFile << (mFirstEvent ? "\n" : ",\n") << event;
+  mFirstEvent = false;
+  // The devices are often killed rather than destroyed. The closing bracket being optional in this format,
+  // flushing is enough for the file to be readable at any time.
+  mFile.flush();
+}
+
+} // namespace o2::quality_control::core
@@ -26,6 +26,10 @@
 #include <TDatime.h>
 #include <TGraphErrors.h>
 #include <TPoint.h>
+#include <TBranch.h>
+#include <algorithm>
+#include <cstring>
+#include <map>
 
 using namespace o2::quality_control;
 using namespace o2::quality_control::core;
@@ -36,22 +40,103 @@ void TrendingTask::configure(std::string name, const boost::property_tree::ptree
   mConfig = TrendingTaskConfig(name, config);
 }
 
-void TrendingTask::initialize(Trigger, framework::ServiceRegistry&)
+void TrendingTask::initialize(Trigger t, framework::ServiceRegistry& services)
 {
-  // Preparing data structure of TTree
-  mTrend = std::make_unique<TTree>(); // todo: retrieve last TTree, so we continue trending. maybe do it optionally?
-  mTrend->SetName(PostProcessingInterface::getName().c_str());
-  mTrend->Branch("meta", &mMetaData, "runNumber/I");
-  mTrend->Branch("time", &mTime);
-
   for (const auto& source : mConfig.dataSources) {
-    std::unique_ptr<Reductor> reductor(root_class_factory::create<Reductor>(source.moduleName, source.reductorName));
-    mTrend->Branch(source.name.c_str(), reductor->getBranchAddress(), reductor->getBranchLeafList());
-    mReductors[source.name] = std::move(reductor);
+    mReductors[source.name].reset(root_class_factory::create<Reductor>(source.moduleName, source.reductorName));
+  }
+
+  if (mConfig.resumeTrend && resumeTrend(services.get<repository::DatabaseInterface>())) {
+    backfillTrend(t.timestamp, services.get<repository::DatabaseInterface>());
+  } else {
+    // Preparing data structure of TTree
+    mTrend = std::make_unique<TTree>();
+    mTrend->SetName(PostProcessingInterface::getName().c_str());
+    mTrend->Branch("meta", &mMetaData, "runNumber/I");
+    mTrend->Branch("time", &mTime);
+    for (const auto& source : mConfig.dataSources) {
+      auto& reductor = mReductors[source.name];
+      mTrend->Branch(source.name.c_str(), reductor->getBranchAddress(), reductor->getBranchLeafList());
+    }
   }
   getObjectsManager()->startPublishing(mTrend.get());
 }
 
+bool TrendingTask::resumeTrend(repository::DatabaseInterface& qcdb)
+{
+  auto mo = qcdb.retrieveMO("qc/" + mConfig.detectorName + "/MO/" + mConfig.taskName, PostProcessingInterface::getName());
+  auto* storedTrend = mo ? dynamic_cast<TTree*>(mo->getObject()) : nullptr;
+  if (storedTrend == nullptr || storedTrend->GetEntries() == 0) {
+    ILOG(Info, Support) << "No trend to resume in the repository, starting a new one." << ENDM;
+    return false;
+  }
+  if (!isCompatible(*storedTrend)) {
+    ILOG(Warning, Support) << "The branches of the stored trend do not match the data sources, starting a new one." << ENDM;
+    return false;
+  }
+
+  mo->setIsOwner(false);
+  mTrend.reset(storedTrend);
+  mTrend->SetDirectory(nullptr);
+  mTrend->SetBranchAddress("meta", &mMetaData);
+  mTrend->SetBranchAddress("time", &mTime);
+  for (auto& [name, reductor] : mReductors) {
+    mTrend->SetBranchAddress(name.c_str(), reductor->getBranchAddress());
+  }
+  // Reading the last entry sets mTime to where the backfill starts and the reductors to their last values,
+  // which are kept for the data sources without a newer version.
+  mTrend->GetEntry(mTrend->GetEntries() - 1);
+  ILOG(Info, Support) << "Resuming the trend with " << mTrend->GetEntries() << " entries, the last one at " << mTime << "." << ENDM;
+  return true;
+}
+
+bool TrendingTask::isCompatible(TTree& trend) const
+{
+  auto hasBranch = [&trend](const char* name, const char* leafList) {
+    auto* branch = trend.GetBranch(name);
+    return branch != nullptr && (leafList == nullptr || std::strcmp(branch->GetTitle(), leafList) == 0);
+  };
+  if (static_cast<size_t>(trend.GetNbranches()) != mReductors.size() + 2 || !hasBranch("meta", "runNumber/I") || !hasBranch("time", nullptr)) {
+    return false;
+  }
+  for (auto& [name, reductor] : mReductors) {
+    if (!hasBranch(name.c_str(), reductor->getBranchLeafList())) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void TrendingTask::backfillTrend(uint64_t until, repository::DatabaseInterface& qcdb)
+{
+  // The entries are in seconds, so we start at the next second to avoid trending the last versions twice.
+  const uint64_t since = (static_cast<uint64_t>(mTime) + 1) * 1000;
+  // One listing per data source gives all the versions to trend, each of them is then retrieved only once.
+  std::map<uint64_t, std::vector<const TrendingTaskConfig::DataSource*>> versions;
+  for (const auto& dataSource : mConfig.dataSources) {
+    std::vector<uint64_t> timestamps;
+    try {
+      timestamps = qcdb.getTimestampsForObject(dataSource.path + "/" + dataSource.name);
+    } catch (const std::exception& ex) {
+      ILOG(Warning, Support) << "Could not list the versions of '" << dataSource.path << "/" << dataSource.name << "', they are not backfilled: " << ex.what() << ENDM;
+      continue;
+    }
+    for (auto it = std::lower_bound(timestamps.begin(), timestamps.end(), since); it != timestamps.end() && *it <= until; ++it) {
+      versions[*it].push_back(&dataSource);
+    }
+  }
+
+  for (const auto& [timestamp, dataSources] : versions) {
+    mTime = timestamp / 1000;
+    mMetaData.runNumber = -1;
+    for (const auto* dataSource : dataSources) {
+      updateReductor(*dataSource, timestamp, qcdb);
+    }
+    mTrend->Fill();
+  }
+  ILOG(Info, Support) << "Backfilled " << versions.size() << " entries of the trend since " << since / 1000 << "." << ENDM;
+}
+
 //todo: see if OptimizeBaskets() indeed helps after some time
 void TrendingTask::update(Trigger t, framework::ServiceRegistry& services)
 {
@@ -73,28 +158,32 @@ void TrendingTask::trendValues(uint64_t timestamp, repository::DatabaseInterface
   //  enough if we trend across runs).
   mMetaData.runNumber = -1;
 
-  for (auto& dataSource : mConfig.dataSources) {
-
-    // todo: make it agnostic to MOs, QOs or other objects. Let the reductor cast to whatever it needs.
-    if (dataSource.type == "repository") {
-      auto mo = qcdb.retrieveMO(dataSource.path, dataSource.name, timestamp);
-      TObject* obj = mo ? mo->getObject() : nullptr;
-      if (obj) {
-        mReductors[dataSource.name]->update(obj);
-      }
-    } else if (dataSource.type == "repository-quality") {
-      auto qo = qcdb.retrieveQO(dataSource.path + "/" + dataSource.name, timestamp);
-      if (qo) {
-        mReductors[dataSource.name]->update(qo.get());
-      }
-    } else {
-      ILOG(Error, Support) << "Unknown type of data source '" << dataSource.type << "'." << ENDM;
-    }
+  for (const auto& dataSource : mConfig.dataSources) {
+    updateReductor(dataSource, timestamp, qcdb);
   }
 
   mTrend->Fill();
 }
 
+void TrendingTask::updateReductor(const TrendingTaskConfig::DataSource& dataSource, uint64_t timestamp, repository::DatabaseInterface& qcdb)
+{
+  // todo: make it agnostic to MOs, QOs or other objects. Let the reductor cast to whatever it needs.
+  if (dataSource.type == "repository") {
+    auto mo = qcdb.retrieveMO(dataSource.path, dataSource.name, timestamp);
+    TObject* obj = mo ? mo->getObject() : nullptr;
+    if (obj) {
+      mReductors[dataSource.name]->update(obj);
+    }
+  } else if (dataSource.type == "repository-quality") {
+    auto qo = qcdb.retrieveQO(dataSource.path + "/" + dataSource.name, timestamp);
+    if (qo) {
+      mReductors[dataSource.name]->update(qo.get());
+    }
+  } else {
+    ILOG(Error, Support) << "Unknown type of data source '" << dataSource.type << "'." << ENDM;
+  }
+}
+
 void TrendingTask::generatePlots()
 {
   if (mTrend->GetEntries() < 1) {
@@ -20,7 +20,8 @@ namespace o2::quality_control::postprocessing
 {
 
 TrendingTaskConfig::TrendingTaskConfig(std::string name, const boost::property_tree::ptree& config)
-  : PostProcessingConfig(name, config)
+  : PostProcessingConfig(name, config),
+    resumeTrend(config.get<bool>("qc.postprocessing." + name + ".resumeTrend", false))
 {
   for (const auto& plotConfig : config.get_child("qc.postprocessing." + name + ".plots")) {
     plots.push_back({ plotConfig.second.get<std::string>("name"),
@@ -25,6 +25,7 @@
 /// Processor where their logs can be seen. The processing will continue until the main window it is closed. Regardless
 /// of glfw being installed or not, in the terminal all the logs will be shown as well.
 
+#include <stdexcept>
 #include <vector>
 #include <Framework/ConfigParamSpec.h>
 
@@ -49,6 +50,16 @@ void customize(std::vector<ConfigParamSpec>& workflowOptions)
     ConfigParamSpec{ "timepipeline", VariantType::Int, 1, { "Timepipeline parameter, i.e. how many copies of each producer. See the DPL documentation for explanation." } });
   workflowOptions.push_back(
     ConfigParamSpec{ "monitoring-url", VariantType::String, "", { "URL of the Monitoring backend." } });
+  workflowOptions.push_back(
+    ConfigParamSpec{ "pool-size", VariantType::Int, 0, { "Number of payloads pre-generated at startup and sent in a loop (0 to generate each message on the fly)." } });
+  workflowOptions.push_back(
+    ConfigParamSpec{ "replay-file", VariantType::String, "", { "Raw data file to be sent in a loop, cut in messages of max-size bytes (use a multiple of the page size)." } });
+  workflowOptions.push_back(
+    ConfigParamSpec{ "rate-profile", VariantType::String, "constant", { "Intervals between messages with pool-size or replay-file: constant, poisson or bursty. Use message-rate 0 for no limit." } });
+  workflowOptions.push_back(
+    ConfigParamSpec{ "burst-size", VariantType::Int, 10, { "Number of messages in a burst, with the bursty rate-profile." } });
+  workflowOptions.push_back(
+    ConfigParamSpec{ "fan-out", VariantType::Int, 1, { "Number of SubSpecs on which each producer publishes, with pool-size or replay-file." } });
 }
 
 #include <Framework/runDataProcessing.h>
@@ -66,10 +77,38 @@ WorkflowSpec defineDataProcessing(const ConfigContext& config)
   size_t producers = config.options().get<int>("producers");
   size_t timepipeline = config.options().get<int>("timepipeline");
   std::string monitoringUrl = config.options().get<std::string>("monitoring-url");
+  size_t poolSize = config.options().get<int>("pool-size");
+  std::string replayFile = config.options().get<std::string>("replay-file");
 
   WorkflowSpec specs;
+  if (poolSize == 0 && replayFile.empty()) {
+    for (size_t i = 0; i < producers; i++) {
+      specs.push_back(getDataProducerSpec(minSize, maxSize, rate, amount, i, monitoringUrl, fill, timepipeline));
+    }
+    return specs;
+  }
+
+  PooledDataProducerConfig pooledConfig;
+  pooledConfig.minSize = minSize;
+  pooledConfig.maxSize = maxSize;
+  pooledConfig.rate = rate;
+  pooledConfig.amount = amount;
+  pooledConfig.burstSize = config.options().get<int>("burst-size");
+  pooledConfig.poolSize = poolSize;
+  pooledConfig.replayFile = replayFile;
+  pooledConfig.fanOut = config.options().get<int>("fan-out");
+  pooledConfig.monitoringUrl = monitoringUrl;
+  auto rateProfile = config.options().get<std::string>("rate-profile");
+  if (rateProfile == "poisson") {
+    pooledConfig.rateProfile = RateProfile::Poisson;
+  } else if (rateProfile == "bursty") {
+    pooledConfig.rateProfile = RateProfile::Bursty;
+  } else if (rateProfile != "constant") {
+    throw std::invalid_argument("rate-profile should be constant, poisson or bursty, not '" + rateProfile + "'");
+  }
+
   for (size_t i = 0; i < producers; i++) {
-    specs.push_back(getDataProducerSpec(minSize, maxSize, rate, amount, i, monitoringUrl, fill, timepipeline));
+    specs.push_back(getPooledDataProducerSpec(pooledConfig, i, timepipeline));
   }
   return specs;
 }
\ No newline at end of file
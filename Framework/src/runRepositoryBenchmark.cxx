@@ -24,6 +24,16 @@ void addCustomOptions(bpo::options_description& options)
                         "Number of objects to try to send to the CCDB every second (default : 1)")(
     "size-objects", bpo::value<uint64_t>()->default_value(1),
     "Size of the objects to send (in kB, 1, 10, 100, 1000, default : 1)")(
+    "object-type", bpo::value<std::string>()->default_value("TH1"),
+    "Type of the objects (\"TH1\" (default), \"TProfile\", \"THnSparse\" or \"TTree\")")(
+    "mode", bpo::value<std::string>()->default_value("store"),
+    "Operation to benchmark (\"store\" (default), \"retrieve\", \"retrieve-json\", \"list\" or \"mixed\")")(
+    "read-fraction", bpo::value<double>()->default_value(0.5),
+    "In mixed mode, fraction of the operations which are reads (default : 0.5)")(
+    "number-threads", bpo::value<uint64_t>()->default_value(1),
+    "Number of threads running the operations concurrently, each on all the objects (default : 1)")(
+    "period-ms", bpo::value<uint64_t>()->default_value(1000),
+    "Minimum duration of an iteration in ms, 0 to run unpaced at maximum throughput (default : 1000)")(
     "max-iterations", bpo::value<uint64_t>()->default_value(3),
     "Maximum number of iterations of Run/ConditionalRun/OnData (0 - infinite, default : 3)")(
     "number-tasks", bpo::value<uint64_t>()->default_value(0),
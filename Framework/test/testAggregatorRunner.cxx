@@ -111,4 +111,37 @@ BOOST_AUTO_TEST_CASE(test_aggregator_quality_filter)
   qoMap["dataSizeCheck2/someNumbersTask/example2"] = make_shared<QualityObject>(Quality::Bad, "dataSizeCheck2/someNumbersTask/example2");
   result = aggregator->aggregate(qoMap);
   BOOST_CHECK_EQUAL(getQualityForCheck(result, "MyAggregatorB/newQuality"), Quality::Medium);
-}
\ No newline at end of file
+}
+
+BOOST_AUTO_TEST_CASE(test_aggregator_quality_view)
+{
+  std::string configFilePath = std::string("json://") + getTestDataDirectory() + "testSharedConfig.json";
+  std::shared_ptr<o2::configuration::ConfigurationInterface> configFile = o2::configuration::ConfigurationFactory::getConfiguration(configFilePath);
+  boost::property_tree::ptree config = configFile->getRecursive("qc.aggregators.MyAggregatorB");
+  auto aggregator = make_shared<Aggregator>("MyAggregatorB", config);
+  aggregator->init();
+
+  // nothing accepted yet -> Good
+  QualityObjectsType result = aggregator->aggregate();
+  BOOST_CHECK_EQUAL(getQualityForCheck(result, "MyAggregatorB/newQuality"), Quality::Good);
+
+  // QOs which are not declared in the sources are refused and do not change the result
+  BOOST_CHECK(!aggregator->update(make_shared<QualityObject>(Quality::Bad, "whatever/q1")));
+  BOOST_CHECK(!aggregator->update(make_shared<QualityObject>(Quality::Bad, "dataSizeCheck2/someNumbersTask/example2")));
+  result = aggregator->aggregate();
+  BOOST_CHECK_EQUAL(getQualityForCheck(result, "MyAggregatorB/newQuality"), Quality::Good);
+
+  BOOST_CHECK(aggregator->update(make_shared<QualityObject>(Quality::Good, "dataSizeCheck1/q1")));
+  BOOST_CHECK(aggregator->update(make_shared<QualityObject>(Quality::Medium, "dataSizeCheck1/q2")));
+  result = aggregator->aggregate();
+  BOOST_CHECK_EQUAL(getQualityForCheck(result, "MyAggregatorB/newQuality"), Quality::Medium);
+
+  // a newer version of a QO replaces the previous one
+  BOOST_CHECK(aggregator->update(make_shared<QualityObject>(Quality::Good, "dataSizeCheck1/q2")));
+  result = aggregator->aggregate();
+  BOOST_CHECK_EQUAL(getQualityForCheck(result, "MyAggregatorB/newQuality"), Quality::Good);
+
+  BOOST_CHECK(aggregator->update(make_shared<QualityObject>(Quality::Bad, "dataSizeCheck2/someNumbersTask/example")));
+  result = aggregator->aggregate();
+  BOOST_CHECK_EQUAL(getQualityForCheck(result, "MyAggregatorB/newQuality"), Quality::Bad);
+}
@@ -0,0 +1,98 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file    testBitCounter.cxx
+///
+
+#include "QualityControl/BitCounter.h"
+#include <TH1I.h>
+#include <TH2I.h>
+
+#define BOOST_TEST_MODULE BitCounter test
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+
+#include <boost/test/unit_test.hpp>
+
+using namespace o2::quality_control::core;
+
+BOOST_AUTO_TEST_CASE(test_count)
+{
+  BitCounter counter(10, 13);
+  BOOST_CHECK_EQUAL(counter.getNumberOfChannels(), 10);
+  BOOST_CHECK_EQUAL(counter.getNumberOfBits(), 13);
+
+  counter.count(3, 0b1000000000101);
+  counter.count(3, 0b0000000000100);
+  counter.count(9, 0b1000000000000);
+  // the bits beyond the 13th and the channels out of range are ignored
+  counter.count(9, uint64_t(1) << 13);
+  counter.count(10, 0b1);
+
+  BOOST_CHECK_EQUAL(counter.get(3, 0), 1);
+  BOOST_CHECK_EQUAL(counter.get(3, 1), 0);
+  BOOST_CHECK_EQUAL(counter.get(3, 2), 2);
+  BOOST_CHECK_EQUAL(counter.get(3, 12), 1);
+  BOOST_CHECK_EQUAL(counter.get(9, 12), 1);
+  BOOST_CHECK_EQUAL(counter.getTotal(12), 2);
+  BOOST_CHECK_EQUAL(counter.getEntries(), 5);
+
+  BitCounter other(10, 13);
+  other.count(0, 0b11);
+  counter.add(other);
+  BOOST_CHECK_EQUAL(counter.get(0, 1), 1);
+  BOOST_CHECK_EQUAL(counter.getEntries(), 7);
+  BOOST_CHECK_THROW(counter.add(BitCounter(10, 12)), std::invalid_argument);
+
+  counter.clear();
+  BOOST_CHECK_EQUAL(counter.getEntries(), 0);
+  BOOST_CHECK_EQUAL(counter.get(3, 2), 0);
+
+  BitCounter wide(1, 64);
+  wide.count(0, ~uint64_t(0));
+  BOOST_CHECK_EQUAL(wide.getEntries(), 64);
+  BOOST_CHECK_EQUAL(wide.get(0, 63), 1);
+  BOOST_CHECK_THROW(BitCounter(1, 65), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(test_transfer)
+{
+  TH2I perFee("perFee", "perFee", 10, 0, 10, 13, 0.5, 13.5);
+  TH1I triggers("triggers", "triggers", 13, 0.5, 13.5);
+  // the histograms are filled the same way, bit by bit
+  TH2I expectedPerFee("expectedPerFee", "expectedPerFee", 10, 0, 10, 13, 0.5, 13.5);
+  TH1I expectedTriggers("expectedTriggers", "expectedTriggers", 13, 0.5, 13.5);
+
+  BitCounter counter(10, 13);
+  for (int cycle = 0; cycle < 2; cycle++) {
+    for (uint64_t word = 0; word < 200; word++) {
+      const size_t fee = word % 10;
+      counter.count(fee, word * 37);
+      for (int bit = 0; bit < 13; bit++) {
+        if ((word * 37) >> bit & 1) {
+          expectedPerFee.Fill(fee, bit + 1);
+          expectedTriggers.Fill(bit + 1);
+        }
+      }
+    }
+    counter.transfer(&perFee, &triggers);
+    BOOST_CHECK_EQUAL(counter.getEntries(), 0);
+
+    for (int bin = 0; bin < expectedPerFee.GetNcells(); bin++) {
+      BOOST_CHECK_EQUAL(perFee.GetBinContent(bin), expectedPerFee.GetBinContent(bin));
+    }
+    for (int bin = 0; bin < expectedTriggers.GetNcells(); bin++) {
+      BOOST_CHECK_EQUAL(triggers.GetBinContent(bin), expectedTriggers.GetBinContent(bin));
+    }
+    BOOST_CHECK_EQUAL(perFee.GetEntries(), expectedPerFee.GetEntries());
+    BOOST_CHECK_EQUAL(triggers.GetEntries(), expectedTriggers.GetEntries());
+  }
+}
@@ -33,3 +33,30 @@ BOOST_AUTO_TEST_CASE(test_check_runner_static)
   BOOST_CHECK(CheckRunner::createCheckRunnerDataDescription("012345678901234567890") == DataDescription("012345678901-chk"));
   BOOST_CHECK_THROW(CheckRunner::createCheckRunnerDataDescription(""), AliceO2::Common::FatalException);
 }
+
+BOOST_AUTO_TEST_CASE(test_check_runner_qo_paths)
+{
+  std::unordered_set<std::string> names;
+  std::vector<std::string> paths;
+  using o2::quality_control::core::Quality;
+  using o2::quality_control::core::QualityObject;
+
+  // OnEachSeparately makes one QO per MO, all with the same check name
+  o2::quality_control::core::QualityObjectsType qualityObjects{
+    std::make_shared<QualityObject>(Quality::Good, "check", "TST", "OnEachSeparately", std::vector<std::string>{}, std::vector<std::string>{ "mo1" }),
+    std::make_shared<QualityObject>(Quality::Good, "check", "TST", "OnEachSeparately", std::vector<std::string>{}, std::vector<std::string>{ "mo2" })
+  };
+  BOOST_CHECK(CheckRunner::addQualityObjectPaths(qualityObjects, names, paths));
+  BOOST_REQUIRE_EQUAL(paths.size(), 2);
+  BOOST_CHECK_EQUAL(paths[0], "qc/TST/QO/check/mo1");
+  BOOST_CHECK_EQUAL(paths[1], "qc/TST/QO/check/mo2");
+
+  // the QOs already seen are not added again
+  BOOST_CHECK(!CheckRunner::addQualityObjectPaths(qualityObjects, names, paths));
+  BOOST_CHECK_EQUAL(paths.size(), 2);
+
+  qualityObjects.push_back(std::make_shared<QualityObject>(Quality::Bad, "otherCheck", "TST"));
+  BOOST_CHECK(CheckRunner::addQualityObjectPaths(qualityObjects, names, paths));
+  BOOST_REQUIRE_EQUAL(paths.size(), 3);
+  BOOST_CHECK_EQUAL(paths[2], "qc/TST/QO/otherCheck");
+}
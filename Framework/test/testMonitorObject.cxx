@@ -14,6 +14,10 @@
 ///
 
 #include "QualityControl/MonitorObject.h"
+#include "QualityControl/MonitorObjectCollection.h"
+#include "QualityControl/MonitorObjectTable.h"
+#include "QualityControl/HistogramCodec.h"
+#include "QualityControl/OccupancyMap.h"
 #include "QualityControl/QcInfoLogger.h"
 
 #define BOOST_TEST_MODULE MO test
@@ -22,6 +26,9 @@
 #include <boost/test/unit_test.hpp>
 #include <chrono>
 #include <TH1F.h>
+#include <TH2D.h>
+#include <TH2I.h>
+#include <TProfile.h>
 #include <TFile.h>
 #include <TSystem.h>
 
@@ -127,4 +134,162 @@ BOOST_AUTO_TEST_CASE(path)
   BOOST_CHECK_EQUAL(path, "qc/DET/MO/task/asdf");
 }
 
+BOOST_AUTO_TEST_CASE(mo_table)
+{
+  MonitorObjectCollection collection;
+  collection.SetOwner(true);
+  auto* h1 = new TH1F("h1", "h1", 10, 0, 10);
+  h1->Fill(3);
+  collection.Add(new MonitorObject(h1, "task", "TST"));
+  collection.Add(new MonitorObject(new TH1F("h2", "h2", 20, 0, 10), "task", "TST"));
+
+  MonitorObjectTable table;
+  table.write(collection);
+  // written twice to make sure that the buffer is rewritten and not appended to
+  table.write(collection);
+  const auto& buffer = table.getBuffer();
+
+  MonitorObjectTable::View view(buffer.data(), buffer.size());
+  BOOST_REQUIRE_EQUAL(view.size(), 2);
+  BOOST_CHECK_EQUAL(view.getName(0), "task/h1");
+  BOOST_CHECK_EQUAL(view.getName(1), "task/h2");
+  auto mo = view.materialize(0);
+  BOOST_REQUIRE(mo != nullptr);
+  BOOST_CHECK_EQUAL(mo->getFullName(), "task/h1");
+  BOOST_CHECK_EQUAL(mo->getDetectorName(), "TST");
+  auto* h = dynamic_cast<TH1F*>(mo->getObject());
+  BOOST_REQUIRE(h != nullptr);
+  BOOST_CHECK_EQUAL(h->GetEntries(), 1);
+  BOOST_CHECK(view.getTrace().empty());
+
+  TraceStamps trace{ { Tracer::CycleKey, 3 }, { "Publish", 1234567890123 } };
+  table.write(collection, trace);
+  MonitorObjectTable::View tracedView(table.getBuffer().data(), table.getBuffer().size());
+  BOOST_CHECK_EQUAL(tracedView.size(), 2);
+  BOOST_CHECK(tracedView.getTrace() == trace);
+
+  BOOST_CHECK_THROW(MonitorObjectTable::View(buffer.data(), buffer.size() / 2), std::runtime_error);
+  std::vector<char> garbage(64, 'x');
+  BOOST_CHECK_THROW(MonitorObjectTable::View(garbage.data(), garbage.size()), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(histogram_codec)
+{
+  TH1F h1("h1", "title;x;counts", 100, 0, 100);
+  h1.Sumw2();
+  h1.Fill(3, 2.5);
+  h1.Fill(42);
+  h1.SetLineColor(kRed);
+  h1.GetXaxis()->SetRange(2, 50);
+  std::vector<char> buffer;
+  HistogramCodec::encode(h1, buffer);
+  auto decoded = HistogramCodec::decode(buffer.data(), buffer.size());
+  BOOST_REQUIRE(dynamic_cast<TH1F*>(decoded.get()) != nullptr);
+  BOOST_CHECK(decoded->GetDirectory() == nullptr);
+  BOOST_CHECK_EQUAL(decoded->GetName(), "h1");
+  BOOST_CHECK_EQUAL(decoded->GetXaxis()->GetTitle(), "x");
+  BOOST_CHECK_EQUAL(decoded->GetEntries(), 2);
+  BOOST_CHECK_EQUAL(decoded->GetBinContent(4), 2.5);
+  BOOST_CHECK_CLOSE(decoded->GetBinError(4), 2.5, 1e-6);
+  BOOST_CHECK_CLOSE(decoded->GetMean(), h1.GetMean(), 1e-6);
+  BOOST_CHECK_EQUAL(decoded->GetLineColor(), kRed);
+  BOOST_CHECK_EQUAL(decoded->GetXaxis()->GetLast(), 50);
+
+  // a sparse occupancy map with variable bins is much smaller than its raw contents
+  double edges[] = { 0, 1, 2, 4, 8, 16 };
+  TH2D h2("h2", "h2", 1000, 0, 1000, 5, edges);
+  h2.Fill(500, 3);
+  h2.Fill(999, 10, 4);
+  buffer.clear();
+  HistogramCodec::encode(h2, buffer);
+  BOOST_CHECK_LT(buffer.size(), 1000u);
+  auto decoded2 = HistogramCodec::decode(buffer.data(), buffer.size());
+  BOOST_REQUIRE(dynamic_cast<TH2D*>(decoded2.get()) != nullptr);
+  BOOST_CHECK_EQUAL(decoded2->GetNcells(), h2.GetNcells());
+  BOOST_CHECK_EQUAL(decoded2->GetBinContent(decoded2->FindBin(999, 10)), 4);
+  BOOST_CHECK_EQUAL(decoded2->GetSumOfWeights(), h2.GetSumOfWeights());
+  BOOST_CHECK_EQUAL(decoded2->GetYaxis()->GetBinUpEdge(5), 16);
+
+  BOOST_CHECK_THROW(HistogramCodec::decode(buffer.data(), buffer.size() / 2), std::runtime_error);
+
+  // the other classes and the histograms with labels are left to the ROOT streamers
+  TProfile profile("p", "p", 10, 0, 10);
+  BOOST_CHECK(!HistogramCodec::canEncode(&profile));
+  h1.GetXaxis()->SetBinLabel(1, "label");
+  BOOST_CHECK(!HistogramCodec::canEncode(&h1));
+  BOOST_CHECK(HistogramCodec::canEncode(&h2));
+
+  MonitorObjectCollection collection;
+  collection.SetOwner(true);
+  collection.Add(new MonitorObject(h2.Clone(), "task", "TST"));
+  collection.Add(new MonitorObject(profile.Clone(), "task", "TST"));
+  MonitorObjectTable table(true);
+  table.write(collection);
+  MonitorObjectTable::View view(table.getBuffer().data(), table.getBuffer().size());
+  auto mo = view.materialize(0);
+  BOOST_REQUIRE(mo != nullptr);
+  BOOST_CHECK_EQUAL(mo->getFullName(), "task/h2");
+  BOOST_CHECK_EQUAL(dynamic_cast<TH2D*>(mo->getObject())->GetEntries(), 2);
+  BOOST_CHECK(dynamic_cast<TProfile*>(view.materialize(1)->getObject()) != nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(occupancy_map)
+{
+  auto* map = new OccupancyMap("hitmap", "hitmap", 1024, 512);
+  map->fill(3, 4);
+  map->fill(3, 4);
+  map->fill(1023, 511, 5);
+  map->fill(1024, 0); // outside, ignored
+  // enough hits in the first rows for their container to become dense
+  for (unsigned int column = 0; column < 1024; column++) {
+    for (unsigned int row = 10; row < 15; row++) {
+      map->fill(column, row);
+    }
+  }
+  BOOST_CHECK_EQUAL(map->getHits(3, 4), 2);
+  BOOST_CHECK_EQUAL(map->getHits(1023, 511), 5);
+  BOOST_CHECK_EQUAL(map->getHits(0, 0), 0);
+  BOOST_CHECK_EQUAL(map->getHits(7, 12), 1);
+  BOOST_CHECK_EQUAL(map->getEntries(), 7 + 5 * 1024);
+  BOOST_CHECK_EQUAL(map->getNumberOfFiredPixels(), 2 + 5 * 1024);
+
+  auto* other = new OccupancyMap("hitmap", "hitmap", 1024, 512);
+  other->fill(3, 4);
+  other->fill(100, 300, 2);
+  MonitorObjectCollection collection;
+  collection.SetOwner(true);
+  collection.Add(new MonitorObject(map, "task", "TST"));
+  MonitorObjectCollection otherCollection;
+  otherCollection.SetOwner(true);
+  otherCollection.Add(new MonitorObject(other, "task", "TST"));
+  collection.merge(&otherCollection);
+  BOOST_CHECK_EQUAL(map->getHits(3, 4), 3);
+  BOOST_CHECK_EQUAL(map->getHits(100, 300), 2);
+  BOOST_CHECK_EQUAL(map->getEntries(), 10 + 5 * 1024);
+
+  size_t fired = 0;
+  map->forEachFiredPixel([&](unsigned int column, unsigned int row, uint32_t hits) {
+    BOOST_CHECK_EQUAL(map->getHits(column, row), hits);
+    fired++;
+  });
+  BOOST_CHECK_EQUAL(fired, map->getNumberOfFiredPixels());
+
+  auto histogram = map->toHistogram();
+  BOOST_CHECK_EQUAL(histogram->GetNbinsX(), 1024);
+  BOOST_CHECK_EQUAL(histogram->GetBinContent(histogram->FindBin(1023, 511)), 5);
+  BOOST_CHECK_EQUAL(histogram->GetEntries(), map->getEntries());
+  BOOST_CHECK_CLOSE(histogram->GetMean(1), map->getMean(1), 1e-6);
+  BOOST_CHECK(!histogram->TestBit(TH1::kNoStats));
+  map->setStats(false);
+  BOOST_CHECK(map->toHistogram()->TestBit(TH1::kNoStats));
+
+  OccupancyMap small("small", "small", 10, 10);
+  BOOST_CHECK_THROW(map->merge(&small), std::runtime_error);
+
+  map->reset();
+  BOOST_CHECK_EQUAL(map->getEntries(), 0);
+  BOOST_CHECK_EQUAL(map->getNumberOfFiredPixels(), 0);
+  BOOST_CHECK_EQUAL(map->getHits(3, 4), 0);
+}
+
 } // namespace o2::quality_control::core
@@ -149,4 +149,24 @@ BOOST_AUTO_TEST_CASE(drawOptions_test)
   BOOST_CHECK_EQUAL(objectsManager.getMonitorObject("histo")->getMetadataMap().at(ObjectsManager::gDisplayHintsKey), "gridy logy");
 }
 
+BOOST_AUTO_TEST_CASE(renderer_test)
+{
+  TaskConfig config;
+  config.taskName = "test";
+  config.consulUrl = "http://consul-test.cern.ch:8500";
+  ObjectsManager objectsManager(config.taskName, config.detectorName, config.consulUrl, 0, true);
+
+  TH1F h("histo", "h", 100, 0, 99);
+  objectsManager.startPublishing(&h);
+  std::string calls;
+  objectsManager.registerRenderer([&]() { calls += "a"; h.Fill(1); });
+  objectsManager.registerRenderer([&]() { calls += "b"; });
+  BOOST_CHECK_EQUAL(calls, "");
+
+  objectsManager.render();
+  objectsManager.render();
+  BOOST_CHECK_EQUAL(calls, "abab");
+  BOOST_CHECK_EQUAL(h.GetEntries(), 2);
+}
+
 } // namespace o2::quality_control::core
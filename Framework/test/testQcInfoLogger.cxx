@@ -14,6 +14,7 @@
 ///
 
 #include "QualityControl/QcInfoLogger.h"
+#include "QualityControl/AsyncLogSink.h"
 
 #define BOOST_TEST_MODULE InfoLogger test
 #define BOOST_TEST_MAIN
@@ -81,4 +82,30 @@ BOOST_AUTO_TEST_CASE(qc_info_logger_fields)
   ILOG(Info, Support) << "Facility Test set, facility=Test, system=QC, detector=ITS" << ENDM;
 }
 
+BOOST_AUTO_TEST_CASE(qc_info_logger_discarded)
+{
+  int evaluated = 0;
+  auto count = [&evaluated]() { return ++evaluated; };
+
+  ILOG_INST.init("test", true, 21);
+  ILOG(Debug, Devel) << "discarded debug message " << count() << ENDM;
+  ILOG(Info, Trace) << "discarded trace message " << count() << ENDM;
+  BOOST_CHECK_EQUAL(evaluated, 0);
+  ILOG(Info, Devel) << "info message for devel " << count() << ENDM;
+  BOOST_CHECK_EQUAL(evaluated, 1);
+
+  for (int i = 0; i < 5; i++) {
+    ILOG_THROTTLED(10, Info, Support) << "throttled message " << count() << ENDM;
+  }
+  BOOST_CHECK_EQUAL(evaluated, 2);
+
+  ILOG_ASYNC(Info, Support) << "asynchronous message " << count() << ENDM;
+  ILOG_ASYNC(Debug, Devel) << "discarded asynchronous message " << count() << ENDM;
+  AsyncLogSink::GetInstance().flush();
+  BOOST_CHECK_EQUAL(evaluated, 3);
+  BOOST_CHECK_EQUAL(AsyncLogSink::GetInstance().getNumberDropped(), 0);
+
+  ILOG_INST.init("test", false, 100);
+}
+
 } // namespace o2::quality_control::core
@@ -18,6 +18,8 @@
 #include "QualityControl/testUtils.h"
 
 #include <DataFormatsQualityControl/FlagReasons.h>
+#include <boost/property_tree/json_parser.hpp>
+#include <cstdio>
 
 #define BOOST_TEST_MODULE QualityObject test
 #define BOOST_TEST_MAIN
@@ -145,4 +147,47 @@ BOOST_AUTO_TEST_CASE(qo_reasons)
   BOOST_CHECK_EQUAL(reasons3[1].second, "exception in y");
   BOOST_CHECK_EQUAL(reasons3[2].first, FlagReasonFactory::LimitedAcceptance());
   BOOST_CHECK_EQUAL(reasons3[2].second, "sector C off");
-}
\ No newline at end of file
+}
+
+BOOST_AUTO_TEST_CASE(quality_object_trace)
+{
+  TraceStamps trace{ { Tracer::CycleKey, 3 }, { "start_of_cycle", 1000 }, { "publish", 1500 } };
+  Tracer::stamp(trace, Tracer::Stage::Check);
+  BOOST_CHECK_GT(Tracer::getStamp(trace, Tracer::Stage::Check), 1500);
+  BOOST_CHECK_EQUAL(Tracer::getStamp(trace, Tracer::Stage::Merge), 0);
+  BOOST_CHECK_EQUAL(Tracer::getLastStamp(trace), Tracer::getStamp(trace, Tracer::Stage::Check));
+
+  QualityObject qo(Quality::Good, "xyzCheck");
+  BOOST_CHECK(qo.getTrace().empty());
+  qo.setTrace(trace);
+  auto copy = qo;
+  BOOST_CHECK(copy.getTrace() == trace);
+
+  std::string path = "/tmp/qc-trace-testQualityObject.json";
+  {
+    Tracer tracer;
+    BOOST_CHECK(!tracer.isEnabled());
+    tracer.init("/tmp", "testQualityObject");
+    BOOST_REQUIRE(tracer.isEnabled());
+    // the merge was not stamped, the check span starts at the publication
+    tracer.exportSpans(qo.getTrace(), qo.getName(), { Tracer::Stage::Publish, Tracer::Stage::Merge, Tracer::Stage::Check });
+  }
+  boost::property_tree::ptree events;
+  boost::property_tree::read_json(path, events);
+  std::remove(path.c_str());
+
+  std::vector<boost::property_tree::ptree> spans;
+  for (const auto& [key, event] : events) {
+    if (event.get<std::string>("ph") == "X") {
+      spans.push_back(event);
+    }
+  }
+  BOOST_REQUIRE_EQUAL(spans.size(), 2);
+  BOOST_CHECK_EQUAL(spans[0].get<std::string>("name"), "publish");
+  BOOST_CHECK_EQUAL(spans[0].get<uint64_t>("ts"), 1000);
+  BOOST_CHECK_EQUAL(spans[0].get<uint64_t>("dur"), 500);
+  BOOST_CHECK_EQUAL(spans[1].get<std::string>("name"), "check");
+  BOOST_CHECK_EQUAL(spans[1].get<uint64_t>("ts"), 1500);
+  BOOST_CHECK_EQUAL(spans[1].get<int>("args.cycle"), 3);
+  BOOST_CHECK_EQUAL(spans[1].get<std::string>("args.object"), "xyzCheck");
+}
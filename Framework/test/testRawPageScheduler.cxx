@@ -0,0 +1,154 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file    testRawPageScheduler.cxx
+///
+
+#include "QualityControl/RawPageScheduler.h"
+#include <Headers/RAWDataHeader.h>
+
+#define BOOST_TEST_MODULE RawPageScheduler test
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+
+#include <boost/test/unit_test.hpp>
+#include <algorithm>
+
+using namespace o2::quality_control::core;
+using RDH = o2::header::RAWDataHeaderV6;
+
+namespace
+{
+/// Pages of nLinks links, page i belongs to the link i % nLinks and the payload sizes grow with the link number
+struct FakeInputs {
+  FakeInputs(size_t nPages, uint16_t nLinks) : rdhs(nPages)
+  {
+    dataHeader.subSpecification = 7;
+    for (size_t i = 0; i < nPages; i++) {
+      rdhs[i].feeId = 0x100 + i % nLinks;
+      rdhs[i].linkID = i % nLinks;
+      RawPage page;
+      page.rdh = reinterpret_cast<const o2::header::RDHAny*>(&rdhs[i]);
+      page.payloadSize = 10 * (i % nLinks + 1);
+      page.dataHeader = &dataHeader;
+      page.index = i;
+      pages.push_back(page);
+    }
+  }
+
+  void addTo(RawPageScheduler& scheduler) const
+  {
+    scheduler.clear();
+    for (const auto& page : pages) {
+      scheduler.addPage(page);
+    }
+  }
+
+  o2::header::DataHeader dataHeader;
+  std::vector<RDH> rdhs;
+  std::vector<RawPage> pages;
+};
+
+struct WorkerState {
+  std::vector<size_t> processedPages;
+};
+} // namespace
+
+BOOST_AUTO_TEST_CASE(test_split)
+{
+  FakeInputs inputs(100, 4);
+  RawPageScheduler scheduler;
+  inputs.addTo(scheduler);
+
+  BOOST_CHECK_EQUAL(scheduler.getNumberOfPages(), 100);
+  auto units = scheduler.getWorkUnits();
+  BOOST_REQUIRE_EQUAL(units.size(), 4);
+  for (size_t i = 0; i < units.size(); i++) {
+    const uint8_t link = 3 - i; // the largest first
+    BOOST_CHECK_EQUAL(units[i]->linkId, link);
+    BOOST_CHECK_EQUAL(units[i]->feeId, 0x100 + link);
+    BOOST_CHECK_EQUAL(units[i]->size, 25 * 10 * (link + 1));
+    BOOST_REQUIRE_EQUAL(units[i]->pages.size(), 25);
+    for (size_t page = 0; page < 25; page++) {
+      BOOST_CHECK_EQUAL(units[i]->pages[page].index, page * 4 + link);
+    }
+  }
+
+  // the pages of the previous inputs are removed
+  FakeInputs otherInputs(10, 2);
+  otherInputs.addTo(scheduler);
+  BOOST_CHECK_EQUAL(scheduler.getNumberOfPages(), 10);
+  BOOST_CHECK_EQUAL(scheduler.getWorkUnits().size(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(test_process)
+{
+  FakeInputs inputs(1000, 16);
+  RawPageScheduler scheduler(4);
+  BOOST_CHECK_EQUAL(scheduler.getNumberOfWorkers(), 4);
+
+  std::vector<WorkerState> states(scheduler.getNumberOfWorkers());
+  for (int repetition = 0; repetition < 3; repetition++) {
+    inputs.addTo(scheduler);
+    scheduler.process(states, [](WorkerState& state, const RawPage& page) {
+      state.processedPages.push_back(page.index);
+    });
+
+    // each page is processed once, the pages of a link in order by the same worker
+    std::vector<int> timesProcessed(1000, 0);
+    std::vector<int> workerOfLink(16, -1);
+    for (size_t worker = 0; worker < states.size(); worker++) {
+      std::vector<size_t> lastPageOfLink(16, 0);
+      for (auto index : states[worker].processedPages) {
+        timesProcessed[index]++;
+        auto link = index % 16;
+        BOOST_CHECK(workerOfLink[link] == -1 || workerOfLink[link] == int(worker));
+        workerOfLink[link] = worker;
+        BOOST_CHECK(index >= lastPageOfLink[link]);
+        lastPageOfLink[link] = index;
+      }
+      states[worker].processedPages.clear();
+    }
+    BOOST_CHECK(std::all_of(timesProcessed.begin(), timesProcessed.end(), [](int times) { return times == 1; }));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(test_errors)
+{
+  FakeInputs inputs(100, 8);
+  RawPageScheduler scheduler(3);
+  inputs.addTo(scheduler);
+
+  std::vector<WorkerState> tooFewStates(2);
+  auto noop = [](WorkerState&, const RawPage&) {};
+  BOOST_CHECK_THROW(scheduler.process(tooFewStates, noop), std::invalid_argument);
+
+  std::vector<WorkerState> states(3);
+  BOOST_CHECK_THROW(scheduler.process(states, [](WorkerState&, const RawPage& page) {
+    if (page.index == 42) {
+      throw std::runtime_error("corrupted page");
+    }
+  }),
+                    std::runtime_error);
+
+  // the workers are still available after an exception
+  for (auto& state : states) {
+    state.processedPages.clear();
+  }
+  scheduler.process(states, [](WorkerState& state, const RawPage& page) {
+    state.processedPages.push_back(page.index);
+  });
+  size_t processed = 0;
+  for (const auto& state : states) {
+    processed += state.processedPages.size();
+  }
+  BOOST_CHECK_EQUAL(processed, 100);
+}
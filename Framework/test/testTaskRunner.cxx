@@ -16,6 +16,7 @@
 #include "getTestDataDirectory.h"
 #include "QualityControl/TaskRunnerFactory.h"
 #include "QualityControl/TaskRunner.h"
+#include "QualityControl/CycleDurationController.h"
 #include <Framework/DataSpecUtils.h>
 #include <DataSampling/DataSampling.h>
 
@@ -97,4 +98,31 @@ BOOST_AUTO_TEST_CASE(test_task_good_detector_name)
 
   TaskRunner qcTask{ "xyzTask", configFilePath, 0 };
   //  cout << "no error message" << endl;
-}
\ No newline at end of file
+}
+
+BOOST_AUTO_TEST_CASE(test_cycle_duration_controller)
+{
+  CycleDurationController controller(10, 2, 60, 0.05);
+  BOOST_CHECK_EQUAL(controller.getCycleDuration(), 10);
+
+  // a cheap publication lets the cycles shrink, by a factor 2 at most each time, down to the minimum
+  controller.update(0.01);
+  BOOST_CHECK_EQUAL(controller.getCycleDuration(), 5);
+  for (int i = 0; i < 10; i++) {
+    controller.update(0.01);
+  }
+  BOOST_CHECK_EQUAL(controller.getCycleDuration(), 2);
+
+  // an expensive one makes them longer, up to the maximum
+  for (int i = 0; i < 20; i++) {
+    controller.update(1);
+  }
+  BOOST_CHECK_CLOSE(controller.getCycleDuration(), 19, 1); // 1 s out of 20 s is 5%
+  for (int i = 0; i < 20; i++) {
+    controller.update(10);
+  }
+  BOOST_CHECK_EQUAL(controller.getCycleDuration(), 60);
+
+  // the first cycle is within the bounds too
+  BOOST_CHECK_EQUAL(CycleDurationController(100, 2, 60, 0.05).getCycleDuration(), 60);
+}
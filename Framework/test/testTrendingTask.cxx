@@ -16,12 +16,18 @@
 #include "getTestDataDirectory.h"
 #include "QualityControl/TrendingTask.h"
 #include "QualityControl/DatabaseFactory.h"
+#include "QualityControl/DummyDatabase.h"
+#include "QualityControl/ObjectsManager.h"
 #include "QualityControl/MonitorObject.h"
 #include "QualityControl/Triggers.h"
 #include <Framework/ServiceRegistry.h>
 
 #include <Configuration/ConfigurationFactory.h>
+#include <boost/property_tree/json_parser.hpp>
 #include <TH1I.h>
+#include <TTree.h>
+#include <map>
+#include <sstream>
 
 #define BOOST_TEST_MODULE TrendingTask test
 #define BOOST_TEST_MAIN
@@ -107,4 +113,187 @@ BOOST_AUTO_TEST_CASE(test_task)
       BOOST_CHECK_CLOSE(qualityLevels[i], 3, 0.01);
     }
   }
-}
\ No newline at end of file
+}
+
+namespace
+{
+/// Keeps all the versions of the objects in memory, as the CCDB does.
+class MemoryDatabase : public DummyDatabase
+{
+ public:
+  void storeMO(std::shared_ptr<const MonitorObject> mo, long from, long) override
+  {
+    mObjects[mo->getPath()][from].reset(mo->Clone());
+  }
+  std::shared_ptr<MonitorObject> retrieveMO(std::string taskName, std::string objectName, long timestamp) override
+  {
+    auto* object = find(taskName + "/" + objectName, timestamp);
+    return std::shared_ptr<MonitorObject>(object ? dynamic_cast<MonitorObject*>(object->Clone()) : nullptr);
+  }
+  void storeQO(std::shared_ptr<const QualityObject> qo, long from, long) override
+  {
+    mObjects[qo->getPath()][from].reset(qo->Clone());
+  }
+  std::shared_ptr<QualityObject> retrieveQO(std::string qoPath, long timestamp) override
+  {
+    auto* object = find(qoPath, timestamp);
+    return std::shared_ptr<QualityObject>(object ? dynamic_cast<QualityObject*>(object->Clone()) : nullptr);
+  }
+  std::vector<uint64_t> getTimestampsForObject(std::string path) override
+  {
+    std::vector<uint64_t> timestamps;
+    for (const auto& version : mObjects[path]) {
+      timestamps.push_back(version.first);
+    }
+    return timestamps;
+  }
+
+  size_t getRetrievals(const std::string& path) { return mRetrievals[path]; }
+  void clearRetrievals() { mRetrievals.clear(); }
+
+ private:
+  TObject* find(const std::string& path, long timestamp)
+  {
+    mRetrievals[path]++;
+    auto& versions = mObjects[path];
+    auto version = timestamp < 0 ? versions.end() : versions.upper_bound(timestamp);
+    return version == versions.begin() ? nullptr : std::prev(version)->second.get();
+  }
+
+  std::map<std::string, std::map<uint64_t, std::unique_ptr<TObject>>> mObjects;
+  std::map<std::string, size_t> mRetrievals;
+};
+} // namespace
+
+BOOST_AUTO_TEST_CASE(test_task_resume)
+{
+  const std::string taskName = "TestTrendingTaskResume";
+  std::stringstream configJson(R"json({
+    "qc": {
+      "config": { "database": { "implementation": "Dummy" } },
+      "postprocessing": {
+        "TestTrendingTaskResume": {
+          "className": "o2::quality_control::postprocessing::TrendingTask",
+          "moduleName": "QualityControl",
+          "detectorName": "TST",
+          "resumeTrend": "true",
+          "dataSources": [
+            {
+              "type": "repository",
+              "path": "qc/TST/MO/TrendedTask",
+              "name": "histo",
+              "reductorName": "o2::quality_control_modules::common::TH1Reductor",
+              "moduleName": "QcCommon"
+            },
+            {
+              "type": "repository-quality",
+              "path": "qc/TST/QO",
+              "name": "check",
+              "reductorName": "o2::quality_control_modules::common::QualityReductor",
+              "moduleName": "QcCommon"
+            }
+          ],
+          "plots": [],
+          "initTrigger": [],
+          "updateTrigger": [],
+          "stopTrigger": []
+        }
+      }
+    }
+  })json");
+  boost::property_tree::ptree config;
+  boost::property_tree::read_json(configJson, config);
+
+  MemoryDatabase qcdb;
+  ServiceRegistry services;
+  services.registerService<DatabaseInterface>(&qcdb);
+
+  auto storeHisto = [&qcdb](int entries, long timestamp) {
+    auto* histo = new TH1I("histo", "histo", 10, 0, 10.0);
+    for (int i = 0; i < entries; i++) {
+      histo->Fill(5);
+    }
+    qcdb.storeMO(std::make_shared<MonitorObject>(histo, "TrendedTask", "TST"), timestamp, -1);
+  };
+  storeHisto(3, 1000000);
+  qcdb.storeQO(std::make_shared<QualityObject>(Quality::Bad, "check", "TST"), 1000000, -1);
+
+  // There is no trend to resume yet, a new one is started and stored in the end
+  {
+    auto objectsManager = std::make_shared<ObjectsManager>(taskName, "TST", "", 0, true);
+    TrendingTask task;
+    task.setName(taskName);
+    task.setObjectsManager(objectsManager);
+    task.configure(taskName, config);
+    task.initialize({ TriggerType::Once, 1000500 }, services);
+    for (uint64_t timestamp : { 1001000, 1002000, 1003000 }) {
+      task.update({ TriggerType::Always, timestamp }, services);
+    }
+    task.finalize({ TriggerType::UserOrControl, 1003500 }, services);
+
+    // stored as the PostProcessingRunner does it
+    auto* trendMO = objectsManager->getMonitorObject(taskName);
+    BOOST_REQUIRE(trendMO != nullptr);
+    qcdb.storeMO(std::shared_ptr<MonitorObject>(dynamic_cast<MonitorObject*>(trendMO->Clone())), 1003500, -1);
+  }
+
+  // New versions of the histogram are stored while the task is not running
+  storeHisto(4, 1005000);
+  storeHisto(5, 1007000);
+  storeHisto(6, 1020000); // after the restart
+  qcdb.clearRetrievals();
+
+  // The trend is resumed and the versions stored in between are backfilled
+  {
+    auto objectsManager = std::make_shared<ObjectsManager>(taskName, "TST", "", 0, true);
+    TrendingTask task;
+    task.setName(taskName);
+    task.setObjectsManager(objectsManager);
+    task.configure(taskName, config);
+    task.initialize({ TriggerType::Once, 1010000 }, services);
+
+    auto* trendMO = objectsManager->getMonitorObject(taskName);
+    BOOST_REQUIRE(trendMO != nullptr);
+    auto* trend = dynamic_cast<TTree*>(trendMO->getObject());
+    BOOST_REQUIRE(trend != nullptr);
+    BOOST_CHECK_EQUAL(trend->GetEntries(), 5);
+    // each new version is retrieved once, the quality which did not change is not retrieved at all
+    BOOST_CHECK_EQUAL(qcdb.getRetrievals("qc/TST/MO/TrendedTask/histo"), 2);
+    BOOST_CHECK_EQUAL(qcdb.getRetrievals("qc/TST/QO/check"), 0);
+
+    task.update({ TriggerType::Always, 1011000 }, services);
+    task.finalize({ TriggerType::UserOrControl, 1011500 }, services);
+
+    BOOST_REQUIRE_EQUAL(trend->GetEntries(), 6);
+    trend->Draw("time:histo.entries:check.level", "", "goff");
+    const double times[] = { 1001, 1002, 1003, 1005, 1007, 1011 };
+    const double entries[] = { 3, 3, 3, 4, 5, 5 };
+    for (size_t i = 0; i < 6; i++) {
+      BOOST_CHECK_EQUAL(trend->GetVal(0)[i], times[i]);
+      BOOST_CHECK_EQUAL(trend->GetVal(1)[i], entries[i]);
+      BOOST_CHECK_EQUAL(trend->GetVal(2)[i], Quality::Bad.getLevel());
+    }
+  }
+
+  // A trend with other branches is not resumed
+  {
+    auto* otherTree = new TTree(taskName.c_str(), taskName.c_str());
+    int value = 0;
+    otherTree->Branch("value", &value, "value/I");
+    otherTree->Fill();
+    otherTree->ResetBranchAddresses();
+    qcdb.storeMO(std::make_shared<MonitorObject>(otherTree, taskName, "TST"), 1030000, -1);
+
+    auto objectsManager = std::make_shared<ObjectsManager>(taskName, "TST", "", 0, true);
+    TrendingTask task;
+    task.setName(taskName);
+    task.setObjectsManager(objectsManager);
+    task.configure(taskName, config);
+    task.initialize({ TriggerType::Once, 1040000 }, services);
+
+    auto* trend = dynamic_cast<TTree*>(objectsManager->getMonitorObject(taskName)->getObject());
+    BOOST_REQUIRE(trend != nullptr);
+    BOOST_CHECK_EQUAL(trend->GetEntries(), 0);
+    BOOST_CHECK(trend->GetBranch("histo") != nullptr);
+  }
+}
@@ -81,7 +81,8 @@ function benchmark() {
   local config_file_template='../etc/benchmarkCheckTemplate.json'
   local config_file_concrete='benchmarkCheck.json'
   local run_log='run_log'
-  local check_config='\"AlwaysGoodCheck__CHECK_NO__\":{\"active\":\"true\",\"className\":\"o2::quality_control_modules::benchmark::AlwaysGoodCheck\",\"moduleName\":\"QcBenchmark\",\"policy\":\"OnAny\",\"detectorName\":\"TST\",\"dataSource\":[{\"type\":\"Task\",\"name\":\"BenchmarkTask\"}]},__CHECKS__'
+  # the check definition is the one-line prototype of the template, it is copied for each check
+  local check_config=`grep -o '"AlwaysGoodCheck":.*}' $config_file_template`
 
   printf "QC CHECK RUNNER BENCHMARK RESULTS\n" > $results_filename
   printf "Date:                   %s\n" "$test_date" >> $results_filename
@@ -111,11 +112,11 @@ function benchmark() {
         # create a json string with all check configurations
         total_checks_config=
         for ((check_no=0;check_no<nb_checks;check_no++)); do
-          new_check=`echo ${check_config} | sed 's/__CHECK_NO__/'$check_no'/g'`
-          inplace_sed 's/__CHECKS__/\n'$new_check'/g' $config_file_concrete
+          new_check=${check_config/\"AlwaysGoodCheck\"/\"AlwaysGoodCheck$check_no\"}
+          total_checks_config=$total_checks_config${total_checks_config:+,}$new_check
         done
-        # cut last comma and tag
-        inplace_sed 's/,__CHECKS__//g' $config_file_concrete
+        # replace the prototype with them
+        inplace_sed 's/"AlwaysGoodCheck":.*}/'"$total_checks_config"'/' $config_file_concrete
 
         echo "...created."
 
@@ -0,0 +1,410 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file    runBenchmark.cxx
+///
+/// \brief Runs the QC Task and Check throughput benchmark on a single machine.
+///
+/// For each point of the parameter matrix (tasks x checks x histograms x bins x producers x payload sizes), a
+/// configuration file is generated out of benchmarkTaskTemplate.json and the check definition of
+/// benchmarkCheckTemplate.json, a producer is piped into o2-qc on localhost
+/// and the metrics printed by the QC devices are parsed once the test is over. The peak memory of each device is
+/// sampled in /proc while the test runs. One JSON object per test is appended to the report file.
+
+#include <boost/program_options.hpp>
+#include <boost/property_tree/json_parser.hpp>
+#include <boost/property_tree/ptree.hpp>
+#include <boost/algorithm/string.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <csignal>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <numeric>
+#include <regex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace bpo = boost::program_options;
+namespace bpt = boost::property_tree;
+
+namespace
+{
+
+struct BenchmarkParameters {
+  int tasks;
+  int checks;
+  int histograms;
+  int bins;
+  int producers;
+  size_t payloadSize;
+};
+
+struct BenchmarkSettings {
+  std::string templateFile;
+  std::string checkTemplateFile;
+  std::string repositoryUrl;
+  std::string workDir;
+  int cycleSeconds;
+  int testDuration;
+  int warmUpCycles;
+  size_t maxInputThroughput;
+  bool fill;
+};
+
+struct BenchmarkResult {
+  std::vector<double> cycleDurations;       // seconds, as measured by the tasks
+  std::vector<double> publicationDurations; // seconds, as measured by the tasks
+  double messagesPerSecond = 0;
+  double dataPerSecond = 0;
+  double objectsPerSecond = 0;
+  double checksPerSecond = 0;
+  std::map<std::string, long> peakMemoryKB; // per DPL device
+};
+
+std::vector<int> parseList(const std::string& list)
+{
+  std::vector<std::string> tokens;
+  boost::split(tokens, list, boost::is_any_of(","), boost::token_compress_on);
+  std::vector<int> values;
+  for (const auto& token : tokens) {
+    if (!token.empty()) {
+      values.push_back(std::stoi(token));
+    }
+  }
+  return values;
+}
+
+/// Builds the QC configuration with the requested number of tasks and checks per task out of the templates
+std::string generateConfig(const BenchmarkSettings& settings, const BenchmarkParameters& parameters)
+{
+  bpt::ptree config;
+  bpt::read_json(settings.templateFile, config);
+  bpt::ptree checkConfig;
+  bpt::read_json(settings.checkTemplateFile, checkConfig);
+
+  if (!settings.repositoryUrl.empty()) {
+    config.put("qc.config.database.implementation", "CCDB");
+    config.put("qc.config.database.host", settings.repositoryUrl);
+  }
+
+  auto taskPrototype = config.get_child("qc.tasks.BenchmarkTask");
+  taskPrototype.put("cycleDurationSeconds", std::to_string(settings.cycleSeconds));
+  taskPrototype.put("taskParameters.histoNumber", std::to_string(parameters.histograms));
+  taskPrototype.put("taskParameters.binsNumber", std::to_string(parameters.bins));
+  auto checkPrototype = checkConfig.get_child("qc.checks.AlwaysGoodCheck");
+
+  bpt::ptree tasks;
+  bpt::ptree checks;
+  for (int task = 0; task < parameters.tasks; task++) {
+    std::string taskName = "BenchmarkTask" + std::to_string(task);
+    tasks.add_child(bpt::ptree::path_type(taskName, '/'), taskPrototype);
+
+    for (int check = 0; check < parameters.checks; check++) {
+      auto checkConfig = checkPrototype;
+      for (auto& [key, dataSource] : checkConfig.get_child("dataSource")) {
+        dataSource.put("name", taskName);
+      }
+      checks.add_child(bpt::ptree::path_type("AlwaysGoodCheck" + std::to_string(task) + "_" + std::to_string(check), '/'), checkConfig);
+    }
+  }
+  config.put_child("qc.tasks", tasks);
+  config.put_child("qc.checks", checks);
+
+  std::string configFile = settings.workDir + "/benchmarkTask.json";
+  bpt::write_json(configFile, config);
+  return configFile;
+}
+
+/// Returns the DPL device id of a process, taken from its command line, or its executable name
+std::string deviceName(const std::filesystem::path& procDir)
+{
+  std::ifstream cmdlineFile(procDir / "cmdline");
+  std::vector<std::string> arguments;
+  for (std::string argument; std::getline(cmdlineFile, argument, '\0');) {
+    arguments.push_back(argument);
+  }
+  for (size_t i = 0; i + 1 < arguments.size(); i++) {
+    if (arguments[i] == "--id") {
+      return arguments[i + 1];
+    }
+  }
+  return arguments.empty() ? "" : std::filesystem::path(arguments[0]).filename().string();
+}
+
+/// Updates the peak resident memory of all the processes belonging to the given process group
+void sampleMemory(pid_t processGroup, std::map<std::string, long>& peakMemoryKB)
+{
+  static const long pageSizeKB = sysconf(_SC_PAGESIZE) / 1024;
+  std::error_code ec;
+  for (const auto& entry : std::filesystem::directory_iterator("/proc", ec)) {
+    const auto& pidName = entry.path().filename().string();
+    if (!std::all_of(pidName.begin(), pidName.end(), ::isdigit)) {
+      continue;
+    }
+    // the process group is the 5th field of stat, the name in the 2nd one may contain spaces
+    std::ifstream statFile(entry.path() / "stat");
+    std::string stat((std::istreambuf_iterator<char>(statFile)), std::istreambuf_iterator<char>());
+    auto nameEnd = stat.rfind(')');
+    if (nameEnd == std::string::npos) {
+      continue;
+    }
+    std::istringstream fields(stat.substr(nameEnd + 2));
+    std::string state;
+    pid_t parent, group;
+    if (!(fields >> state >> parent >> group) || group != processGroup) {
+      continue;
+    }
+    std::ifstream statmFile(entry.path() / "statm");
+    long size, resident;
+    if (!(statmFile >> size >> resident)) {
+      continue;
+    }
+    auto name = deviceName(entry.path());
+    if (name.empty() || name == "sh" || name == "timeout") {
+      continue;
+    }
+    auto& peak = peakMemoryKB[name];
+    peak = std::max(peak, resident * pageSizeKB);
+  }
+}
+
+/// Runs the command in its own process group for the given duration, while sampling the memory usage
+void runCommand(const std::string& command, const std::string& logFile, int duration, BenchmarkResult& result)
+{
+  pid_t pid = fork();
+  if (pid < 0) {
+    throw std::runtime_error("Could not fork the benchmark process");
+  }
+  if (pid == 0) {
+    setpgid(0, 0);
+    int fd = open(logFile.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    dup2(fd, STDOUT_FILENO);
+    dup2(fd, STDERR_FILENO);
+    close(fd);
+    execl("/bin/sh", "sh", "-c", command.c_str(), nullptr);
+    _exit(127);
+  }
+  setpgid(pid, pid);
+
+  auto end = std::chrono::steady_clock::now() + std::chrono::seconds(duration);
+  int status = 0;
+  while (std::chrono::steady_clock::now() < end) {
+    if (waitpid(pid, &status, WNOHANG) == pid) {
+      std::cerr << "The benchmark workflow exited before the end of the test" << std::endl;
+      return;
+    }
+    sampleMemory(pid, result.peakMemoryKB);
+    std::this_thread::sleep_for(std::chrono::seconds(1));
+  }
+
+  kill(-pid, SIGTERM);
+  for (int i = 0; i < 50 && waitpid(pid, &status, WNOHANG) == 0; i++) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  }
+  // DPL children may outlive the driver, make sure nothing is left behind
+  kill(-pid, SIGKILL);
+  waitpid(pid, &status, 0);
+}
+
+/// Extracts the values of a metric field printed in the log, skipping the warm up cycles
+std::vector<double> parseMetric(const std::string& log, const std::string& metric, const std::string& field, size_t skip)
+{
+  std::regex valueRegex(metric + "[^\\n]*?\\b" + field + "=([0-9.eE+-]+)");
+  std::vector<double> values;
+  for (auto it = std::sregex_iterator(log.begin(), log.end(), valueRegex); it != std::sregex_iterator(); ++it) {
+    values.push_back(std::stod((*it)[1].str()));
+  }
+  values.erase(values.begin(), values.begin() + std::min(skip, values.size()));
+  return values;
+}
+
+void parseMetrics(const std::string& logFile, const BenchmarkSettings& settings, const BenchmarkParameters& parameters, BenchmarkResult& result)
+{
+  std::ifstream file(logFile);
+  std::string log((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+  // each task reports its own cycles
+  size_t skip = settings.warmUpCycles * parameters.tasks;
+  result.cycleDurations = parseMetric(log, "qc_duration", "module_cycle", skip);
+  result.publicationDurations = parseMetric(log, "qc_duration", "publication", skip);
+  auto messages = parseMetric(log, "qc_data_received", "messages_in_cycle", skip);
+  auto data = parseMetric(log, "qc_data_received", "data_in_cycle", skip);
+  auto objects = parseMetric(log, "qc_objects_published", "in_cycle", skip);
+  auto checks = parseMetric(log, "qc_checks_executed", "value(?:_rate)?", settings.warmUpCycles);
+
+  // the tasks run in parallel, the time is thus divided by their number
+  double totalTime = std::accumulate(result.cycleDurations.begin(), result.cycleDurations.end(), 0.0) +
+                     std::accumulate(result.publicationDurations.begin(), result.publicationDurations.end(), 0.0);
+  totalTime /= parameters.tasks;
+  if (totalTime > 0) {
+    result.messagesPerSecond = std::accumulate(messages.begin(), messages.end(), 0.0) / totalTime;
+    result.dataPerSecond = std::accumulate(data.begin(), data.end(), 0.0) / totalTime;
+    result.objectsPerSecond = std::accumulate(objects.begin(), objects.end(), 0.0) / totalTime;
+  }
+  if (!checks.empty()) {
+    result.checksPerSecond = std::accumulate(checks.begin(), checks.end(), 0.0) / checks.size();
+  }
+}
+
+double percentile(std::vector<double> values, double fraction)
+{
+  if (values.empty()) {
+    return 0;
+  }
+  auto nth = values.begin() + static_cast<size_t>(fraction * (values.size() - 1));
+  std::nth_element(values.begin(), nth, values.end());
+  return *nth;
+}
+
+void writeResult(std::ostream& report, const std::string& testName, int repetition, const BenchmarkParameters& parameters, const BenchmarkResult& result)
+{
+  std::vector<double> latencies(result.cycleDurations.size());
+  for (size_t i = 0; i < latencies.size(); i++) {
+    latencies[i] = result.cycleDurations[i] + (i < result.publicationDurations.size() ? result.publicationDurations[i] : 0);
+  }
+
+  report << "{\"test\":\"" << testName << "\",\"repetition\":" << repetition
+         << ",\"tasks\":" << parameters.tasks << ",\"checks\":" << parameters.checks
+         << ",\"histograms\":" << parameters.histograms << ",\"bins\":" << parameters.bins
+         << ",\"producers\":" << parameters.producers << ",\"payload_size\":" << parameters.payloadSize
+         << ",\"cycles\":" << latencies.size()
+         << ",\"cycle_latency_s\":{\"p50\":" << percentile(latencies, 0.5) << ",\"p99\":" << percentile(latencies, 0.99)
+         << ",\"max\":" << percentile(latencies, 1.0) << "}"
+         << ",\"publication_s\":{\"p50\":" << percentile(result.publicationDurations, 0.5)
+         << ",\"max\":" << percentile(result.publicationDurations, 1.0) << "}"
+         << ",\"messages_per_second\":" << result.messagesPerSecond
+         << ",\"data_per_second\":" << result.dataPerSecond
+         << ",\"objects_per_second\":" << result.objectsPerSecond
+         << ",\"checks_per_second\":" << result.checksPerSecond
+         << ",\"peak_memory_kB\":{";
+  bool first = true;
+  for (const auto& [device, memory] : result.peakMemoryKB) {
+    report << (first ? "" : ",") << "\"" << device << "\":" << memory;
+    first = false;
+  }
+  report << "}}" << std::endl;
+}
+
+} // namespace
+
+int main(int argc, const char* argv[])
+{
+  try {
+    std::string defaultTemplatePath = getenv("QUALITYCONTROL_ROOT") != nullptr ? std::string(getenv("QUALITYCONTROL_ROOT")) + "/Modules/Benchmark/etc/benchmarkTaskTemplate.json" : "$QUALITYCONTROL_ROOT undefined";
+    std::string defaultCheckTemplatePath = getenv("QUALITYCONTROL_ROOT") != nullptr ? std::string(getenv("QUALITYCONTROL_ROOT")) + "/Modules/Benchmark/etc/benchmarkCheckTemplate.json" : "$QUALITYCONTROL_ROOT undefined";
+    bpo::options_description desc{ "Options" };
+    desc.add_options()                                                                                                                       //
+      ("help,h", "Help screen")                                                                                                              //
+      ("test-name", bpo::value<std::string>()->default_value("benchmark"), "Name of the test, written in the report")                        //
+      ("template", bpo::value<std::string>()->default_value(defaultTemplatePath), "Path to the configuration template")                      //
+      ("check-template", bpo::value<std::string>()->default_value(defaultCheckTemplatePath), "Path to the template of the checks")           //
+      ("report", bpo::value<std::string>()->default_value("qc-benchmark-report.jsonl"), "Report file, one JSON object per test is appended") //
+      ("work-dir", bpo::value<std::string>()->default_value("."), "Directory for the generated configuration and the logs")                  //
+      ("repository", bpo::value<std::string>()->default_value(""), "URL of a local repository, the Dummy database is used if empty")         //
+      ("tasks", bpo::value<std::string>()->default_value("1"), "Comma separated numbers of TH1FTask instances")                              //
+      ("checks", bpo::value<std::string>()->default_value("1"), "Comma separated numbers of AlwaysGoodCheck instances per task")             //
+      ("histograms", bpo::value<std::string>()->default_value("1"), "Comma separated numbers of histograms per task")                        //
+      ("bins", bpo::value<std::string>()->default_value("100"), "Comma separated numbers of bins per histogram")                             //
+      ("producers", bpo::value<std::string>()->default_value("1"), "Comma separated numbers of producers (DPL time pipelines)")              //
+      ("payload-sizes", bpo::value<std::string>()->default_value("256"), "Comma separated payload sizes [B]")                                //
+      ("cycle-seconds", bpo::value<int>()->default_value(10), "Cycle duration of the tasks [s]")                                             //
+      ("test-duration", bpo::value<int>()->default_value(300), "Duration of one test [s]")                                                   //
+      ("warm-up-cycles", bpo::value<int>()->default_value(5), "Number of first cycles ignored in the results")                               //
+      ("repetitions", bpo::value<int>()->default_value(1), "Number of repetitions of each test")                                             //
+      ("max-input-throughput", bpo::value<size_t>()->default_value(5000000000), "Limit of the total data rate of producers [B/s]")           //
+      ("fill", bpo::bool_switch(), "Fill the produced messages (prevents from overcommitting memory)");
+
+    bpo::variables_map vm;
+    store(parse_command_line(argc, argv, desc), vm);
+    notify(vm);
+
+    if (vm.count("help")) {
+      std::cout << desc << std::endl;
+      return 0;
+    }
+
+    BenchmarkSettings settings;
+    settings.templateFile = vm["template"].as<std::string>();
+    settings.checkTemplateFile = vm["check-template"].as<std::string>();
+    settings.repositoryUrl = vm["repository"].as<std::string>();
+    settings.workDir = std::filesystem::absolute(vm["work-dir"].as<std::string>()).lexically_normal().string();
+    settings.cycleSeconds = vm["cycle-seconds"].as<int>();
+    settings.testDuration = vm["test-duration"].as<int>();
+    settings.warmUpCycles = vm["warm-up-cycles"].as<int>();
+    settings.maxInputThroughput = vm["max-input-throughput"].as<size_t>();
+    settings.fill = vm["fill"].as<bool>();
+    const auto testName = vm["test-name"].as<std::string>();
+    const auto repetitions = vm["repetitions"].as<int>();
+    const auto logFile = settings.workDir + "/run_log";
+
+    std::ofstream report(vm["report"].as<std::string>(), std::ios::app);
+    if (!report) {
+      std::cerr << "Could not open the report file " << vm["report"].as<std::string>() << std::endl;
+      return 1;
+    }
+
+    for (int tasks : parseList(vm["tasks"].as<std::string>())) {
+      for (int checks : parseList(vm["checks"].as<std::string>())) {
+        for (int histograms : parseList(vm["histograms"].as<std::string>())) {
+          for (int bins : parseList(vm["bins"].as<std::string>())) {
+            for (int producers : parseList(vm["producers"].as<std::string>())) {
+              for (int payloadSize : parseList(vm["payload-sizes"].as<std::string>())) {
+                BenchmarkParameters parameters{ tasks, checks, histograms, bins, producers, static_cast<size_t>(payloadSize) };
+                auto configFile = generateConfig(settings, parameters);
+
+                size_t messageRate = std::max<size_t>(1, settings.maxInputThroughput / parameters.payloadSize / producers);
+                std::string command = "o2-qc-run-producer -b" + std::string(settings.fill ? "" : " --empty") +
+                                      " --min-size " + std::to_string(payloadSize) +
+                                      " --max-size " + std::to_string(payloadSize) +
+                                      " --timepipeline " + std::to_string(producers) +
+                                      " --message-rate " + std::to_string(messageRate) +
+                                      " | o2-qc --run -b --shm-segment-size 50000000000 --infologger-severity info --config json:/" + configFile;
+
+                for (int repetition = 0; repetition < repetitions; repetition++) {
+                  std::cout << "Running '" << testName << "' with " << tasks << " tasks, " << checks << " checks per task, "
+                            << histograms << " histograms, " << bins << " bins, " << producers << " producers, "
+                            << payloadSize << " B payloads, repetition " << repetition << std::endl;
+                  std::cout << "Used command: " << command << std::endl;
+
+                  BenchmarkResult result;
+                  runCommand(command, logFile, settings.testDuration, result);
+                  parseMetrics(logFile, settings, parameters, result);
+                  if (result.cycleDurations.empty()) {
+                    std::cerr << "No cycle was reported by the tasks, see " << logFile << std::endl;
+                  }
+                  writeResult(report, testName, repetition, parameters, result);
+                }
+              }
+            }
+          }
+        }
+      }
+    }
+    return 0;
+  } catch (const bpo::error& ex) {
+    std::cerr << "Exception caught: " << ex.what() << std::endl;
+    return 1;
+  } catch (const std::exception& ex) {
+    std::cerr << "Benchmark failed: " << ex.what() << std::endl;
+    return 1;
+  }
+}
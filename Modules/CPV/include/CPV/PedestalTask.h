@@ -23,6 +23,7 @@
 #include "DataFormatsCPV/TriggerRecord.h"
 #include <gsl/span>
 #include "CPVBase/Geometry.h"
+#include "Common/PedestalStatistics.h"
 
 class TH1F;
 class TH2F;
@@ -56,6 +57,7 @@ class PedestalTask final : public TaskInterface
   // void fillHistograms(const gsl::span<const o2::cpv::Digit>& digits, const gsl::span<const o2::cpv::TriggerRecord>& triggerRecords);
   void fillHistograms();
   void resetHistograms();
+  void publishAmplitudeHistogram(int channel);
 
   static constexpr short kNHist1D = 14;
   enum Histos1D { H1DInputPayloadSize,
@@ -95,6 +97,7 @@ class PedestalTask final : public TaskInterface
 
   static constexpr short kNModules = 3;
   static constexpr short kNChannels = 23040;
+  static constexpr short kNAmplitudeBins = 4096;
   o2::cpv::Geometry mCPVGeometry;
 
   int mNEventsTotal;
@@ -103,8 +106,11 @@ class PedestalTask final : public TaskInterface
   std::array<TH1F*, kNHist1D> mHist1D = { nullptr }; ///< Array of 1D histograms
   std::array<TH2F*, kNHist2D> mHist2D = { nullptr }; ///< Array of 2D histograms
 
-  std::array<TH1F*, kNChannels> mHistAmplitudes = { nullptr };  ///< Array of amplitude spectra
-  std::array<bool, kNChannels> mIsUpdatedAmplitude = { false }; ///< Array of isUpdatedAmplitude bools
+  std::array<TH1F*, kNChannels> mHistAmplitudes = { nullptr }; ///< Array of amplitude spectra, only of the published channels
+
+  /// amplitudes of all the channels, their spectra are copied to mHistAmplitudes when these are published
+  o2::quality_control_modules::common::PedestalStatistics mPedestalStatistics{ kNChannels, kNAmplitudeBins, 0., kNAmplitudeBins };
+  o2::quality_control_modules::common::PedestalStatistics::Settings mPedestalSettings;
 };
 
 } // namespace o2::quality_control_modules::cpv
@@ -16,14 +16,14 @@
 #include <TCanvas.h>
 #include <TH1.h>
 #include <TH2.h>
-#include <TF1.h>
-#include <TSpectrum.h>
 
 #include "QualityControl/QcInfoLogger.h"
 #include "CPV/PedestalTask.h"
 #include <Framework/InputRecord.h>
 #include "DataFormatsCPV/TriggerRecord.h"
 
+#include <algorithm>
+
 namespace o2::quality_control_modules::cpv
 {
 
@@ -57,6 +57,13 @@ void PedestalTask::initialize(o2::framework::InitContext& /*ctx*/)
   if (auto param = mCustomParameters.find("myOwnKey"); param != mCustomParameters.end()) {
     ILOG(Info, Devel) << "Custom parameter - myOwnKey: " << param->second << ENDM;
   }
+  // the channels with a larger standard deviation are searched for peaks and fitted
+  if (auto param = mCustomParameters.find("maxPedestalStdDev"); param != mCustomParameters.end()) {
+    mPedestalSettings.maxStdDev = std::stod(param->second);
+  }
+  if (auto param = mCustomParameters.find("nThreads"); param != mCustomParameters.end()) {
+    mPedestalSettings.nThreads = std::max(std::stoi(param->second), 1);
+  }
   initHistograms();
   mNEventsTotal = 0;
   mNEventsFromLastFillHistogramsCall = 0;
@@ -73,9 +80,6 @@ void PedestalTask::startOfActivity(Activity& activity)
 void PedestalTask::startOfCycle()
 {
   ILOG(Info, Support) << "startOfCycle" << ENDM;
-  //at at the startOfCycle all HistAmplitudes are not updated by definition
-  for (int i = 0; i < kNChannels; i++)
-    mIsUpdatedAmplitude[i] = false;
 }
 
 void PedestalTask::monitorData(o2::framework::ProcessingContext& ctx)
@@ -119,8 +123,7 @@ void PedestalTask::monitorData(o2::framework::ProcessingContext& ctx)
     mCPVGeometry.absToRelNumbering(digit.getAbsId(), relId);
     //reminder: relId[3]={Module, phi col, z row} where Module=2..4, phi col=0..127, z row=0..59
     mHist2D[H2DDigitMapM2 + relId[0] - 2]->Fill(relId[1], relId[2]);
-    mHistAmplitudes[digit.getAbsId()]->Fill(digit.getAmplitude());
-    mIsUpdatedAmplitude[digit.getAbsId()] = true;
+    mPedestalStatistics.fill(digit.getAbsId(), digit.getAmplitude());
   }
 
   auto digitsTR = ctx.inputs().get<gsl::span<o2::cpv::TriggerRecord>>("dtrigrec");
@@ -190,19 +193,12 @@ void PedestalTask::reset()
 void PedestalTask::initHistograms()
 {
   //create monitoring histograms (or reset, if they already exist)
-  for (int i = 0; i < kNChannels; i++) {
-    if (!mHistAmplitudes[i]) {
-      mHistAmplitudes[i] =
-        new TH1F(Form("HistAmplitude%d", i), Form("HistAmplitude%d", i), 4096, 0., 4096.);
-      //publish some of them
-      if (i % 1000 == 0)
-        getObjectsManager()->startPublishing(mHistAmplitudes[i]);
-
-    } else {
-      mHistAmplitudes[i]->Reset();
-    }
-    mIsUpdatedAmplitude[i] = false;
+  //publish some of them, the others are published only if they look bad
+  for (int i = 0; i < kNChannels; i += 1000) {
+    publishAmplitudeHistogram(i);
+    mHistAmplitudes[i]->Reset();
   }
+  mPedestalStatistics.reset();
 
   //1D Histos
   if (!mHist1D[H1DInputPayloadSize]) {
@@ -375,10 +371,10 @@ void PedestalTask::fillHistograms()
   // count pedestals and update MOs
   float pedestalValue, pedestalSigma, pedestalEfficiency;
   short relId[3];
-  TF1* functionGaus = new TF1("functionGaus", "gaus", 0., 4095.);
-  TSpectrum* peakSearcher = new TSpectrum(5); //find up to 5 pedestal peaks
-  int numberOfPeaks;                          //number of pedestal peaks in channel. Normaly it's 1, otherwise channel is bad
-  double *xPeaks, yPeaks[5];                  // arrays of x-position of the peaks and their heights
+  int numberOfPeaks; //number of pedestal peaks in channel. Normaly it's 1, otherwise channel is bad
+
+  // moments of all the channels, peak search and fit only of those which are too wide
+  auto pedestals = mPedestalStatistics.analyse(mPedestalSettings);
 
   //first, reset pedestal histograms
   for (int mod = 0; mod < 3; mod++) {
@@ -393,53 +389,29 @@ void PedestalTask::fillHistograms()
 
   //then fill them with actual values
   for (int channel = 0; channel < kNChannels; channel++) {
-    if (!mHistAmplitudes[channel]) {
-      ILOG(Error, Devel) << "fillHistograms() : histo mHistAmplitudes[" << channel
-                         << "] does not exist! Something is going wrong." << ENDM;
-      continue;
-    }
-    if (!mIsUpdatedAmplitude[channel])
+    if (mPedestalStatistics.getEntries(channel) == 0)
       continue; //no data in channel, skipping it
 
-    if (channel % 1000 == 0) {
-      ILOG(Info, Devel) << "fillHistograms(): Start to search peaks in channel " << channel << ENDM;
-      LOG(INFO) << "fillHistograms(): Start to search peaks in channel " << channel;
-    }
-
-    numberOfPeaks = peakSearcher->Search(mHistAmplitudes[channel], 10., "nobackground", 0.2);
-    xPeaks = peakSearcher->GetPositionX();
-
-    if (numberOfPeaks == 1) { // only 1 peak, fit spectrum with gaus
-      yPeaks[0] = mHistAmplitudes[channel]
-                    ->GetBinContent(mHistAmplitudes[channel]->GetXaxis()->FindBin(xPeaks[0]));
-      functionGaus->SetParameters(yPeaks[0], xPeaks[0], 2.);
-      mHistAmplitudes[channel]->Fit(functionGaus, "WWQ", "", xPeaks[0] - 20., xPeaks[0] + 20.);
-      pedestalValue = functionGaus->GetParameter(1);
-      pedestalSigma = functionGaus->GetParameter(2);
-      //stop publish this amplitude as it's OK (that fails due to some unclear reason)
-      //if (getObjectsManager()->isBeingPublished(mHistAmplitudes[channel]->GetName())){
-      //getObjectsManager()->stopPublishing(mHistAmplitudes[channel]->GetName());
-      //}
+    numberOfPeaks = pedestals[channel].nPeaks;
+    if (numberOfPeaks == 1) { // only 1 peak, the moments or the gaus fit if the spectrum is too wide
+      pedestalValue = pedestals[channel].mean;
+      pedestalSigma = pedestals[channel].sigma;
     } else {
       if (numberOfPeaks > 1) { // >1 peaks, no fit. Just use mean and stddev as ped value & sigma
-        pedestalValue = mHistAmplitudes[channel]->GetMean();
+        pedestalValue = pedestals[channel].mean;
         if (pedestalValue > 0)
           pedestalValue = -pedestalValue; //let it be negative so we can know it's bad later
-        pedestalSigma = mHistAmplitudes[channel]->GetStdDev();
+        pedestalSigma = pedestals[channel].sigma;
         //let's publish this bad amplitude
-        if (!getObjectsManager()->isBeingPublished(mHistAmplitudes[channel]->GetName())) {
-          getObjectsManager()->startPublishing(mHistAmplitudes[channel]);
-        }
+        publishAmplitudeHistogram(channel);
       } else { //numberOfPeaks < 1 - what is it?
         //no peaks found((( OK let's show the spectrum to the world...
-        if (!getObjectsManager()->isBeingPublished(mHistAmplitudes[channel]->GetName())) {
-          getObjectsManager()->startPublishing(mHistAmplitudes[channel]);
-        }
+        publishAmplitudeHistogram(channel);
         continue;
       }
     }
 
-    pedestalEfficiency = mHistAmplitudes[channel]->GetEntries() / mNEventsTotal;
+    pedestalEfficiency = float(mPedestalStatistics.getEntries(channel)) / mNEventsTotal;
     mCPVGeometry.absToRelNumbering(channel, relId);
     mHist2D[H2DPedestalValueMapM2 + relId[0] - 2]
       ->SetBinContent(relId[1] + 1, relId[2] + 1, pedestalValue);
@@ -455,6 +427,18 @@ void PedestalTask::fillHistograms()
     mHist1D[H1DPedestalEfficiencyM2 + relId[0] - 2]->Fill(pedestalEfficiency);
   }
 
+  //update the published amplitude spectra
+  for (int channel = 0; channel < kNChannels; channel++) {
+    if (!mHistAmplitudes[channel]) {
+      continue;
+    }
+    const uint32_t* spectrum = mPedestalStatistics.getSpectrum(channel);
+    for (int bin = 0; bin < kNAmplitudeBins; bin++) {
+      mHistAmplitudes[channel]->SetBinContent(bin + 1, spectrum[bin]);
+    }
+    mHistAmplitudes[channel]->SetEntries(mPedestalStatistics.getEntries(channel));
+  }
+
   //show some info to developer
   ILOG(Info, Devel) << "fillHistograms() : at this time, N events = " << mNEventsTotal << ENDM;
   LOG(INFO) << "fillPedestals() : I finished filling of histograms";
@@ -465,9 +449,11 @@ void PedestalTask::resetHistograms()
   // clean all histograms
   ILOG(Info, Support) << "Resetting amplitude histograms" << ENDM;
   for (int i = 0; i < kNChannels; i++) {
-    mHistAmplitudes[i]->Reset();
-    mIsUpdatedAmplitude[i] = false;
+    if (mHistAmplitudes[i]) {
+      mHistAmplitudes[i]->Reset();
+    }
   }
+  mPedestalStatistics.reset();
 
   ILOG(Info, Support) << "Resetting the 1D Histograms" << ENDM;
   for (int itHist1D = H1DInputPayloadSize; itHist1D < kNHist1D; itHist1D++) {
@@ -480,4 +466,15 @@ void PedestalTask::resetHistograms()
   }
 }
 
+void PedestalTask::publishAmplitudeHistogram(int channel)
+{
+  if (!mHistAmplitudes[channel]) {
+    mHistAmplitudes[channel] =
+      new TH1F(Form("HistAmplitude%d", channel), Form("HistAmplitude%d", channel), kNAmplitudeBins, 0., kNAmplitudeBins);
+  }
+  if (!getObjectsManager()->isBeingPublished(mHistAmplitudes[channel]->GetName())) {
+    getObjectsManager()->startPublishing(mHistAmplitudes[channel]);
+  }
+}
+
 } // namespace o2::quality_control_modules::cpv
@@ -0,0 +1,105 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   PedestalStatistics.h
+///
+
+#ifndef QC_MODULE_COMMON_PEDESTALSTATISTICS_H
+#define QC_MODULE_COMMON_PEDESTALSTATISTICS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace o2::quality_control_modules::common
+{
+
+/// \brief Running statistics of the values of many channels, e.g. the ADC counts of pedestal runs.
+///
+/// The count, mean and sum of squared deviations of each channel are updated with Welford's algorithm and kept in
+/// one array per quantity, so that filling a value touches only a few words and the final pass runs over contiguous
+/// memory. Optionally, a spectrum of the values is kept for each channel in a single array of counts.
+///
+/// analyse() takes the moments as the pedestal of the channels whose standard deviation is small enough. Only the
+/// other channels, when spectra are kept, have their peaks searched and a Gaussian fitted to their spectrum. This is
+/// done with plain arithmetic on the counts, without ROOT objects, so that these channels can be processed in parallel.
+class PedestalStatistics
+{
+ public:
+  struct Settings {
+    double maxStdDev = 5.0;       ///< channels with a standard deviation above this are searched for peaks
+    double peakThreshold = 0.2;   ///< minimum height of a peak, relative to the highest bin of the spectrum
+    unsigned int peakWindow = 10; ///< a peak is the highest bin within this number of bins on each side
+    double fitRange = 20.0;       ///< half width of the range of the Gaussian fit around the peak, in values
+    int nThreads = 1;             ///< number of threads used for the channels which fail the moment test
+  };
+
+  struct Result {
+    double mean = 0;     ///< pedestal value
+    double sigma = 0;    ///< pedestal width
+    int nPeaks = 0;      ///< 1 for a good channel, 0 when no peak is found, more when several are found
+    bool fitted = false; ///< true if the mean and sigma come from a fit of the spectrum instead of the moments
+  };
+
+  /// \param nChannels - number of channels, numbered from 0
+  /// \param nBins - number of bins of the spectrum of each channel, 0 to keep no spectra
+  /// \param min - lower edge of the spectra
+  /// \param max - upper edge of the spectra
+  PedestalStatistics(size_t nChannels, unsigned int nBins = 0, double min = 0, double max = 0);
+
+  /// Adds a value to a channel, the channels out of range are ignored.
+  void fill(size_t channel, double value)
+  {
+    if (channel >= mCounts.size()) {
+      return;
+    }
+    const double count = ++mCounts[channel];
+    const double delta = value - mMeans[channel];
+    mMeans[channel] += delta / count;
+    mSquares[channel] += delta * (value - mMeans[channel]);
+    if (!mSpectra.empty() && value >= mMin && value < mMax) {
+      mSpectra[channel * mNBins + static_cast<size_t>((value - mMin) * mBinsPerValue)]++;
+    }
+  }
+  void reset();
+
+  size_t getNumberOfChannels() const { return mCounts.size(); }
+  uint32_t getEntries(size_t channel) const { return mCounts[channel]; }
+  double getMean(size_t channel) const { return mMeans[channel]; }
+  double getStdDev(size_t channel) const;
+
+  bool hasSpectra() const { return !mSpectra.empty(); }
+  unsigned int getNumberOfBins() const { return mNBins; }
+  double getMin() const { return mMin; }
+  double getMax() const { return mMax; }
+  /// \return the counts of the nBins bins of the spectrum of a channel
+  const uint32_t* getSpectrum(size_t channel) const { return mSpectra.data() + channel * mNBins; }
+
+  /// \return the pedestal of each channel, the channels without entries have a default Result
+  std::vector<Result> analyse(const Settings& settings) const;
+
+ private:
+  /// Searches the peaks in the spectrum of a channel, fits the highest if it is the only one.
+  Result analyseSpectrum(size_t channel, const Settings& settings) const;
+
+  std::vector<uint32_t> mCounts;
+  std::vector<double> mMeans;
+  std::vector<double> mSquares; // sums of the squared deviations from the mean
+  unsigned int mNBins = 0;
+  double mMin = 0;
+  double mMax = 0;
+  double mBinsPerValue = 0;
+  std::vector<uint32_t> mSpectra; // channel after channel
+};
+
+} // namespace o2::quality_control_modules::common
+
+#endif // QC_MODULE_COMMON_PEDESTALSTATISTICS_H
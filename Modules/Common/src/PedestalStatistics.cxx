@@ -0,0 +1,156 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   PedestalStatistics.cxx
+///
+
+#include "Common/PedestalStatistics.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace o2::quality_control_modules::common
+{
+
+PedestalStatistics::PedestalStatistics(size_t nChannels, unsigned int nBins, double min, double max)
+  : mCounts(nChannels, 0), mMeans(nChannels, 0), mSquares(nChannels, 0), mNBins(nBins), mMin(min), mMax(max)
+{
+  if (nBins > 0) {
+    if (max <= min) {
+      throw std::invalid_argument("The upper edge of the pedestal spectra must be above the lower edge");
+    }
+    mBinsPerValue = nBins / (max - min);
+    mSpectra.resize(nChannels * nBins, 0);
+  }
+}
+
+void PedestalStatistics::reset()
+{
+  std::fill(mCounts.begin(), mCounts.end(), 0);
+  std::fill(mMeans.begin(), mMeans.end(), 0);
+  std::fill(mSquares.begin(), mSquares.end(), 0);
+  std::fill(mSpectra.begin(), mSpectra.end(), 0);
+}
+
+double PedestalStatistics::getStdDev(size_t channel) const
+{
+  return mCounts[channel] > 0 ? std::sqrt(mSquares[channel] / mCounts[channel]) : 0;
+}
+
+std::vector<PedestalStatistics::Result> PedestalStatistics::analyse(const Settings& settings) const
+{
+  const size_t nChannels = mCounts.size();
+  std::vector<Result> results(nChannels);
+  std::vector<size_t> failed;
+
+  for (size_t channel = 0; channel < nChannels; channel++) {
+    if (mCounts[channel] == 0) {
+      continue;
+    }
+    auto& result = results[channel];
+    result.mean = mMeans[channel];
+    result.sigma = std::sqrt(mSquares[channel] / mCounts[channel]);
+    result.nPeaks = 1;
+    if (result.sigma > settings.maxStdDev) {
+      failed.push_back(channel);
+    }
+  }
+
+  if (mSpectra.empty()) {
+    return results;
+  }
+  // each channel is independent, the results are written at distinct places
+#ifdef WITH_OPENMP
+#pragma omp parallel for num_threads(settings.nThreads) schedule(dynamic)
+#endif
+  for (long index = 0; index < static_cast<long>(failed.size()); index++) {
+    results[failed[index]] = analyseSpectrum(failed[index], settings);
+  }
+  return results;
+}
+
+PedestalStatistics::Result PedestalStatistics::analyseSpectrum(size_t channel, const Settings& settings) const
+{
+  const uint32_t* spectrum = getSpectrum(channel);
+  const long nBins = mNBins;
+  const long window = settings.peakWindow;
+  const double binWidth = 1. / mBinsPerValue;
+
+  Result result;
+  result.mean = mMeans[channel];
+  result.sigma = std::sqrt(mSquares[channel] / mCounts[channel]);
+
+  // a peak is above the threshold and is the highest bin around, the first of equal bins
+  const uint32_t highest = *std::max_element(spectrum, spectrum + nBins);
+  const double threshold = std::max(settings.peakThreshold * highest, 1.);
+  long peak = -1;
+  for (long bin = 0; bin < nBins; bin++) {
+    if (spectrum[bin] < threshold) {
+      continue;
+    }
+    bool isPeak = true;
+    for (long other = std::max(bin - window, 0l); other <= std::min(bin + window, nBins - 1) && isPeak; other++) {
+      isPeak = other < bin ? spectrum[other] < spectrum[bin] : spectrum[other] <= spectrum[bin];
+    }
+    if (isPeak) {
+      result.nPeaks++;
+      if (peak < 0 || spectrum[bin] > spectrum[peak]) {
+        peak = bin;
+      }
+    }
+  }
+  if (result.nPeaks != 1) {
+    return result;
+  }
+
+  // Gaussian fit as a parabola fitted to the logarithm of the counts, each bin weighted by its counts,
+  // the positions being relative to the peak
+  const double peakPosition = mMin + (peak + 0.5) * binWidth;
+  const long range = static_cast<long>(settings.fitRange * mBinsPerValue);
+  double s[5] = { 0 }; // sums of w*u^k
+  double t[3] = { 0 }; // sums of w*u^k*ln(y)
+  for (long bin = std::max(peak - range, 0l); bin <= std::min(peak + range, nBins - 1); bin++) {
+    if (spectrum[bin] == 0) {
+      continue;
+    }
+    const double w = spectrum[bin];
+    const double u = (bin - peak) * binWidth;
+    const double logY = std::log(w);
+    double power = w;
+    for (int k = 0; k < 5; k++) {
+      s[k] += power;
+      if (k < 3) {
+        t[k] += power * logY;
+      }
+      power *= u;
+    }
+  }
+  // the normal equations, solved with Cramer's rule
+  auto determinant = [](double a0, double a1, double a2, double b0, double b1, double b2, double c0, double c1, double c2) {
+    return a0 * (b1 * c2 - b2 * c1) - a1 * (b0 * c2 - b2 * c0) + a2 * (b0 * c1 - b1 * c0);
+  };
+  const double d = determinant(s[0], s[1], s[2], s[1], s[2], s[3], s[2], s[3], s[4]);
+  if (d == 0) {
+    return result;
+  }
+  const double b = determinant(s[0], t[0], s[2], s[1], t[1], s[3], s[2], t[2], s[4]) / d;
+  const double c = determinant(s[0], s[1], t[0], s[1], s[2], t[1], s[2], s[3], t[2]) / d;
+  if (c >= 0) {
+    return result; // not a peak, e.g. a single bin
+  }
+  result.mean = peakPosition - b / (2 * c);
+  result.sigma = std::sqrt(-1 / (2 * c));
+  result.fitted = true;
+  return result;
+}
+
+} // namespace o2::quality_control_modules::common
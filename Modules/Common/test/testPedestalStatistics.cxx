@@ -0,0 +1,85 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   testPedestalStatistics.cxx
+///
+
+#include "Common/PedestalStatistics.h"
+
+#define BOOST_TEST_MODULE PedestalStatistics test
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include <cmath>
+#include <random>
+
+namespace o2::quality_control_modules::common
+{
+
+BOOST_AUTO_TEST_CASE(moments)
+{
+  PedestalStatistics statistics(3);
+  for (double value : { 2., 4., 4., 4., 5., 5., 7., 9. }) {
+    statistics.fill(1, value);
+  }
+  statistics.fill(3, 1.); // ignored
+
+  BOOST_CHECK_EQUAL(statistics.getEntries(0), 0);
+  BOOST_CHECK_EQUAL(statistics.getEntries(1), 8);
+  BOOST_CHECK_CLOSE(statistics.getMean(1), 5., 1e-9);
+  BOOST_CHECK_CLOSE(statistics.getStdDev(1), 2., 1e-9);
+  BOOST_CHECK(!statistics.hasSpectra());
+
+  auto results = statistics.analyse({});
+  BOOST_CHECK_EQUAL(results[0].nPeaks, 0);
+  BOOST_CHECK_EQUAL(results[1].nPeaks, 1);
+  BOOST_CHECK(!results[1].fitted);
+
+  statistics.reset();
+  BOOST_CHECK_EQUAL(statistics.getEntries(1), 0);
+  BOOST_CHECK_EQUAL(statistics.getStdDev(1), 0);
+}
+
+BOOST_AUTO_TEST_CASE(spectra)
+{
+  PedestalStatistics statistics(3, 512, 0, 512);
+  std::mt19937 generator(42);
+  std::normal_distribution<double> pedestal(100, 2);
+  std::normal_distribution<double> first(80, 2), second(200, 2);
+  std::normal_distribution<double> noise(0, 1);
+  for (int event = 0; event < 10000; event++) {
+    statistics.fill(0, pedestal(generator));
+    // a Gaussian with a few large values, which spoil the moments but not the fit
+    statistics.fill(1, event % 50 == 0 ? 400 + 10 * noise(generator) : pedestal(generator));
+    statistics.fill(2, event % 2 ? first(generator) : second(generator));
+  }
+  BOOST_CHECK(statistics.getSpectrum(0)[100] > 0);
+
+  PedestalStatistics::Settings settings;
+  settings.maxStdDev = 5;
+  auto results = statistics.analyse(settings);
+
+  BOOST_CHECK_EQUAL(results[0].nPeaks, 1);
+  BOOST_CHECK(!results[0].fitted);
+  BOOST_CHECK_CLOSE(results[0].mean, 100, 1);
+  BOOST_CHECK_CLOSE(results[0].sigma, 2, 5);
+
+  BOOST_CHECK_EQUAL(results[1].nPeaks, 1);
+  BOOST_CHECK(results[1].fitted);
+  BOOST_CHECK_CLOSE(results[1].mean, 100, 1);
+  BOOST_CHECK_CLOSE(results[1].sigma, 2, 10);
+
+  BOOST_CHECK_EQUAL(results[2].nPeaks, 2);
+  BOOST_CHECK(!results[2].fitted);
+}
+
+} // namespace o2::quality_control_modules::common
@@ -17,9 +17,13 @@
 #define QC_MODULE_DAQ_DAQTASK_H
 
 #include "QualityControl/TaskInterface.h"
+#include "QualityControl/RawPageScheduler.h"
 #include <Headers/DAQID.h>
 #include <map>
+#include <memory>
 #include <set>
+#include <string>
+#include <vector>
 
 class TH1F;
 
@@ -31,6 +35,7 @@ namespace o2::quality_control_modules::daq
 /// It does only look at the header and plots sizes (e.g. payload).
 /// It also can print the headers and the payloads by setting printHeaders to "1"
 /// and printPayload to "hex" or "bin" in the config file under "taskParameters".
+/// The RDHs are read by "nThreads" threads, 1 by default.
 /// \author Barthelemy von Haller
 class DaqTask final : public o2::quality_control::core::TaskInterface
 {
@@ -53,11 +58,26 @@ class DaqTask final : public o2::quality_control::core::TaskInterface
   void printInputPayload(const header::DataHeader* header, const char* payload);
   void monitorInputRecord(o2::framework::InputRecord& inputRecord);
   void monitorRDHs(o2::framework::InputRecord& inputRecord);
+  void printRDHs(o2::framework::InputRecord& inputRecord);
+
+  /// RDHs read by one worker of mPageScheduler
+  struct RdhStatistics {
+    size_t rdhCounter = 0;
+    size_t totalSize = 0;
+    size_t lastPageIndex = 0;                                         // index of the last page read by the worker
+    o2::header::DAQID::ID lastSource = o2::header::DAQID::INVALID;    // source of the last page read by the worker
+    std::vector<std::pair<o2::header::DAQID::ID, uint32_t>> rdhSizes; // source and memory size of each RDH
+    std::vector<std::string> errors;
+
+    void clear();
+  };
 
   // ** general information
 
   std::map<o2::header::DAQID::ID, std::string> mSystems;
   std::set<o2::header::DAQID::ID> mToBePublished; // keep the list of detectors we saw this cycle and whose plots should be published
+  std::unique_ptr<o2::quality_control::core::RawPageScheduler> mPageScheduler;
+  std::vector<RdhStatistics> mRdhStatistics; // one per worker of mPageScheduler
 
   // ** objects we publish **
 
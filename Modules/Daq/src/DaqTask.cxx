@@ -26,6 +26,8 @@
 #include <Framework/InputRecord.h>
 #include <Framework/InputRecordWalker.h>
 #include <Headers/DataHeaderHelpers.h>
+// STL
+#include <algorithm>
 
 using namespace std;
 using namespace o2::raw;
@@ -80,6 +82,13 @@ void DaqTask::initialize(o2::framework::InitContext& /*ctx*/)
   }
   mSystems[DAQID::INVALID] = "UNKNOWN"; // to store RDH info for unknown detectors
 
+  size_t nThreads = 1;
+  if (auto param = mCustomParameters.find("nThreads"); param != mCustomParameters.end()) {
+    nThreads = std::max(1, std::stoi(param->second));
+  }
+  mPageScheduler = std::make_unique<RawPageScheduler>(nThreads);
+  mRdhStatistics.resize(mPageScheduler->getNumberOfWorkers());
+
   // subsystems plots: distribution of rdh size, distribution of the sum of rdh in each message.
   for (const auto& system : mSystems) {
     string name = system.second + "/sumRdhSizesPerInputRecord";
@@ -235,20 +244,81 @@ void printPage(const DPLRawParser::Iterator<const DataRef>& data)
   ILOG(Info, Ops) << "    offset of payload in the raw page: " << (void*)offset << ENDM;
 }
 
+void DaqTask::RdhStatistics::clear()
+{
+  rdhCounter = 0;
+  totalSize = 0;
+  lastPageIndex = 0;
+  lastSource = DAQID::INVALID;
+  rdhSizes.clear();
+  errors.clear();
+}
+
 void DaqTask::monitorRDHs(o2::framework::InputRecord& inputRecord)
 {
-  // Use the DPLRawParser to get information about the Pages and RDHs stored in the inputRecord
-  o2::framework::DPLRawParser parser(inputRecord);
+  if ((mCustomParameters.count("printPageInfo") > 0 && mCustomParameters["printPageInfo"] == "true") ||
+      (mCustomParameters.count("printRDH") > 0 && mCustomParameters["printRDH"] == "true")) {
+    printRDHs(inputRecord);
+  }
+
+  // The RDHs are read link by link by the workers of the scheduler, then their statistics are merged.
   size_t rdhCounter = 0;
   size_t totalSize = 0;
+  size_t lastPageIndex = 0;
   DAQID::ID rdhSource = DAQID::INVALID;
-  for (auto it = parser.begin(), end = parser.end(); it != end; ++it) {
-    // TODO for some reason this does not work
-    //    ILOG(Info, Ops) << "Header: " << ENDM;
-    //    const auto* header = o2::header::get<header::DataHeader*>(it.o2DataHeader());
-    //    header->print();
-    //    it.o2DataHeader()->print();
+  mPageScheduler->run(
+    inputRecord, mRdhStatistics,
+    [](RdhStatistics& statistics, const RawPage& page) {
+      try {
+        DAQID::ID source = RDHUtils::getVersion(page.rdh) >= 6 ? RDHUtils::getSourceID(page.rdh) : DAQID::INVALID; // there is no sourceID before v6
+        if (!isDetIdValid(source)) {                                                                                // if we found it , is it valid ?
+          source = DAQID::INVALID;
+        }
+        const auto memorySize = RDHUtils::getMemorySize(page.rdh);
+        statistics.totalSize += memorySize;
+        statistics.rdhCounter++;
+        statistics.rdhSizes.emplace_back(source, memorySize);
+        if (page.index >= statistics.lastPageIndex) {
+          statistics.lastPageIndex = page.index;
+          statistics.lastSource = source;
+        }
+      } catch (std::runtime_error& e) {
+        statistics.errors.emplace_back(e.what());
+      }
+    },
+    [&](RdhStatistics& statistics) {
+      for (const auto& [source, memorySize] : statistics.rdhSizes) {
+        mSubSystemsRdhSizes.at(source)->Fill(memorySize);
+      }
+      for (const auto& error : statistics.errors) {
+        ILOG(Error, Devel) << "Catched an exception when accessing the rdh fields: \n"
+                           << error << ENDM;
+      }
+      // the total size is attributed to the source of the last RDH, as when they were read serially
+      if (statistics.rdhCounter > 0 && (rdhCounter == 0 || statistics.lastPageIndex > lastPageIndex)) {
+        lastPageIndex = statistics.lastPageIndex;
+        rdhSource = statistics.lastSource;
+      }
+      rdhCounter += statistics.rdhCounter;
+      totalSize += statistics.totalSize;
+      statistics.clear();
+    });
+
+  mSubSystemsTotalSizes.at(rdhSource)->Fill(totalSize);
+
+  // TODO make this optional once we are able to know the run number and the detectors included.
+  mToBePublished.insert(rdhSource);
 
+  // TODO why is the payload size reported by the dataref.header->print() different than the one from the sum
+  //      of the RDH memory size + dataref header size ? a few hundreds bytes difference.
+  mNumberRDHs->Fill(rdhCounter);
+}
+
+void DaqTask::printRDHs(o2::framework::InputRecord& inputRecord)
+{
+  // Use the DPLRawParser to get information about the Pages and RDHs stored in the inputRecord
+  o2::framework::DPLRawParser parser(inputRecord);
+  for (auto it = parser.begin(), end = parser.end(); it != end; ++it) {
     // print page
     if (mCustomParameters.count("printPageInfo") > 0 && mCustomParameters["printPageInfo"] == "true") {
       printPage(it);
@@ -266,30 +336,7 @@ void DaqTask::monitorRDHs(o2::framework::InputRecord& inputRecord)
       ILOG(Info, Ops) << "RDH: " << ENDM;
       RDHUtils::printRDH(rdh);
     }
-
-    // RDH plots
-    try {
-      rdhSource = RDHUtils::getVersion(rdh) >= 6 ? RDHUtils::getSourceID(rdh) : DAQID::INVALID; // there is no sourceID before v6
-      if (!isDetIdValid(rdhSource)) {                                                           // if we found it , is it valid ?
-        rdhSource = DAQID::INVALID;
-      }
-      totalSize += RDHUtils::getMemorySize(rdh);
-      rdhCounter++;
-      mSubSystemsRdhSizes.at(rdhSource)->Fill(RDHUtils::getMemorySize(rdh));
-    } catch (std::runtime_error& e) {
-      ILOG(Error, Devel) << "Catched an exception when accessing the rdh fields: \n"
-                         << e.what() << ENDM;
-    }
   }
-
-  mSubSystemsTotalSizes.at(rdhSource)->Fill(totalSize);
-
-  // TODO make this optional once we are able to know the run number and the detectors included.
-  mToBePublished.insert(rdhSource);
-
-  // TODO why is the payload size reported by the dataref.header->print() different than the one from the sum
-  //      of the RDH memory size + dataref header size ? a few hundreds bytes difference.
-  mNumberRDHs->Fill(rdhCounter);
 }
 
 } // namespace o2::quality_control_modules::daq
@@ -21,6 +21,8 @@
 #include "EMCALBase/Mapper.h"
 #include <memory>
 #include <array>
+#include <cstdint>
+#include <vector>
 
 class TH1F;
 class TH2F;
@@ -53,25 +55,63 @@ class RawTask final : public TaskInterface
   void reset() override;
 
  private:
+  static constexpr int kNSupermodules = 20;
+  static constexpr int kNCols = 48;
+  static constexpr int kNRows = 24;
+  static constexpr int kNCells = kNCols * kNRows;
+  /// Monitored trigger classes, they index the histograms together with the supermodule
+  enum TriggerClass { kTrgCAL,
+                      kTrgPHYS,
+                      kNTriggerClasses };
+  static constexpr int kNHistograms = kNTriggerClasses * kNSupermodules;
+  using SMHistograms1D = std::array<TH1*, kNHistograms>;
+  using SMHistograms2D = std::array<TProfile2D*, kNHistograms>;
+
+  /// Sums of the values filled into the cells of one kind of per-SM profile, kept until the end of the cycle
+  struct CellAccumulator {
+    std::vector<uint32_t> mEntries;
+    std::vector<double> mSums;
+    std::vector<double> mSumSquares;
+
+    CellAccumulator() : mEntries(kNHistograms * kNCells), mSums(kNHistograms * kNCells), mSumSquares(kNHistograms * kNCells) {}
+    void fill(int index, double value)
+    {
+      mEntries[index]++;
+      mSums[index] += value;
+      mSumSquares[index] += value * value;
+    }
+    void reset();
+  };
+
+  /// \return the trigger class of the trigger bits of an RDH, -1 if it is not monitored
+  static int getTriggerClass(uint32_t triggerType);
+  static int getHistogramIndex(int triggerClass, int supermodule) { return triggerClass * kNSupermodules + supermodule; }
+  /// Adds the accumulated cells to the profiles and clears the accumulator
+  static void flushCellAccumulator(CellAccumulator& accumulator, SMHistograms2D& profiles);
+
   TH1F* mHistogram = nullptr;
   TH1* mMessageCounter = nullptr;
   TH1* mNumberOfSuperpagesPerMessage;
   TH1* mNumberOfPagesPerMessage;
-  TH1* mSuperpageCounter = nullptr;                               ///< Counter for number of superpages
-  TH1* mPageCounter = nullptr;                                    ///< Counter for number of pages (headers)
-  TH1* mTotalDataVolume = nullptr;                                ///< Total data volume
-  std::map<std::string, std::array<TH1*, 20>> mRawAmplitudeEMCAL; /////< Raw amplitude in EMCAL
-  std::map<std::string, std::array<TH1*, 20>> mRawAmplMaxEMCAL;   ///< Max Raw amplitude in EMCAL per cell
-  std::map<std::string, std::array<TH1*, 20>> mRawAmplMinEMCAL;   ///< Min Raw amplitude in EMCAL per cell
-  std::map<std::string, std::array<TProfile2D*, 20>> mRMSperSM;   ///< ADC rms per SM
-  std::map<std::string, std::array<TProfile2D*, 20>> mMEANperSM;  ///< ADC mean per SM
-  std::map<std::string, std::array<TProfile2D*, 20>> mMAXperSM;   ///< ADC max per SM
-  std::map<std::string, std::array<TProfile2D*, 20>> mMINperSM;   ///< ADC min per SM
-  std::unique_ptr<o2::emcal::MappingHandler> mMappings;           ///< Mappings Hardware address -> Channel
-  TH2F* mErrorTypeAltro = nullptr;                                ///< Error from AltroDecoder
-  TH2F* mPayloadSizePerDDL = nullptr;                             ///< Payload size per ddl
-  Int_t mNumberOfSuperpages = 0;                                  ///< Simple total superpage counter
-  Int_t mNumberOfPages = 0;                                       ///< Simple total number of superpages counter
+  TH1* mSuperpageCounter = nullptr;                     ///< Counter for number of superpages
+  TH1* mPageCounter = nullptr;                          ///< Counter for number of pages (headers)
+  TH1* mTotalDataVolume = nullptr;                      ///< Total data volume
+  SMHistograms1D mRawAmplitudeEMCAL = { nullptr };      ///< Raw amplitude in EMCAL
+  SMHistograms1D mRawAmplMaxEMCAL = { nullptr };        ///< Max Raw amplitude in EMCAL per cell
+  SMHistograms1D mRawAmplMinEMCAL = { nullptr };        ///< Min Raw amplitude in EMCAL per cell
+  SMHistograms2D mRMSperSM = { nullptr };               ///< ADC rms per SM
+  SMHistograms2D mMEANperSM = { nullptr };              ///< ADC mean per SM
+  SMHistograms2D mMAXperSM = { nullptr };               ///< ADC max per SM
+  SMHistograms2D mMINperSM = { nullptr };               ///< ADC min per SM
+  CellAccumulator mRMSAccumulator;                      ///<! Cells of mRMSperSM filled since the last flush
+  CellAccumulator mMEANAccumulator;                     ///<! Cells of mMEANperSM filled since the last flush
+  CellAccumulator mMAXAccumulator;                      ///<! Cells of mMAXperSM filled since the last flush
+  CellAccumulator mMINAccumulator;                      ///<! Cells of mMINperSM filled since the last flush
+  std::unique_ptr<o2::emcal::MappingHandler> mMappings; ///< Mappings Hardware address -> Channel
+  TH2F* mErrorTypeAltro = nullptr;                      ///< Error from AltroDecoder
+  TH2F* mPayloadSizePerDDL = nullptr;                   ///< Payload size per ddl
+  Int_t mNumberOfSuperpages = 0;                        ///< Simple total superpage counter
+  Int_t mNumberOfPages = 0;                             ///< Simple total number of superpages counter
   Int_t mNumberOfMessages = 0;
 };
 
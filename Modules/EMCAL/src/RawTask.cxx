@@ -17,8 +17,9 @@
 #include <TCanvas.h>
 #include <TH1.h>
 #include <TProfile2D.h>
-#include <TMath.h>
+#include <algorithm>
 #include <cfloat>
+#include <cmath>
 
 #include "QualityControl/QcInfoLogger.h"
 #include "DetectorsRaw/RDHUtils.h"
@@ -35,6 +36,43 @@ using namespace o2::emcal;
 namespace o2::quality_control_modules::emcal
 {
 
+namespace
+{
+struct BunchStatistics {
+  int16_t max;
+  int16_t min;
+  double mean;
+  double rms;
+};
+
+/// Computes the statistics of the ADC samples of a bunch in a single pass, with SIMD reductions. The samples have
+/// 10 bits and a bunch has less than 1024 of them, so the extrema fit in 16 bits and the sums in 32 bits.
+BunchStatistics computeBunchStatistics(const uint16_t* adcs, size_t nSamples)
+{
+  int16_t maxADC = 0;
+  int16_t minADC = INT16_MAX;
+  int32_t sum = 0;
+  int32_t sumSquares = 0;
+#ifdef WITH_OPENMP
+#pragma omp simd reduction(max : maxADC) reduction(min : minADC) reduction(+ : sum, sumSquares)
+#endif
+  for (size_t i = 0; i < nSamples; i++) {
+    const int16_t adc = adcs[i];
+    maxADC = adc > maxADC ? adc : maxADC;
+    minADC = adc < minADC ? adc : minADC;
+    sum += adc;
+    sumSquares += int32_t(adc) * adc;
+  }
+  const double mean = double(sum) / nSamples;
+  // standard deviation with the n-1 denominator, as TMath::RMS
+  double rms = 0;
+  if (nSamples > 1) {
+    rms = std::sqrt(std::max(0., (double(sumSquares) - sum * mean) / (nSamples - 1)));
+  }
+  return { maxADC, minADC, mean, rms };
+}
+} // namespace
+
 RawTask::~RawTask()
 {
   if (mHistogram) {
@@ -62,47 +100,18 @@ RawTask::~RawTask()
     delete mErrorTypeAltro;
   }
 
-  for (auto& histos : mRawAmplitudeEMCAL) {
-    for (auto h : histos.second) {
-
-      delete h;
-    }
-  }
-
-  for (auto& histos : mRawAmplMaxEMCAL) {
-    for (auto h : histos.second) {
+  for (auto histos : { &mRawAmplitudeEMCAL, &mRawAmplMaxEMCAL, &mRawAmplMinEMCAL }) {
+    for (auto h : *histos) {
       delete h;
     }
   }
-
-  for (auto& histos : mRawAmplMinEMCAL) {
-    for (auto h : histos.second) {
-      delete h;
-    }
-  }
-  for (auto& histos : mRMSperSM) {
-    for (auto h : histos.second) {
-      delete h;
-    }
-  }
-
-  for (auto& histos : mMEANperSM) {
-    for (auto h : histos.second) {
-      delete h;
-    }
-  }
-
-  for (auto& histos : mMAXperSM) {
-    for (auto h : histos.second) {
-      delete h;
-    }
-  }
-  for (auto& histos : mMINperSM) {
-    for (auto h : histos.second) {
+  for (auto histos : { &mRMSperSM, &mMEANperSM, &mMAXperSM, &mMINperSM }) {
+    for (auto h : *histos) {
       delete h;
     }
   }
 }
+
 void RawTask::initialize(o2::framework::InitContext& /*ctx*/)
 {
   using infoCONTEXT = AliceO2::InfoLogger::InfoLoggerContext;
@@ -176,61 +185,47 @@ void RawTask::initialize(o2::framework::InitContext& /*ctx*/)
 
   //histos per SM
 
-  std::array<std::string, 2> triggers = { { "CAL", "PHYS" } };
-  for (const auto& trg : triggers) {
-    std::array<TH1*, 20> histosRawAmplEMCALSM;
-    std::array<TH1*, 20> histosRawAmplMaxEMCALSM;
-    std::array<TH1*, 20> histosRawAmplMinEMCALSM;
-    std::array<TProfile2D*, 20> histosRawAmplRmsSM;
-    std::array<TProfile2D*, 20> histosRawAmplMeanSM;
-    std::array<TProfile2D*, 20> histosRawAmplMaxSM;
-    std::array<TProfile2D*, 20> histosRawAmplMinSM;
-
-    for (auto ism = 0; ism < 20; ism++) {
-
-      histosRawAmplEMCALSM[ism] = new TH1F(Form("RawAmplitudeEMCAL_sm%d_%s", ism, trg.data()), Form(" RawAmplitudeEMCAL%d, %s", ism, trg.data()), 100, 0., 100.);
-      histosRawAmplEMCALSM[ism]->GetXaxis()->SetTitle("Raw Amplitude");
-      histosRawAmplEMCALSM[ism]->GetYaxis()->SetTitle("Counts");
-      getObjectsManager()->startPublishing(histosRawAmplEMCALSM[ism]);
-
-      histosRawAmplMaxEMCALSM[ism] = new TH1F(Form("RawAmplMaxEMCAL_sm%d_%s", ism, trg.data()), Form(" RawAmplMaxEMCAL_sm%d_%s", ism, trg.data()), 500, 0., 500.);
-      histosRawAmplMaxEMCALSM[ism]->GetXaxis()->SetTitle("Max Raw Amplitude [ADC]");
-      histosRawAmplMaxEMCALSM[ism]->GetYaxis()->SetTitle("Counts");
-      getObjectsManager()->startPublishing(histosRawAmplMaxEMCALSM[ism]);
-
-      histosRawAmplMinEMCALSM[ism] = new TH1F(Form("RawAmplMinEMCAL_sm%d_%s", ism, trg.data()), Form("RawAmplMinEMCAL_sm%d_%s", ism, trg.data()), 100, 0., 100.);
-      histosRawAmplMinEMCALSM[ism]->GetXaxis()->SetTitle("Min Raw Amplitude");
-      histosRawAmplMinEMCALSM[ism]->GetYaxis()->SetTitle("Counts");
-      getObjectsManager()->startPublishing(histosRawAmplMinEMCALSM[ism]);
-
-      histosRawAmplRmsSM[ism] = new TProfile2D(Form("RMSADCperSM%d_%s", ism, trg.data()), Form("RMSperSM%d_%s", ism, trg.data()), 48, 0, 48, 24, 0, 24);
-      histosRawAmplRmsSM[ism]->GetXaxis()->SetTitle("col");
-      histosRawAmplRmsSM[ism]->GetYaxis()->SetTitle("row");
-      getObjectsManager()->startPublishing(histosRawAmplRmsSM[ism]);
-
-      histosRawAmplMeanSM[ism] = new TProfile2D(Form("MeanADCperSM%d_%s", ism, trg.data()), Form("MeanADCperSM%d_%s", ism, trg.data()), 48, 0, 48, 24, 0, 24);
-      histosRawAmplMeanSM[ism]->GetXaxis()->SetTitle("col");
-      histosRawAmplMeanSM[ism]->GetYaxis()->SetTitle("row");
-      getObjectsManager()->startPublishing(histosRawAmplMeanSM[ism]);
-
-      histosRawAmplMaxSM[ism] = new TProfile2D(Form("MaxADCperSM%d_%s", ism, trg.data()), Form("MaxADCperSM%d_%s", ism, trg.data()), 48, 0, 47, 24, 0, 23);
-      histosRawAmplMaxSM[ism]->GetXaxis()->SetTitle("col");
-      histosRawAmplMaxSM[ism]->GetYaxis()->SetTitle("row");
-      getObjectsManager()->startPublishing(histosRawAmplMaxSM[ism]);
-
-      histosRawAmplMinSM[ism] = new TProfile2D(Form("MinADCperSM%d_%s", ism, trg.data()), Form("MinADCperSM%d_%s", ism, trg.data()), 48, 0, 47, 24, 0, 23);
-      histosRawAmplMinSM[ism]->GetXaxis()->SetTitle("col");
-      histosRawAmplMinSM[ism]->GetYaxis()->SetTitle("raw");
-      getObjectsManager()->startPublishing(histosRawAmplMinSM[ism]);
+  std::array<std::string, kNTriggerClasses> triggers = { { "CAL", "PHYS" } };
+  for (int itrg = 0; itrg < kNTriggerClasses; itrg++) {
+    const auto& trg = triggers[itrg];
+    for (auto ism = 0; ism < kNSupermodules; ism++) {
+      const int index = getHistogramIndex(itrg, ism);
+
+      mRawAmplitudeEMCAL[index] = new TH1F(Form("RawAmplitudeEMCAL_sm%d_%s", ism, trg.data()), Form(" RawAmplitudeEMCAL%d, %s", ism, trg.data()), 100, 0., 100.);
+      mRawAmplitudeEMCAL[index]->GetXaxis()->SetTitle("Raw Amplitude");
+      mRawAmplitudeEMCAL[index]->GetYaxis()->SetTitle("Counts");
+      getObjectsManager()->startPublishing(mRawAmplitudeEMCAL[index]);
+
+      mRawAmplMaxEMCAL[index] = new TH1F(Form("RawAmplMaxEMCAL_sm%d_%s", ism, trg.data()), Form(" RawAmplMaxEMCAL_sm%d_%s", ism, trg.data()), 500, 0., 500.);
+      mRawAmplMaxEMCAL[index]->GetXaxis()->SetTitle("Max Raw Amplitude [ADC]");
+      mRawAmplMaxEMCAL[index]->GetYaxis()->SetTitle("Counts");
+      getObjectsManager()->startPublishing(mRawAmplMaxEMCAL[index]);
+
+      mRawAmplMinEMCAL[index] = new TH1F(Form("RawAmplMinEMCAL_sm%d_%s", ism, trg.data()), Form("RawAmplMinEMCAL_sm%d_%s", ism, trg.data()), 100, 0., 100.);
+      mRawAmplMinEMCAL[index]->GetXaxis()->SetTitle("Min Raw Amplitude");
+      mRawAmplMinEMCAL[index]->GetYaxis()->SetTitle("Counts");
+      getObjectsManager()->startPublishing(mRawAmplMinEMCAL[index]);
+
+      mRMSperSM[index] = new TProfile2D(Form("RMSADCperSM%d_%s", ism, trg.data()), Form("RMSperSM%d_%s", ism, trg.data()), 48, 0, 48, 24, 0, 24);
+      mRMSperSM[index]->GetXaxis()->SetTitle("col");
+      mRMSperSM[index]->GetYaxis()->SetTitle("row");
+      getObjectsManager()->startPublishing(mRMSperSM[index]);
+
+      mMEANperSM[index] = new TProfile2D(Form("MeanADCperSM%d_%s", ism, trg.data()), Form("MeanADCperSM%d_%s", ism, trg.data()), 48, 0, 48, 24, 0, 24);
+      mMEANperSM[index]->GetXaxis()->SetTitle("col");
+      mMEANperSM[index]->GetYaxis()->SetTitle("row");
+      getObjectsManager()->startPublishing(mMEANperSM[index]);
+
+      mMAXperSM[index] = new TProfile2D(Form("MaxADCperSM%d_%s", ism, trg.data()), Form("MaxADCperSM%d_%s", ism, trg.data()), 48, 0, 47, 24, 0, 23);
+      mMAXperSM[index]->GetXaxis()->SetTitle("col");
+      mMAXperSM[index]->GetYaxis()->SetTitle("row");
+      getObjectsManager()->startPublishing(mMAXperSM[index]);
+
+      mMINperSM[index] = new TProfile2D(Form("MinADCperSM%d_%s", ism, trg.data()), Form("MinADCperSM%d_%s", ism, trg.data()), 48, 0, 47, 24, 0, 23);
+      mMINperSM[index]->GetXaxis()->SetTitle("col");
+      mMINperSM[index]->GetYaxis()->SetTitle("raw");
+      getObjectsManager()->startPublishing(mMINperSM[index]);
     } //loop SM
-    mRawAmplitudeEMCAL[trg] = histosRawAmplEMCALSM;
-    mRawAmplMaxEMCAL[trg] = histosRawAmplMaxEMCALSM;
-    mRawAmplMinEMCAL[trg] = histosRawAmplMinEMCALSM;
-    mRMSperSM[trg] = histosRawAmplRmsSM;
-    mMEANperSM[trg] = histosRawAmplMeanSM;
-    mMAXperSM[trg] = histosRawAmplMaxSM;
-    mMINperSM[trg] = histosRawAmplMinSM;
-
   } //loop trigger case
 }
 
@@ -291,8 +286,10 @@ void RawTask::monitorData(o2::framework::ProcessingContext& ctx)
       o2::emcal::RawReaderMemory rawreader(gsl::span(input.payload, header->payloadSize));
       uint64_t currentTrigger(0);
       bool first = true; //for the first event
-      short int maxADCSM[20];
-      short int minADCSM[20];
+      std::array<short int, kNSupermodules> maxADCSM;
+      std::array<short int, kNSupermodules> minADCSM;
+      maxADCSM.fill(0);
+      minADCSM.fill(SHRT_MAX);
       while (rawreader.hasNext()) {
         QcInfoLogger::GetInstance() << QcInfoLogger::Debug << " Processing page " << mNumberOfPages << AliceO2::InfoLogger::InfoLogger::endm;
         mNumberOfPages++;
@@ -308,13 +305,8 @@ void RawTask::monitorData(o2::framework::ProcessingContext& ctx)
 
         //trigger type
         auto triggertype = o2::raw::RDHUtils::getTriggerType(headerR);
-        bool isPhysTrigger = triggertype & o2::trigger::PhT, isCalibTrigger = triggertype & o2::trigger::Cal;
-        std::string trgClass;
-        if (isPhysTrigger)
-          trgClass = "PHYS";
-        else if (isCalibTrigger)
-          trgClass = "CAL";
-        else {
+        const int trgClass = getTriggerClass(triggertype);
+        if (trgClass < 0) {
           QcInfoLogger::GetInstance() << QcInfoLogger::Error << " Unmonitored trigger class requested " << AliceO2::InfoLogger::InfoLogger::endm;
           continue;
         }
@@ -322,9 +314,9 @@ void RawTask::monitorData(o2::framework::ProcessingContext& ctx)
         //fill histograms with max ADC for each supermodules and reset cache
         if (!first) {                       // check if it is the first event in the payload
           if (triggerBC > currentTrigger) { // new event
-            for (int sm = 0; sm < 20; sm++) {
+            for (int sm = 0; sm < kNSupermodules; sm++) {
 
-              mRawAmplitudeEMCAL[trgClass][sm]->Fill(maxADCSM[sm]);
+              mRawAmplitudeEMCAL[getHistogramIndex(trgClass, sm)]->Fill(maxADCSM[sm]);
 
               maxADCSM[sm] = 0;
               //initialize
@@ -390,6 +382,11 @@ void RawTask::monitorData(o2::framework::ProcessingContext& ctx)
           continue;
         }
         int j = feeID / 2; //SM id
+        if (j >= kNSupermodules) {
+          continue;
+        }
+        const int histIndex = getHistogramIndex(trgClass, j);
+        const int firstCell = histIndex * kNCells;
         auto& mapping = mMappings->getMappingForDDL(feeID);
         int col;
 
@@ -402,36 +399,36 @@ void RawTask::monitorData(o2::framework::ProcessingContext& ctx)
           auto chType = mapping.getChannelType(chan.getHardwareAddress());
           if (chType == CHTYP::LEDMON || chType == CHTYP::TRU)
             continue;
+          if (col < 0 || col >= kNCols || row < 0 || row >= kNRows)
+            continue;
+          const int cell = firstCell + row * kNCols + col;
 
           Short_t maxADC = 0;
           Short_t minADC = SHRT_MAX;
-          Double_t meanADC = 0;
-          Double_t rmsADC = 0;
           for (auto& bunch : chan.getBunches()) {
-            auto adcs = bunch.getADC();
-
-            auto maxADCbunch = *max_element(adcs.begin(), adcs.end());
-            if (maxADCbunch > maxADC)
-              maxADC = maxADCbunch;
-            mRawAmplMaxEMCAL[trgClass][j]->Fill(maxADCbunch); //max for each cell
-
-            auto minADCbunch = *min_element(adcs.begin(), adcs.end());
-            if (minADCbunch < minADC)
-              minADC = minADCbunch;
-            mRawAmplMinEMCAL[trgClass][j]->Fill(minADCbunch); // min for each cell
-
-            meanADC = TMath::Mean(adcs.begin(), adcs.end());
-            rmsADC = TMath::RMS(adcs.begin(), adcs.end());
-            mRMSperSM[trgClass][j]->Fill(col, row, rmsADC);
-            mMEANperSM[trgClass][j]->Fill(col, row, meanADC);
+            const auto& adcs = bunch.getADC();
+            if (adcs.empty())
+              continue;
+            auto stats = computeBunchStatistics(adcs.data(), adcs.size());
+
+            if (stats.max > maxADC)
+              maxADC = stats.max;
+            mRawAmplMaxEMCAL[histIndex]->Fill(stats.max); //max for each cell
+
+            if (stats.min < minADC)
+              minADC = stats.min;
+            mRawAmplMinEMCAL[histIndex]->Fill(stats.min); // min for each cell
+
+            mRMSAccumulator.fill(cell, stats.rms);
+            mMEANAccumulator.fill(cell, stats.mean);
           }
           if (maxADC > maxADCSM[j])
             maxADCSM[j] = maxADC;
-          mMAXperSM[trgClass][j]->Fill(col, row, maxADC);
+          mMAXAccumulator.fill(cell, maxADC);
 
           if (minADC < minADCSM[j])
             minADCSM[j] = minADC;
-          mMINperSM[trgClass][j]->Fill(col, row, minADC);
+          mMINAccumulator.fill(cell, minADC);
         } //channels
       }   //new page
     }     //header
@@ -443,6 +440,10 @@ void RawTask::monitorData(o2::framework::ProcessingContext& ctx)
 void RawTask::endOfCycle()
 {
   QcInfoLogger::GetInstance() << "endOfCycle" << AliceO2::InfoLogger::InfoLogger::endm;
+  flushCellAccumulator(mRMSAccumulator, mRMSperSM);
+  flushCellAccumulator(mMEANAccumulator, mMEANperSM);
+  flushCellAccumulator(mMAXAccumulator, mMAXperSM);
+  flushCellAccumulator(mMINAccumulator, mMINperSM);
 }
 
 void RawTask::endOfActivity(Activity& /*activity*/)
@@ -458,20 +459,70 @@ void RawTask::reset()
 
   QcInfoLogger::GetInstance() << "Resetting the histogram" << AliceO2::InfoLogger::InfoLogger::endm;
   mHistogram->Reset();
-  std::array<std::string, 2> triggers = { { "CAL", "PHYS" } };
-  for (const auto& trg : triggers) {
-    for (Int_t i = 0; i < 20; i++) {
-      mRawAmplitudeEMCAL[trg][i]->Reset();
-      mRawAmplMaxEMCAL[trg][i]->Reset();
-      mRawAmplMinEMCAL[trg][i]->Reset();
-      mRMSperSM[trg][i]->Reset();
-      mMEANperSM[trg][i]->Reset();
-      mMAXperSM[trg][i]->Reset();
-      mMINperSM[trg][i]->Reset();
-    }
+  for (Int_t i = 0; i < kNHistograms; i++) {
+    mRawAmplitudeEMCAL[i]->Reset();
+    mRawAmplMaxEMCAL[i]->Reset();
+    mRawAmplMinEMCAL[i]->Reset();
+    mRMSperSM[i]->Reset();
+    mMEANperSM[i]->Reset();
+    mMAXperSM[i]->Reset();
+    mMINperSM[i]->Reset();
+  }
+  for (auto accumulator : { &mRMSAccumulator, &mMEANAccumulator, &mMAXAccumulator, &mMINAccumulator }) {
+    accumulator->reset();
   }
   mPayloadSizePerDDL->Reset();
   mHistogram->Reset();
   mErrorTypeAltro->Reset();
 }
+
+int RawTask::getTriggerClass(uint32_t triggerType)
+{
+  if (triggerType & o2::trigger::PhT) {
+    return kTrgPHYS;
+  }
+  if (triggerType & o2::trigger::Cal) {
+    return kTrgCAL;
+  }
+  return -1;
+}
+
+void RawTask::CellAccumulator::reset()
+{
+  std::fill(mEntries.begin(), mEntries.end(), 0);
+  std::fill(mSums.begin(), mSums.end(), 0.);
+  std::fill(mSumSquares.begin(), mSumSquares.end(), 0.);
+}
+
+void RawTask::flushCellAccumulator(CellAccumulator& accumulator, SMHistograms2D& profiles)
+{
+  for (int ihist = 0; ihist < kNHistograms; ihist++) {
+    auto profile = profiles[ihist];
+    auto sumSquares = profile->GetSumw2();
+    auto binSumw2 = profile->GetBinSumw2();
+    bool filled = false;
+    for (int row = 0; row < kNRows; row++) {
+      for (int col = 0; col < kNCols; col++) {
+        const int cell = ihist * kNCells + row * kNCols + col;
+        const auto entries = accumulator.mEntries[cell];
+        if (entries == 0) {
+          continue;
+        }
+        // same bin as Fill(col, row, value), the binning of some profiles is not aligned on the cells
+        const int bin = profile->FindBin(col, row);
+        profile->AddBinContent(bin, accumulator.mSums[cell]);
+        profile->SetBinEntries(bin, profile->GetBinEntries(bin) + entries);
+        (*sumSquares)[bin] += accumulator.mSumSquares[cell];
+        if (binSumw2->GetSize() > 0) {
+          (*binSumw2)[bin] += entries;
+        }
+        filled = true;
+      }
+    }
+    if (filled) {
+      profile->ResetStats();
+    }
+  }
+  accumulator.reset();
+}
 } // namespace o2::quality_control_modules::emcal
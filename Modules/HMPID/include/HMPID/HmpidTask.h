@@ -19,6 +19,9 @@
 #include "QualityControl/TaskInterface.h"
 #include "HMPIDReconstruction/HmpidDecoder2.h"
 
+#include <memory>
+#include <vector>
+
 class TH1F;
 
 using namespace o2::quality_control::core;
@@ -50,7 +53,11 @@ class HmpidTask final : public TaskInterface
   TH1F* hPedestalSigma = nullptr;
   TH1F* hBusyTime = nullptr;
   TH1F* hEventSize = nullptr;
-  o2::hmpid::HmpidDecoder2* mDecoder = nullptr;
+
+  /// One decoder per thread. A given link is always decoded by the same decoder, which accumulates the pad
+  /// sums of its equipments, so the decoders can run in parallel. They are combined once per cycle.
+  std::vector<std::unique_ptr<o2::hmpid::HmpidDecoder2>> mDecoders;
+  int mNThreads = 1;
 };
 
 } // namespace o2::quality_control_modules::hmpid
@@ -13,10 +13,15 @@
 /// \author My Name
 ///
 
+#include <algorithm>
+
 #include <TCanvas.h>
 #include <TH1.h>
 #include <TMath.h>
 #include <Framework/InputRecord.h>
+#ifdef WITH_OPENMP
+#include <omp.h>
+#endif
 
 #include "QualityControl/QcInfoLogger.h"
 //#include "HMPID/HmpidDecodeRawMem.h"
@@ -46,8 +51,6 @@ HmpidTask::~HmpidTask()
   }
 }
 
-Int_t NumCycles = 0;
-
 void HmpidTask::initialize(o2::framework::InitContext& /*ctx*/)
 {
   ILOG(Info) << "initialize HmpidTask" << ENDM; // QcInfoLogger is used. FairMQ logs will go to there as well.
@@ -56,6 +59,13 @@ void HmpidTask::initialize(o2::framework::InitContext& /*ctx*/)
   if (auto param = mCustomParameters.find("myOwnKey"); param != mCustomParameters.end()) {
     ILOG(Info) << "Custom parameter - myOwnKey: " << param->second << ENDM;
   }
+  if (auto param = mCustomParameters.find("nThreads"); param != mCustomParameters.end()) {
+    mNThreads = std::max(1, std::stoi(param->second));
+  }
+#ifndef WITH_OPENMP
+  mNThreads = 1;
+#endif
+  ILOG(Info) << "Decoding with " << mNThreads << " thread(s)" << ENDM;
 
   hPedestalMean = new TH1F("hPedestalMean", "Pedestal Mean", 2000, 0, 2000);
   hPedestalMean->SetXTitle("Pedestal mean (ADC channel)");
@@ -96,9 +106,12 @@ void HmpidTask::startOfActivity(Activity& /*activity*/)
   hBusyTime->Reset();
   hEventSize->Reset();
 
-  mDecoder = new o2::hmpid::HmpidDecoder2(14);
-  mDecoder->init();
-  mDecoder->setVerbosity(2); // this is for Debug
+  mDecoders.clear();
+  for (int i = 0; i < mNThreads; i++) {
+    mDecoders.emplace_back(std::make_unique<o2::hmpid::HmpidDecoder2>(14));
+    mDecoders.back()->init();
+    mDecoders.back()->setVerbosity(2); // this is for Debug
+  }
 }
 
 void HmpidTask::startOfCycle()
@@ -108,69 +121,96 @@ void HmpidTask::startOfCycle()
 
 void HmpidTask::monitorData(o2::framework::ProcessingContext& ctx)
 {
-  NumCycles++;
-  mDecoder->init();
-  mDecoder->setVerbosity(2); // this is for Debug
-
+  // Dispatch the inputs to the decoders according to their link
+  std::vector<std::vector<std::pair<int32_t*, long int>>> buffers(mDecoders.size());
   for (auto&& input : ctx.inputs()) {
     // get message header
     if (input.header != nullptr && input.payload != nullptr) {
       const auto* header = header::get<header::DataHeader*>(input.header);
-      int32_t* ptrToPayload = (int32_t*)(input.payload);
-
       if (header->payloadSize < 80) {
         continue;
       }
-      mDecoder->setUpStream(ptrToPayload, (long int)header->payloadSize);
-      if (!mDecoder->decodeBufferFast()) {
-        ILOG(Error) << "Error decoding the Superpage !" << ENDM;
-      }
-      for (Int_t eq = 0; eq < 14; eq++) {
-        if (mDecoder->getAverageEventSize(eq) > 0.) {
-          hEventSize->SetBinContent(eq + 1, mDecoder->getAverageEventSize(eq) / 1000.);
-          hEventSize->SetBinError(eq + 1, 0.0000001);
-        }
-        if (mDecoder->getAverageBusyTime(eq) > 0.) {
-          hBusyTime->SetBinContent(eq + 1, mDecoder->getAverageBusyTime(eq) * 1000000);
-          hBusyTime->SetBinError(eq + 1, 0.00000001);
-        }
-        Printf("eq = %i, size = %f, busy = %f", eq, mDecoder->getAverageEventSize(eq), mDecoder->getAverageBusyTime(eq));
-        for (Int_t column = 0; column < 24; column++) {
-          for (Int_t dilogic = 0; dilogic < 10; dilogic++) {
-            for (Int_t channel = 0; channel < 48; channel++) {
-              Float_t mean = mDecoder->getChannelSum(eq, column, dilogic, channel) / mDecoder->getChannelSamples(eq, column, dilogic, channel);
-              Float_t sigma = TMath::Sqrt(mDecoder->getChannelSquare(eq, column, dilogic, channel) / mDecoder->getChannelSamples(eq, column, dilogic, channel) - mean * mean);
-              hPedestalMean->Fill(mean);
-              hPedestalSigma->Fill(sigma);
-            }
-          }
-        }
-      }
-
-      /* Access the pads
-      uint16_t   decoder.theEquipments[0..13]->padSamples[0..23][0..9][0..47]  Number of samples
-      float      decoder.theEquipments[0..13]->padSum[0..23][0..9][0..47]      Sum of the charge of all samples
-      float      decoder.theEquipments[0..13]->padSquares[0..23][0..9][0..47]  Sum of the charge squares of all samples
-'     uint16_t GetChannelSamples(int Equipment, int Column, int Dilogic, int Channel);
-      float GetChannelSum(int Equipment, int Column, int Dilogic, int Channel);
-      float GetChannelSquare(int Equipment, int Column, int Dilogic, int Channel);
-      uint16_t GetPadSamples(int Module, int Column, int Row);
-      float GetPadSum(int Module, int Column, int Row);
-      float GetPadSquares(int Module, int Column, int Row);
-      */
+      buffers[header->subSpecification % mDecoders.size()].emplace_back((int32_t*)(input.payload), (long int)header->payloadSize);
     }
   }
 
-  if (NumCycles > 50) {
-    hPedestalMean->Reset();
-    hPedestalSigma->Reset();
-    NumCycles = 0;
+  int nErrors = 0; // InfoLogger is not thread safe, we log after the parallel section
+#ifdef WITH_OPENMP
+  omp_set_num_threads(mNThreads);
+#pragma omp parallel for schedule(dynamic) reduction(+ \
+                                                     : nErrors)
+#endif
+  for (size_t d = 0; d < mDecoders.size(); d++) {
+    auto& decoder = mDecoders[d];
+    for (auto& [ptrToPayload, payloadSize] : buffers[d]) {
+      decoder->init();
+      decoder->setVerbosity(2); // this is for Debug
+      decoder->setUpStream(ptrToPayload, payloadSize);
+      if (!decoder->decodeBufferFast()) {
+        nErrors++;
+      }
+    }
   }
+  if (nErrors > 0) {
+    ILOG(Error) << "Error decoding " << nErrors << " Superpage(s) !" << ENDM;
+  }
+
+  /* Access the pads
+  uint16_t   decoder.theEquipments[0..13]->padSamples[0..23][0..9][0..47]  Number of samples
+  float      decoder.theEquipments[0..13]->padSum[0..23][0..9][0..47]      Sum of the charge of all samples
+  float      decoder.theEquipments[0..13]->padSquares[0..23][0..9][0..47]  Sum of the charge squares of all samples
+' uint16_t GetChannelSamples(int Equipment, int Column, int Dilogic, int Channel);
+  float GetChannelSum(int Equipment, int Column, int Dilogic, int Channel);
+  float GetChannelSquare(int Equipment, int Column, int Dilogic, int Channel);
+  uint16_t GetPadSamples(int Module, int Column, int Row);
+  float GetPadSum(int Module, int Column, int Row);
+  float GetPadSquares(int Module, int Column, int Row);
+  */
 }
 
 void HmpidTask::endOfCycle()
 {
   ILOG(Info) << "endOfCycle" << ENDM;
+
+  // The pedestals are computed once per cycle from the sums accumulated by all the decoders since the start of the activity
+  hPedestalMean->Reset();
+  hPedestalSigma->Reset();
+  for (Int_t eq = 0; eq < 14; eq++) {
+    Float_t eventSize = 0, busyTime = 0;
+    for (auto& decoder : mDecoders) {
+      eventSize = std::max(eventSize, decoder->getAverageEventSize(eq));
+      busyTime = std::max(busyTime, decoder->getAverageBusyTime(eq));
+    }
+    if (eventSize > 0.) {
+      hEventSize->SetBinContent(eq + 1, eventSize / 1000.);
+      hEventSize->SetBinError(eq + 1, 0.0000001);
+    }
+    if (busyTime > 0.) {
+      hBusyTime->SetBinContent(eq + 1, busyTime * 1000000);
+      hBusyTime->SetBinError(eq + 1, 0.00000001);
+    }
+    ILOG(Debug, Devel) << "eq = " << eq << ", size = " << eventSize << ", busy = " << busyTime << ENDM;
+
+    for (Int_t column = 0; column < 24; column++) {
+      for (Int_t dilogic = 0; dilogic < 10; dilogic++) {
+        for (Int_t channel = 0; channel < 48; channel++) {
+          double samples = 0, sum = 0, squares = 0;
+          for (auto& decoder : mDecoders) {
+            samples += decoder->getChannelSamples(eq, column, dilogic, channel);
+            sum += decoder->getChannelSum(eq, column, dilogic, channel);
+            squares += decoder->getChannelSquare(eq, column, dilogic, channel);
+          }
+          if (samples == 0) {
+            continue;
+          }
+          Float_t mean = sum / samples;
+          Float_t sigma = TMath::Sqrt(squares / samples - mean * mean);
+          hPedestalMean->Fill(mean);
+          hPedestalSigma->Fill(sigma);
+        }
+      }
+    }
+  }
 }
 
 void HmpidTask::endOfActivity(Activity& /*activity*/)
@@ -20,6 +20,7 @@
 #include "QualityControl/TaskInterface.h"
 #include <TH1.h>
 #include <TH2.h>
+#include <vector>
 #include <DataFormatsITSMFT/TopologyDictionary.h>
 #include <ITSBase/GeometryTGeo.h>
 
@@ -52,9 +53,26 @@ class ITSClusterTask : public TaskInterface
   void addObject(TObject* aObject);
   void getJsonParameters();
   void createAllHistos();
+  void createChipUnits();
+  void flushCounts();
 
   static constexpr int NLayer = 7;
   static constexpr int NLayerIB = 3;
+  static constexpr int NTopologyBins = 300;
+  static constexpr int NSizeBins = 50;
+
+  /// The chip (IB) or HIC (OB) which has its own histograms
+  struct Unit {
+    TH1D* size;
+    TH1D* topology;
+    Int_t* occupancy;
+  };
+  /// Counts of the clusters filled by one thread, added to the histograms by flushCounts()
+  struct ThreadCounts {
+    std::vector<uint32_t> occupancy; // per unit
+    std::vector<uint32_t> topology;  // per unit, NTopologyBins and the overflow
+    std::vector<uint32_t> size;      // per unit, NSizeBins and the overflow
+  };
 
   std::vector<TObject*> mPublishedObjects;
   TH1D* hClusterSizeIB[7][48][9];
@@ -80,6 +98,9 @@ class ITSClusterTask : public TaskInterface
   const int mNHicPerStave[NLayer] = { 1, 1, 1, 8, 8, 14, 14 };
   const int mNChipsPerHic[NLayer] = { 9, 9, 9, 14, 14, 14, 14 };
   int mEnableLayers[7];
+  std::vector<Unit> mUnits;
+  std::vector<int> mChipUnits; // index in mUnits of each chip, -1 if its layer is disabled
+  std::vector<ThreadCounts> mThreadCounts;
   o2::itsmft::TopologyDictionary mDict;
   o2::its::GeometryTGeo* mGeom;
 };
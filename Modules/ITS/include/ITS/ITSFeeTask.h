@@ -18,9 +18,14 @@
 #define QC_MODULE_ITS_ITSFEETASK_H
 
 #include "QualityControl/TaskInterface.h"
+#include "QualityControl/RawPageScheduler.h"
+#include "QualityControl/BitCounter.h"
 
 #include <TH1.h>
 #include <TH2.h>
+#include <array>
+#include <memory>
+#include <vector>
 
 class TH2I;
 class TH1I;
@@ -83,6 +88,23 @@ class ITSFeeTask final : public TaskInterface
   TString mTriggerType[mNTrigger] = { "ORBIT", "HB", "HBr", "HC", "PHYSICS", "PP", "CAL", "SOT", "EOT", "SOC", "EOC", "TF", "INT" };
   std::string mLaneStatusFlag[NFlags] = { "OK", "WARNING", "ERROR", "FAULT" }; //b00 OK, b01 WARNING, b10 ERROR, b11 FAULT
 
+  /// Counts of the flags found by one worker of mPageScheduler, per FEE, added to the histograms at the end of the cycle
+  struct FeeCounters {
+    BitCounter trigger{ NFees, mNTrigger };
+    BitCounter flag1{ NFees, 3 };
+    BitCounter index{ NFees, 4 };
+    BitCounter id{ NFees, 8 };
+    std::array<BitCounter, NFlags> laneStatus{ { { NFees, NLanes }, { NFees, NLanes }, { NFees, NLanes }, { NFees, NLanes } } };
+
+    void clear();
+  };
+  /// Counts the flags of a page in the counters of a worker
+  void countPage(FeeCounters& counters, const RawPage& page) const;
+  /// Adds the counters of a worker to the histograms and clears them
+  void addCounters(FeeCounters& counters);
+  std::unique_ptr<RawPageScheduler> mPageScheduler;
+  std::vector<FeeCounters> mFeeCounters; // one per worker of mPageScheduler
+
   TH1I* mTFInfo; //count vs TF ID
   TH2I* mTriggerVsFeeId;
   TH1I* mTrigger;
@@ -18,6 +18,8 @@
 #define QC_MODULE_ITS_ITSFHRTASK_H
 
 #include "QualityControl/TaskInterface.h"
+#include "QualityControl/BitCounter.h"
+#include "ITS/PixelHitMap.h"
 #include <ITSMFTReconstruction/ChipMappingITS.h>
 #include <ITSMFTReconstruction/PixelData.h>
 #include <ITSBase/GeometryTGeo.h>
@@ -85,7 +87,6 @@ class ITSFhrTask final : public TaskInterface
   const int ReduceFraction = 1; //TODO: move to Config file to define this number
 
   int mNThreads = 0;
-  std::unordered_map<unsigned int, int> mHitPixelID_Hash[7][48][2][14][14]; //layer, stave, substave, hic, chip
 
   o2::itsmft::RawPixelDecoder<o2::itsmft::ChipMappingITS>* mDecoder;
   ChipPixelData* mChipDataBuffer = nullptr;
@@ -98,16 +99,27 @@ class ITSFhrTask final : public TaskInterface
   int mNTrigger = 13;
   unsigned int mErrors[19] = { 0 };
   static constexpr int NTrigger = 13;
+  static constexpr int NFees = 48 * 3 + 144 * 2;
+  BitCounter mTriggerCounter{ NFees, NTrigger }; //trigger bits per FEE, added to mTriggerVsFeeid and mTriggerPlots at the end of the cycle
   int16_t partID = 0;
   int mLayer;
   int mHitCutForCheck = 100; //Hit number cut for fired pixel check in a trigger
   int mGetTFFromBinding = 0;
 
-  std::unordered_map<unsigned int, int>*** mHitPixelID_InStave /* = new std::unordered_map<unsigned int, int>**[NStaves[lay]]*/;
+  PixelHitMap*** mHitPixelID_InStave /* = new PixelHitMap**[NStaves[lay]]*/; //hits per pixel (1000 * column + row) of [stave][hic][chip]
   int** mHitnumber /* = new int*[NStaves[lay]]*/;       //IB : hitnumber[stave][chip]; OB : hitnumber[stave][hic]
   double** mOccupancy /* = new double*[NStaves[lay]]*/; //IB : occupancy[stave][chip]; OB : occupancy[stave][hic]
   int*** mErrorCount /* = new int**[NStaves[lay]]*/;    //IB : errorcount[stave][FEE][errorid]
 
+  //Fired pixels of the current TF, IB : mPixelHits[stave][0]; OB : mPixelHits[stave][hic]
+  //They are kept from one TF to the next, so that the memory is allocated only once
+  struct PixelHit {
+    int chip;           //chip in the hic
+    unsigned int pixel; //1000 * column + row
+  };
+  std::vector<std::vector<std::vector<PixelHit>>> mPixelHits;
+  std::vector<TH1D*> mOccupancyPlotTmp; //per stave occupancy, filled by multiple threads and summed afterwards
+
   TString mTriggerType[NTrigger] = { "ORBIT", "HB", "HBr", "HC", "PHYSICS", "PP", "CAL", "SOT", "EOT", "SOC", "EOC", "TF", "INT" };
 
   //General plots
@@ -10,6 +10,7 @@
 #define QC_MODULE_ITS_ITSRAWTASK_H
 
 #include "QualityControl/TaskInterface.h"
+#include "QualityControl/OccupancyMap.h"
 
 #include <TH2F.h>
 #include <TPaveText.h>
@@ -85,6 +86,14 @@ class ITSRawTask : public TaskInterface // todo add back the "final" when doxyge
   void enableLayers();
   void formatStatistics(TH2* h);
   void format2DZaxis(TH2* h);
+  void buildChipGeometry();
+
+  /// Location and direction of a chip, filled once in initialize
+  struct ChipGeometry {
+    int lay, sta, ssta, mod, chip;
+    float eta, phi;
+  };
+  std::vector<ChipGeometry> mChipGeometry; // indexed by the chip ID
 
   ChipPixelData* mChipData = nullptr;
   std::vector<ChipPixelData> mChips;
@@ -128,7 +137,7 @@ class ITSRawTask : public TaskInterface // todo add back the "final" when doxyge
   TH2I* hEtaPhiHitmap[NLayer];
   TH2D* hChipStaveOccupancy[NLayer];
   TH2I* hHicHitmap[7][48][14];
-  TH2I* hChipHitmap[7][48][14][14];
+  OccupancyMap* hChipHitmap[7][48][14][14]; // mostly empty, they are only used to compute the occupancies
   TH2I* hIBHitmap[3];
   const std::vector<o2::itsmft::Digit>* mDigits = nullptr;
 
@@ -165,8 +174,6 @@ class ITSRawTask : public TaskInterface // todo add back the "final" when doxyge
   int mTotalFileDone;
   //	int FileRest;
 
-  int mCounted;
-  int mTotalCounted = 10000;
   int mYellowed;
 };
 
@@ -0,0 +1,103 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   PixelHitMap.h
+/// \brief  Flat hash map counting the hits per pixel of a chip
+///
+
+#ifndef QC_MODULE_ITS_PIXELHITMAP_H
+#define QC_MODULE_ITS_PIXELHITMAP_H
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace o2::quality_control_modules::its
+{
+
+/// \brief Open-addressing hash map counting the hits per pixel of a chip
+///
+/// The counts are stored contiguously in order of first hit and the table only holds their indices, so that
+/// iterating goes through the fired pixels only and the memory is kept from one time frame to the next.
+/// Nothing is allocated until the first hit, which matters as there is one map per chip.
+class PixelHitMap
+{
+ public:
+  struct Entry {
+    unsigned int pixel;
+    int hits;
+  };
+
+  /// Adds one hit to the pixel
+  void increment(unsigned int pixel)
+  {
+    if ((mEntries.size() + 1) * 2 > mTable.size()) {
+      grow();
+    }
+    for (size_t slot = hash(pixel);; slot = (slot + 1) & (mTable.size() - 1)) {
+      const int index = mTable[slot];
+      if (index < 0) {
+        mTable[slot] = static_cast<int>(mEntries.size());
+        mEntries.push_back({ pixel, 1 });
+        return;
+      }
+      if (mEntries[index].pixel == pixel) {
+        mEntries[index].hits++;
+        return;
+      }
+    }
+  }
+
+  /// Removes all the pixels, the allocated memory is kept
+  void clear()
+  {
+    if (!mEntries.empty()) {
+      std::fill(mTable.begin(), mTable.end(), -1);
+      mEntries.clear();
+    }
+  }
+
+  size_t size() const { return mEntries.size(); }
+  bool empty() const { return mEntries.empty(); }
+  std::vector<Entry>::const_iterator begin() const { return mEntries.begin(); }
+  std::vector<Entry>::const_iterator end() const { return mEntries.end(); }
+
+ private:
+  size_t hash(unsigned int pixel) const
+  {
+    // Fibonacci hashing, the upper bits are the well mixed ones
+    return static_cast<uint32_t>(pixel * 2654435769u) >> mShift;
+  }
+
+  void grow()
+  {
+    mTable.assign(mTable.empty() ? 16 : mTable.size() * 2, -1);
+    mShift = 32;
+    for (size_t n = mTable.size(); n > 1; n >>= 1) {
+      mShift--;
+    }
+    for (size_t index = 0; index < mEntries.size(); index++) {
+      size_t slot = hash(mEntries[index].pixel);
+      while (mTable[slot] >= 0) {
+        slot = (slot + 1) & (mTable.size() - 1);
+      }
+      mTable[slot] = static_cast<int>(index);
+    }
+  }
+
+  std::vector<int> mTable;     // indices in mEntries, -1 when the slot is free
+  std::vector<Entry> mEntries; // fired pixels and their number of hits
+  unsigned int mShift = 32;
+};
+
+} // namespace o2::quality_control_modules::its
+
+#endif // QC_MODULE_ITS_PIXELHITMAP_H
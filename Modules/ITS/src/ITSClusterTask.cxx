@@ -17,6 +17,7 @@
 #include "QualityControl/QcInfoLogger.h"
 #include "ITS/ITSClusterTask.h"
 
+#include <algorithm>
 #include <sstream>
 #include <TCanvas.h>
 #include <DataFormatsParameters/GRPObject.h>
@@ -87,6 +88,7 @@ void ITSClusterTask::initialize(o2::framework::InitContext& /*ctx*/)
 
   getJsonParameters();
   createAllHistos();
+  createChipUnits();
 
   publishHistos();
   //std::string dictfile = o2::base::NameConf::getAlpideClusterDictionaryFileName(o2::detectors::DetID::ITS, "", ".bin");
@@ -131,33 +133,32 @@ void ITSClusterTask::monitorData(o2::framework::ProcessingContext& ctx)
 
   for (unsigned int iROF = 0; iROF < clusRofArr.size(); iROF++) {
     const auto& ROF = clusRofArr[iROF];
+    // the histograms are not thread safe, each thread counts on its own
+#ifdef WITH_OPENMP
+    auto& counts = mThreadCounts[omp_get_thread_num()];
+#else
+    auto& counts = mThreadCounts[0];
+#endif
 
     for (int icl = ROF.getFirstEntry(); icl < ROF.getFirstEntry() + ROF.getNEntries(); icl++) {
       auto& cluster = clusArr[icl];
-      auto ChipID = cluster.getSensorID();
       int ClusterID = cluster.getPatternID();
-      int lay, sta, ssta, mod, chip;
-      mGeom->getChipId(ChipID, lay, sta, ssta, mod, chip);
-      mod = mod + (ssta * (mNHicPerStave[lay] / 2));
-
-      if (lay < 3) {
-        mClasterOccupancyIB[lay][sta][chip]++;
-        if (ClusterID < dictSize) {
-          hClusterTopologyIB[lay][sta][chip]->Fill(ClusterID);
-          hClusterSizeIB[lay][sta][chip]->Fill(mDict.getNpixels(ClusterID));
-        }
-      } else {
-        mClasterOccupancyOB[lay][sta][mod]++;
-        if (ClusterID < dictSize) {
-          hClusterSizeOB[lay][sta][mod]->Fill(mDict.getNpixels(ClusterID));
-          hClusterTopologyOB[lay][sta][mod]->Fill(ClusterID);
-        }
+      int unit = mChipUnits[cluster.getSensorID()];
+      if (unit < 0) {
+        continue;
+      }
+
+      counts.occupancy[unit]++;
+      if (ClusterID < dictSize) {
+        counts.topology[unit * (NTopologyBins + 1) + std::min(ClusterID, NTopologyBins)]++;
+        counts.size[unit * (NSizeBins + 1) + std::min(mDict.getNpixels(ClusterID), NSizeBins)]++;
       }
     }
   }
 
   mNRofs += clusRofArr.size();
   if (mNRofs >= mOccUpdateFrequency) {
+    flushCounts();
     for (Int_t iLayer = 0; iLayer < NLayer; iLayer++) {
 
       if (!mEnableLayers[iLayer])
@@ -190,6 +191,7 @@ void ITSClusterTask::monitorData(o2::framework::ProcessingContext& ctx)
 
 void ITSClusterTask::endOfCycle()
 {
+  flushCounts();
 
   std::ifstream runNumberFile(mRunNumberPath.c_str()); //catching ITS run number in commissioning; to be redesinged for the final version
   if (runNumberFile) {
@@ -212,6 +214,11 @@ void ITSClusterTask::endOfActivity(Activity& /*activity*/)
 void ITSClusterTask::reset()
 {
   QcInfoLogger::GetInstance() << "Resetting the histogram" << AliceO2::InfoLogger::InfoLogger::endm;
+  for (auto& counts : mThreadCounts) {
+    std::fill(counts.occupancy.begin(), counts.occupancy.end(), 0);
+    std::fill(counts.topology.begin(), counts.topology.end(), 0);
+    std::fill(counts.size.begin(), counts.size.end(), 0);
+  }
   for (Int_t iLayer = 0; iLayer < NLayer; iLayer++) {
     if (!mEnableLayers[iLayer])
       continue;
@@ -258,12 +265,12 @@ void ITSClusterTask::createAllHistos()
 
       for (Int_t iStave = 0; iStave < mNStaves[iLayer]; iStave++) {
         for (Int_t iChip = 0; iChip < mNChipsPerHic[iLayer]; iChip++) {
-          hClusterSizeIB[iLayer][iStave][iChip] = new TH1D(Form("Layer%d/Stave%d/CHIP%d/ClusterSize", iLayer, iStave, iChip), Form("Layer%dStave%dCHIP%dClusterSize", iLayer, iStave, iChip), 50, 0, 50);
+          hClusterSizeIB[iLayer][iStave][iChip] = new TH1D(Form("Layer%d/Stave%d/CHIP%d/ClusterSize", iLayer, iStave, iChip), Form("Layer%dStave%dCHIP%dClusterSize", iLayer, iStave, iChip), NSizeBins, 0, NSizeBins);
           hClusterSizeIB[iLayer][iStave][iChip]->SetTitle(Form("Cluster Size on Layer %d Stave %d Chip %d", iLayer, iStave, iChip));
           addObject(hClusterSizeIB[iLayer][iStave][iChip]);
           formatAxes(hClusterSizeIB[iLayer][iStave][iChip], "Cluster size (Pixel)", "Counts", 1, 1.10);
 
-          hClusterTopologyIB[iLayer][iStave][iChip] = new TH1D(Form("Layer%d/Stave%d/CHIP%d/ClusterTopology", iLayer, iStave, iChip), Form("Layer%dStave%dCHIP%dClusterTopology", iLayer, iStave, iChip), 300, 0, 300);
+          hClusterTopologyIB[iLayer][iStave][iChip] = new TH1D(Form("Layer%d/Stave%d/CHIP%d/ClusterTopology", iLayer, iStave, iChip), Form("Layer%dStave%dCHIP%dClusterTopology", iLayer, iStave, iChip), NTopologyBins, 0, NTopologyBins);
           hClusterTopologyIB[iLayer][iStave][iChip]->SetTitle(Form("Cluster Toplogy on Layer %d Stave %d Chip %d", iLayer, iStave, iChip));
           addObject(hClusterTopologyIB[iLayer][iStave][iChip]);
           formatAxes(hClusterTopologyIB[iLayer][iStave][iChip], "Cluster toplogy (ID)", "Counts", 1, 1.10);
@@ -284,12 +291,12 @@ void ITSClusterTask::createAllHistos()
 
       for (Int_t iStave = 0; iStave < mNStaves[iLayer]; iStave++) {
         for (Int_t iHic = 0; iHic < mNHicPerStave[iLayer]; iHic++) {
-          hClusterSizeOB[iLayer][iStave][iHic] = new TH1D(Form("Layer%d/Stave%d/HIC%d/ClusterSize", iLayer, iStave, iHic), Form("Layer%dStave%dHIC%dClusterSize", iLayer, iStave, iHic), 50, 0, 50);
+          hClusterSizeOB[iLayer][iStave][iHic] = new TH1D(Form("Layer%d/Stave%d/HIC%d/ClusterSize", iLayer, iStave, iHic), Form("Layer%dStave%dHIC%dClusterSize", iLayer, iStave, iHic), NSizeBins, 0, NSizeBins);
           hClusterSizeOB[iLayer][iStave][iHic]->SetTitle(Form("Cluster Size on Layer %d Stave %d HIC %d", iLayer, iStave, iHic));
           addObject(hClusterSizeOB[iLayer][iStave][iHic]);
           formatAxes(hClusterSizeOB[iLayer][iStave][iHic], "Cluster size (Pixel)", "Counts", 1, 1.10);
 
-          hClusterTopologyOB[iLayer][iStave][iHic] = new TH1D(Form("Layer%d/Stave%d/HIC%d/ClusterTopology", iLayer, iStave, iHic), Form("Layer%dStave%dHIC%dClusterTopology", iLayer, iStave, iHic), 300, 0, 300);
+          hClusterTopologyOB[iLayer][iStave][iHic] = new TH1D(Form("Layer%d/Stave%d/HIC%d/ClusterTopology", iLayer, iStave, iHic), Form("Layer%dStave%dHIC%dClusterTopology", iLayer, iStave, iHic), NTopologyBins, 0, NTopologyBins);
           hClusterTopologyOB[iLayer][iStave][iHic]->SetTitle(Form("Cluster Toplogy on Layer %d Stave %d HIC %d", iLayer, iStave, iHic));
           addObject(hClusterTopologyOB[iLayer][iStave][iHic]);
           formatAxes(hClusterTopologyOB[iLayer][iStave][iHic], "Cluster toplogy (ID)", "Counts", 1, 1.10);
@@ -299,6 +306,80 @@ void ITSClusterTask::createAllHistos()
   }
 }
 
+void ITSClusterTask::createChipUnits()
+{
+  // the geometry is looked up once per chip instead of once per cluster
+  mUnits.clear();
+  mChipUnits.assign(mGeom->getNumberOfChips(), -1);
+  int hicUnits[7][48][14]; // the chips of an OB HIC share its unit
+  std::fill_n(&hicUnits[0][0][0], 7 * 48 * 14, -1);
+  for (int ChipID = 0; ChipID < mGeom->getNumberOfChips(); ChipID++) {
+    int lay, sta, ssta, mod, chip;
+    mGeom->getChipId(ChipID, lay, sta, ssta, mod, chip);
+    mod = mod + (ssta * (mNHicPerStave[lay] / 2));
+    if (!mEnableLayers[lay]) {
+      continue;
+    }
+    if (lay < 3) {
+      mUnits.push_back({ hClusterSizeIB[lay][sta][chip], hClusterTopologyIB[lay][sta][chip], &mClasterOccupancyIB[lay][sta][chip] });
+    } else if (hicUnits[lay][sta][mod] < 0) {
+      mUnits.push_back({ hClusterSizeOB[lay][sta][mod], hClusterTopologyOB[lay][sta][mod], &mClasterOccupancyOB[lay][sta][mod] });
+      hicUnits[lay][sta][mod] = mUnits.size() - 1;
+    } else {
+      mChipUnits[ChipID] = hicUnits[lay][sta][mod];
+      continue;
+    }
+    *mUnits.back().occupancy = 0;
+    mChipUnits[ChipID] = mUnits.size() - 1;
+  }
+
+  mThreadCounts.resize(std::max(mNThreads, 1));
+  for (auto& counts : mThreadCounts) {
+    counts.occupancy.assign(mUnits.size(), 0);
+    counts.topology.assign(mUnits.size() * (NTopologyBins + 1), 0);
+    counts.size.assign(mUnits.size() * (NSizeBins + 1), 0);
+  }
+}
+
+void ITSClusterTask::flushCounts()
+{
+  // The values filled are the integers at the lower edges of the bins, so the statistics which TH1::Fill
+  // would have accumulated are recomputed exactly from the counts. The overflows only count as entries.
+  auto add = [this](TH1D* histogram, int nBins, size_t offset, std::vector<uint32_t> ThreadCounts::*array) {
+    double stats[TH1::kNstat] = { 0 };
+    histogram->GetStats(stats);
+    double entries = histogram->GetEntries();
+    for (auto& counts : mThreadCounts) {
+      auto* bins = (counts.*array).data() + offset;
+      for (int bin = 0; bin <= nBins; bin++) {
+        if (bins[bin] == 0) {
+          continue;
+        }
+        histogram->AddBinContent(bin + 1, bins[bin]);
+        entries += bins[bin];
+        if (bin < nBins) {
+          stats[0] += bins[bin];
+          stats[1] += bins[bin];
+          stats[2] += 1. * bins[bin] * bin;
+          stats[3] += 1. * bins[bin] * bin * bin;
+        }
+        bins[bin] = 0;
+      }
+    }
+    histogram->PutStats(stats);
+    histogram->SetEntries(entries);
+  };
+
+  for (size_t unit = 0; unit < mUnits.size(); unit++) {
+    for (auto& counts : mThreadCounts) {
+      *mUnits[unit].occupancy += counts.occupancy[unit];
+      counts.occupancy[unit] = 0;
+    }
+    add(mUnits[unit].topology, NTopologyBins, unit * (NTopologyBins + 1), &ThreadCounts::topology);
+    add(mUnits[unit].size, NSizeBins, unit * (NSizeBins + 1), &ThreadCounts::size);
+  }
+}
+
 void ITSClusterTask::getJsonParameters()
 {
   mDictPath = mCustomParameters["clusterDictionaryPath"];
@@ -19,6 +19,7 @@
 
 #include <DPLUtils/RawParser.h>
 #include <DPLUtils/DPLRawParser.h>
+#include <algorithm>
 
 using namespace o2::framework;
 using namespace o2::header;
@@ -54,6 +55,13 @@ void ITSFeeTask::initialize(o2::framework::InitContext& /*ctx*/)
   getRunNumber();
   createFeePlots();
   setPlotsFormat();
+
+  int nThreads = 1;
+  if (auto param = mCustomParameters.find("nThreads"); param != mCustomParameters.end()) {
+    nThreads = std::max(1, std::stoi(param->second));
+  }
+  mPageScheduler = std::make_unique<RawPageScheduler>(nThreads);
+  mFeeCounters.resize(mPageScheduler->getNumberOfWorkers());
 }
 
 void ITSFeeTask::createFeePlots()
@@ -160,58 +168,8 @@ void ITSFeeTask::monitorData(o2::framework::ProcessingContext& ctx)
   start = std::chrono::high_resolution_clock::now();
 
   std::vector<InputSpec> rawDataFilter{ InputSpec{ "", ConcreteDataTypeMatcher{ "DS", "RAWDATA0" }, Lifetime::Timeframe } };
-  DPLRawParser parser(ctx.inputs(), rawDataFilter);
-  for (auto it = parser.begin(), end = parser.end(); it != end; ++it) {
-    auto const* rdh = it.get_if<o2::header::RAWDataHeaderV6>();
-    int istave = (int)(rdh->feeId & 0x00ff);
-    int ilink = (int)((rdh->feeId & 0x0f00) >> 8);
-    int ilayer = (int)((rdh->feeId & 0xf000) >> 12);
-    int ifee = 3 * StaveBoundary[ilayer] - (StaveBoundary[ilayer] - StaveBoundary[NLayerIB]) * (ilayer >= NLayerIB) + istave * (3 - (ilayer >= NLayerIB)) + ilink;
-
-    if ((int)(rdh->stop) && it.size()) { //looking into the DDW0 from the closing packet
-      auto const* ddw = reinterpret_cast<const GBTDiagnosticWord*>(it.data());
-      uint64_t laneInfo = ddw->laneWord.laneBits.laneStatus;
-      uint8_t flag1 = ddw->indexWord.indexBits.flag1;
-
-      for (int i = 0; i < 3; i++) {
-        if (flag1 >> i & 0x1) {
-          mFlag1Check->Fill(ifee, i);
-        }
-      }
-
-      uint8_t index = ddw->indexWord.indexBits.index;
-      if (index != 0) {
-        for (int i = 0; i < 4; i++) {
-          if (index >> i & 0x1) {
-            mIndexCheck->Fill(ifee, i);
-          }
-        }
-      }
-
-      uint8_t id = ddw->indexWord.indexBits.id;
-      if (id != 0xe4) {
-        for (int i = 0; i < 8; i++) {
-          if (id >> i & 0x1) {
-            mIdCheck->Fill(ifee, i);
-          }
-        }
-      }
-
-      for (int i = 0; i < NLanes; i++) {
-        int laneValue = laneInfo >> (2 * i) & 0x3;
-        if (laneValue) {
-          mLaneStatus[laneValue]->Fill(ifee, i);
-        }
-      }
-    }
-
-    for (int i = 0; i < 13; i++) {
-      if (((uint32_t)(rdh->triggerType) >> i & 1) == 1) {
-        mTrigger->Fill(i + 1);
-        mTriggerVsFeeId->Fill(ifee, i + 1);
-      }
-    }
-  }
+  mPageScheduler->split(ctx.inputs(), rawDataFilter);
+  mPageScheduler->process(mFeeCounters, [this](FeeCounters& counters, const RawPage& page) { countPage(counters, page); });
 
   mTimeFrameId = ctx.inputs().get<int>("G");
 
@@ -222,6 +180,78 @@ void ITSFeeTask::monitorData(o2::framework::ProcessingContext& ctx)
   mProcessingTime->SetBinContent(mTimeFrameId, difference);
 }
 
+namespace
+{
+/// \return the even bits of a word packed into its lower half
+uint64_t compressEvenBits(uint64_t word)
+{
+  word &= 0x5555555555555555;
+  word = (word | (word >> 1)) & 0x3333333333333333;
+  word = (word | (word >> 2)) & 0x0f0f0f0f0f0f0f0f;
+  word = (word | (word >> 4)) & 0x00ff00ff00ff00ff;
+  word = (word | (word >> 8)) & 0x0000ffff0000ffff;
+  word = (word | (word >> 16)) & 0x00000000ffffffff;
+  return word;
+}
+} // namespace
+
+void ITSFeeTask::countPage(FeeCounters& counters, const RawPage& page) const
+{
+  auto const* rdh = reinterpret_cast<const o2::header::RAWDataHeaderV6*>(page.rdh);
+  int istave = (int)(rdh->feeId & 0x00ff);
+  int ilink = (int)((rdh->feeId & 0x0f00) >> 8);
+  int ilayer = (int)((rdh->feeId & 0xf000) >> 12);
+  if (ilayer >= NLayer) {
+    return;
+  }
+  int ifee = 3 * StaveBoundary[ilayer] - (StaveBoundary[ilayer] - StaveBoundary[NLayerIB]) * (ilayer >= NLayerIB) + istave * (3 - (ilayer >= NLayerIB)) + ilink;
+  if (ifee < 0 || ifee >= NFees) {
+    return;
+  }
+
+  if ((int)(rdh->stop) && page.payloadSize) { //looking into the DDW0 from the closing packet
+    auto const* ddw = reinterpret_cast<const GBTDiagnosticWord*>(page.payload);
+    uint64_t laneInfo = ddw->laneWord.laneBits.laneStatus;
+    counters.flag1.count(ifee, ddw->indexWord.indexBits.flag1);
+    counters.index.count(ifee, ddw->indexWord.indexBits.index);
+
+    uint8_t id = ddw->indexWord.indexBits.id;
+    if (id != 0xe4) {
+      counters.id.count(ifee, id);
+    }
+
+    // one bit per lane for each status, from the two bits of the status of each lane
+    uint64_t lowBits = compressEvenBits(laneInfo);
+    uint64_t highBits = compressEvenBits(laneInfo >> 1);
+    counters.laneStatus[1].count(ifee, lowBits & ~highBits);
+    counters.laneStatus[2].count(ifee, highBits & ~lowBits);
+    counters.laneStatus[3].count(ifee, lowBits & highBits);
+  }
+
+  counters.trigger.count(ifee, rdh->triggerType);
+}
+
+void ITSFeeTask::FeeCounters::clear()
+{
+  for (auto counter : { &trigger, &flag1, &index, &id }) {
+    counter->clear();
+  }
+  for (auto& counter : laneStatus) {
+    counter.clear();
+  }
+}
+
+void ITSFeeTask::addCounters(FeeCounters& counters)
+{
+  counters.trigger.transfer(mTriggerVsFeeId, mTrigger);
+  counters.flag1.transfer(mFlag1Check);
+  counters.index.transfer(mIndexCheck);
+  counters.id.transfer(mIdCheck);
+  for (int i = 0; i < NFlags; i++) {
+    counters.laneStatus[i].transfer(mLaneStatus[i]);
+  }
+}
+
 void ITSFeeTask::getRunNumber()
 {
   std::ifstream configFile("Config/ConfigFee.dat");
@@ -243,6 +273,9 @@ void ITSFeeTask::getRunNumber()
 
 void ITSFeeTask::endOfCycle()
 {
+  for (auto& counters : mFeeCounters) {
+    addCounters(counters);
+  }
   getObjectsManager()->addMetadata(mTFInfo->GetName(), "Run", mRunNumber);
   getObjectsManager()->addMetadata(mTriggerVsFeeId->GetName(), "Run", mRunNumber);
   getObjectsManager()->addMetadata(mTrigger->GetName(), "Run", mRunNumber);
@@ -256,6 +289,9 @@ void ITSFeeTask::endOfActivity(Activity& /*activity*/)
 
 void ITSFeeTask::resetGeneralPlots()
 {
+  for (auto& counters : mFeeCounters) {
+    counters.clear();
+  }
   mTFInfo->Reset();
   mTriggerVsFeeId->Reset();
   mTrigger->Reset();
@@ -69,6 +69,9 @@ ITSFhrTask::~ITSFhrTask()
     }
     delete[] mHitPixelID_InStave[istave];
   }
+  for (auto occupancyPlotTmp : mOccupancyPlotTmp) {
+    delete occupancyPlotTmp;
+  }
   delete[] mHitnumber;
   delete[] mOccupancy;
   delete[] mErrorCount;
@@ -95,7 +98,7 @@ void ITSFhrTask::initialize(o2::framework::InitContext& /*ctx*/)
 
   if (mLayer != -1) {
     //define the hitnumber, occupancy, errorcount array
-    mHitPixelID_InStave = new std::unordered_map<unsigned int, int>**[NStaves[mLayer]];
+    mHitPixelID_InStave = new PixelHitMap**[NStaves[mLayer]];
     mHitnumber = new int*[NStaves[mLayer]];
     mOccupancy = new double*[NStaves[mLayer]];
     mErrorCount = new int**[NStaves[mLayer]];
@@ -127,9 +130,9 @@ void ITSFhrTask::initialize(o2::framework::InitContext& /*ctx*/)
       for (int istave = 0; istave < NStaves[mLayer]; istave++) {
         mHitnumber[istave] = new int[nChipsPerHic[mLayer]];
         mOccupancy[istave] = new double[nChipsPerHic[mLayer]];
-        mHitPixelID_InStave[istave] = new std::unordered_map<unsigned int, int>*[nHicPerStave[mLayer]];
+        mHitPixelID_InStave[istave] = new PixelHitMap*[nHicPerStave[mLayer]];
         for (int ihic = 0; ihic < nHicPerStave[mLayer]; ihic++) {
-          mHitPixelID_InStave[istave][ihic] = new std::unordered_map<unsigned int, int>[nChipsPerHic[mLayer]];
+          mHitPixelID_InStave[istave][ihic] = new PixelHitMap[nChipsPerHic[mLayer]];
         }
         for (int ichip = 0; ichip < nChipsPerHic[mLayer]; ichip++) {
           mHitnumber[istave][ichip] = 0;
@@ -140,9 +143,9 @@ void ITSFhrTask::initialize(o2::framework::InitContext& /*ctx*/)
       for (int istave = 0; istave < NStaves[mLayer]; istave++) {
         mHitnumber[istave] = new int[nHicPerStave[mLayer]];
         mOccupancy[istave] = new double[nHicPerStave[mLayer]];
-        mHitPixelID_InStave[istave] = new std::unordered_map<unsigned int, int>*[nHicPerStave[mLayer]];
+        mHitPixelID_InStave[istave] = new PixelHitMap*[nHicPerStave[mLayer]];
         for (int ihic = 0; ihic < nHicPerStave[mLayer]; ihic++) {
-          mHitPixelID_InStave[istave][ihic] = new std::unordered_map<unsigned int, int>[nChipsPerHic[mLayer]];
+          mHitPixelID_InStave[istave][ihic] = new PixelHitMap[nChipsPerHic[mLayer]];
         }
         for (int ihic = 0; ihic < nHicPerStave[mLayer]; ihic++) {
           mHitnumber[istave][ihic] = 0;
@@ -150,6 +153,14 @@ void ITSFhrTask::initialize(o2::framework::InitContext& /*ctx*/)
         }
       }
     }
+
+    //define the buffers reused at each TF
+    mPixelHits.resize(NStaves[mLayer]);
+    for (int istave = 0; istave < NStaves[mLayer]; istave++) {
+      mPixelHits[istave].resize(nHicPerStave[mLayer]);
+      mOccupancyPlotTmp.push_back(new TH1D(Form("OccupancyTmp%d", istave), "", 300, -15, 0));
+      mOccupancyPlotTmp.back()->SetDirectory(nullptr);
+    }
   }
 }
 
@@ -366,23 +377,15 @@ void ITSFhrTask::monitorData(o2::framework::ProcessingContext& ctx)
     }
     if (lay < NLayerIB) {
       istave += StaveBoundary[lay];
+      mTriggerCounter.count((istave * 3) + ilink, rdh->triggerType);
     } else {
       istave += StaveBoundary[lay - NLayerIB];
-    }
-    for (int i = 0; i < 13; i++) {
-      if (((uint32_t)(rdh->triggerType) >> i & 1) == 1) {
-        mTriggerPlots->Fill(i + 1);
-        if (lay < NLayerIB) {
-          mTriggerVsFeeid->Fill((istave * 3) + ilink, i + 1);
-        } else {
-          mTriggerVsFeeid->Fill((3 * StaveBoundary[3]) + (istave * 2) + ilink, i + 1);
-        }
-      }
+      mTriggerCounter.count((3 * StaveBoundary[3]) + (istave * 2) + ilink, rdh->triggerType);
     }
   }
 
-  //update general information according trigger type
-  if (mTriggerPlots->GetBinContent(10) || mTriggerPlots->GetBinContent(8)) {
+  //update general information according trigger type, the counts of this cycle are not in the histogram yet
+  if (mTriggerPlots->GetBinContent(10) || mTriggerPlots->GetBinContent(8) || mTriggerCounter.getTotal(9) || mTriggerCounter.getTotal(7)) {
     if (partID / 100 < 2) {
       mInfoCanvasComm->SetBinContent(partID / 100 + 1, partID % 100 + 1, 1);
       mInfoCanvasComm->SetBinContent(partID / 100 + 1, partID % 100 + 2, 1);
@@ -395,7 +398,7 @@ void ITSFhrTask::monitorData(o2::framework::ProcessingContext& ctx)
       mInfoCanvasOBComm->SetBinContent(partID / 100 + 1 - NLayerIB, partID % 100 + 1, 1);
     }
   }
-  if (mTriggerPlots->GetBinContent(11) || mTriggerPlots->GetBinContent(9)) {
+  if (mTriggerPlots->GetBinContent(11) || mTriggerPlots->GetBinContent(9) || mTriggerCounter.getTotal(10) || mTriggerCounter.getTotal(8)) {
     if (partID / 100 < 2) {
       mInfoCanvasComm->SetBinContent(partID / 100 + 1, partID % 100 + 1, 2);
       mInfoCanvasComm->SetBinContent(partID / 100 + 1, partID % 100 + 2, 2);
@@ -406,44 +409,37 @@ void ITSFhrTask::monitorData(o2::framework::ProcessingContext& ctx)
     }
   }
 
-  //define digit hit vector
-  std::vector<Digit>** digVec = new std::vector<Digit>*[NStaves[lay]];            //IB : digVec[stave][0]; OB : digVec[stave][hic]
-  std::vector<ROFRecord>** digROFVec = new std::vector<ROFRecord>*[NStaves[lay]]; //IB : digROFVec[stave][0]; OB : digROFVec[stave][hic]
-  if (lay < NLayerIB) {
-    for (int istave = 0; istave < NStaves[lay]; istave++) {
-      digVec[istave] = new std::vector<Digit>[nHicPerStave[lay]];
-      digROFVec[istave] = new std::vector<ROFRecord>[nHicPerStave[lay]];
-    }
-  } else {
-    for (int istave = 0; istave < NStaves[lay]; istave++) {
-      digVec[istave] = new std::vector<Digit>[nHicPerStave[lay]];
-      digROFVec[istave] = new std::vector<ROFRecord>[nHicPerStave[lay]];
+  //clear the pixel hit buffers, keeping their memory
+  for (auto& stavePixelHits : mPixelHits) {
+    for (auto& hicPixelHits : stavePixelHits) {
+      hicPixelHits.clear();
     }
   }
 
-  //decode raw data and save digit hit to digit hit vector, and save hitnumber per chip/hic
+  //decode raw data and save pixel hits to the buffers, and save hitnumber per chip/hic
   while ((mChipDataBuffer = mDecoder->getNextChipData(mChipsBuffer))) {
     if (mChipDataBuffer) {
       int layer, stave, ssta, mod, chip;
       int hic = 0;
-      const auto& pixels = mChipDataBuffer->getData();
-      for (auto& pixel : pixels) {
-        if (lay < NLayerIB) {
-          stave = mChipDataBuffer->getChipID() / 9 - StaveBoundary[lay];
-          chip = mChipDataBuffer->getChipID() % 9;
-          hic = 0;
-          mHitnumber[stave][chip]++;
+      //the location is the same for all the pixels of the chip
+      if (lay < NLayerIB) {
+        stave = mChipDataBuffer->getChipID() / 9 - StaveBoundary[lay];
+        chip = mChipDataBuffer->getChipID() % 9;
+        hic = 0;
+      } else {
+        mGeom->getChipId(mChipDataBuffer->getChipID(), layer, stave, ssta, mod, chip);
+        if (lay == 3 || lay == 4) {
+          hic = mod + ssta * 4;
         } else {
-          mGeom->getChipId(mChipDataBuffer->getChipID(), layer, stave, ssta, mod, chip);
-          if (lay == 3 || lay == 4) {
-            hic = mod + ssta * 4;
-          } else {
-            hic = mod + ssta * 7;
-          }
-          mHitnumber[stave][hic]++;
+          hic = mod + ssta * 7;
         }
-        digVec[stave][hic].emplace_back(mChipDataBuffer->getChipID(), pixel.getRow(), pixel.getCol());
       }
+      const auto& pixels = mChipDataBuffer->getData();
+      auto& hicPixelHits = mPixelHits[stave][hic];
+      for (auto& pixel : pixels) {
+        hicPixelHits.push_back({ chip, 1000u * pixel.getCol() + pixel.getRow() });
+      }
+      mHitnumber[stave][lay < NLayerIB ? chip : hic] += pixels.size();
       if (lay < NLayerIB) {
         if (pixels.size() > (unsigned int)mHitCutForCheck) {
           mChipStaveEventHitCheck[lay]->Fill(chip, stave);
@@ -456,11 +452,11 @@ void ITSFhrTask::monitorData(o2::framework::ProcessingContext& ctx)
     }
   }
 
-  //calculate active staves according digit hit vector
+  //calculate active staves according pixel hit buffers
   std::vector<int> activeStaves;
   for (int i = 0; i < NStaves[lay]; i++) {
     for (int j = 0; j < nHicPerStave[lay]; j++) {
-      if (digVec[i][j].size() != 0) {
+      if (mPixelHits[i][j].size() != 0) {
         activeStaves.push_back(i);
         break;
       }
@@ -471,22 +467,14 @@ void ITSFhrTask::monitorData(o2::framework::ProcessingContext& ctx)
   omp_set_num_threads(mNThreads);
 #pragma omp parallel for schedule(dynamic)
 #endif
-  //save digit hit vector to unordered_map by openMP multiple threads
+  //save pixel hit buffers to the hit maps by openMP multiple threads
   //the reason of this step is: it will spend many time If we THnSparse::Fill the THnspase hit by hit.
-  //So we want save hit information to undordered_map and fill THnSparse by THnSparse::SetBinContent (pixel by pixel)
+  //So we want save hit information to the hit maps and fill THnSparse by THnSparse::SetBinContent (pixel by pixel)
   for (int i = 0; i < (int)activeStaves.size(); i++) {
     int istave = activeStaves[i];
-    if (lay < NLayerIB) {
-      for (auto& digit : digVec[istave][0]) {
-        mHitPixelID_InStave[istave][0][digit.getChipIndex() % 9][1000 * digit.getColumn() + digit.getRow()]++;
-      }
-    } else {
-      for (int ihic = 0; ihic < nHicPerStave[lay]; ihic++) {
-        for (auto& digit : digVec[istave][ihic]) {
-          int lay, stave, ssta, mod, chip;
-          mGeom->getChipId(digit.getChipIndex(), lay, stave, ssta, mod, chip);
-          mHitPixelID_InStave[istave][ihic][chip][1000 * digit.getColumn() + digit.getRow()]++;
-        }
+    for (int ihic = 0; ihic < nHicPerStave[lay]; ihic++) {
+      for (auto& hit : mPixelHits[istave][ihic]) {
+        mHitPixelID_InStave[istave][ihic][hit.chip].increment(hit.pixel);
       }
     }
   }
@@ -501,10 +489,9 @@ void ITSFhrTask::monitorData(o2::framework::ProcessingContext& ctx)
   //mTriggerVsFeeid->Reset();			  Trigger is statistic by ourself so we don't need reset this plot, just use TH::Fill function
   mOccupancyPlot[lay]->Reset();
 
-  //define tmp occupancy plot, which will use for multiple threads
-  TH1D** occupancyPlotTmp = new TH1D*[(int)activeStaves.size()];
+  //reset tmp occupancy plot, which will use for multiple threads
   for (int i = 0; i < (int)activeStaves.size(); i++) {
-    occupancyPlotTmp[i] = new TH1D("", "", 300, -15, 0);
+    mOccupancyPlotTmp[activeStaves[i]]->Reset();
   }
 
   int totalhit = 0;
@@ -516,7 +503,7 @@ void ITSFhrTask::monitorData(o2::framework::ProcessingContext& ctx)
   //fill Monitor Objects use openMP multiple threads, and calculate the occupancy
   for (int i = 0; i < (int)activeStaves.size(); i++) {
     int istave = activeStaves[i];
-    if (digVec[istave][0].size() < 1) {
+    if (mPixelHits[istave][0].size() < 1) {
       continue;
     }
     const auto* DecoderTmp = mDecoder;
@@ -533,12 +520,11 @@ void ITSFhrTask::monitorData(o2::framework::ProcessingContext& ctx)
           continue;
         }
         for (int ichip = 0 + (ilink * 3); ichip < (ilink * 3) + 3; ichip++) {
-          std::unordered_map<unsigned int, int>::iterator iter;
-          for (iter = mHitPixelID_InStave[istave][0][ichip].begin(); iter != mHitPixelID_InStave[istave][0][ichip].end(); iter++) {
-            int pixelPos[2] = { (int)(iter->first / 1000) + (1024 * ichip), (int)(iter->first % 1000) };
-            mStaveHitmap[lay][istave]->SetBinContent(pixelPos, (double)iter->second);
-            totalhit += (int)iter->second;
-            occupancyPlotTmp[i]->Fill(log10((double)iter->second / GBTLinkInfo->statistics.nTriggers));
+          for (const auto& [pixel, hits] : mHitPixelID_InStave[istave][0][ichip]) {
+            int pixelPos[2] = { (int)(pixel / 1000) + (1024 * ichip), (int)(pixel % 1000) };
+            mStaveHitmap[lay][istave]->SetBinContent(pixelPos, (double)hits);
+            totalhit += hits;
+            mOccupancyPlotTmp[istave]->Fill(log10((double)hits / GBTLinkInfo->statistics.nTriggers));
           }
           mOccupancy[istave][ichip] = mHitnumber[istave][ichip] / (GBTLinkInfo->statistics.nTriggers * 1024. * 512.);
         }
@@ -558,15 +544,14 @@ void ITSFhrTask::monitorData(o2::framework::ProcessingContext& ctx)
         for (int ihic = 0; ihic < ((nHicPerStave[lay] / NSubStave[lay])); ihic++) {
           for (int ichip = 0; ichip < nChipsPerHic[lay]; ichip++) {
             if (GBTLinkInfo->statistics.nTriggers > 0) {
-              std::unordered_map<unsigned int, int>::iterator iter;
-              for (iter = mHitPixelID_InStave[istave][ihic][ichip].begin(); iter != mHitPixelID_InStave[istave][ihic][ichip].end(); iter++) {
-                double pixelOccupancy = (double)iter->second;
-                occupancyPlotTmp[i]->Fill(log10(pixelOccupancy / GBTLinkInfo->statistics.nTriggers));
+              for (const auto& [pixel, hits] : mHitPixelID_InStave[istave][ihic][ichip]) {
+                double pixelOccupancy = (double)hits;
+                mOccupancyPlotTmp[istave]->Fill(log10(pixelOccupancy / GBTLinkInfo->statistics.nTriggers));
                 if (ichip < 7) {
-                  int pixelPos[2] = { (ihic * ((nChipsPerHic[lay] / 2) * NCols)) + ichip * NCols + (int)(iter->first / 1000) + 1, NRows - ((int)iter->first % 1000) - 1 + (1024 * ilink) + 1 };
+                  int pixelPos[2] = { (ihic * ((nChipsPerHic[lay] / 2) * NCols)) + ichip * NCols + (int)(pixel / 1000) + 1, NRows - ((int)pixel % 1000) - 1 + (1024 * ilink) + 1 };
                   mStaveHitmap[lay][istave]->SetBinContent(pixelPos, pixelOccupancy);
                 } else {
-                  int pixelPos[2] = { (ihic * ((nChipsPerHic[lay] / 2) * NCols)) + (nChipsPerHic[lay] / 2) * NCols - (ichip - 7) * NCols - ((int)iter->first / 1000) + 1, NRows + ((int)iter->first % 1000) + (1024 * ilink) + 1 };
+                  int pixelPos[2] = { (ihic * ((nChipsPerHic[lay] / 2) * NCols)) + (nChipsPerHic[lay] / 2) * NCols - (ichip - 7) * NCols - ((int)pixel / 1000) + 1, NRows + ((int)pixel % 1000) + (1024 * ilink) + 1 };
                   mStaveHitmap[lay][istave]->SetBinContent(pixelPos, pixelOccupancy);
                 }
               }
@@ -591,7 +576,7 @@ void ITSFhrTask::monitorData(o2::framework::ProcessingContext& ctx)
   //fill Occupancy plots, chip stave occupancy plots and error statistic plots
   for (int i = 0; i < (int)activeStaves.size(); i++) {
     int istave = activeStaves[i];
-    mOccupancyPlot[lay]->Add(occupancyPlotTmp[i]);
+    mOccupancyPlot[lay]->Add(mOccupancyPlotTmp[istave]);
     if (lay < NLayerIB) {
       for (int ichip = 0; ichip < nChipsPerHic[lay]; ichip++) {
         mChipStaveOccupancy[lay]->SetBinContent(ichip + 1, istave + 1, mOccupancy[istave][ichip]);
@@ -621,17 +606,6 @@ void ITSFhrTask::monitorData(o2::framework::ProcessingContext& ctx)
     mErrorPlots->SetBinContent(ierror + 1, feeError);
   }
 
-  //delete pointor in monitorData()
-  for (int istave = 0; istave < NStaves[mLayer]; istave++) {
-    delete[] digVec[istave];
-    delete[] digROFVec[istave];
-  }
-  delete[] digVec;
-  delete[] digROFVec;
-  for (int i = 0; i < (int)activeStaves.size(); i++) {
-    delete occupancyPlotTmp[i];
-  }
-  delete[] occupancyPlotTmp;
   //temporarily reverting to get TFId by querying binding
   //  mTimeFrameId = ctx.inputs().get<int>("G");
   //Timer LOG
@@ -655,6 +629,8 @@ void ITSFhrTask::getParameters()
 
 void ITSFhrTask::endOfCycle()
 {
+  mTriggerCounter.transfer(mTriggerVsFeeid, mTriggerPlots);
+
   std::ifstream runNumberFile("infiles/RunNumber.dat"); //catching ITS run number in commissioning
   if (runNumberFile) {
     std::string runNumber;
@@ -694,6 +670,7 @@ void ITSFhrTask::resetGeneralPlots()
   resetObject(mErrorVsFeeid);
   resetObject(mTriggerVsFeeid);
   resetObject(mTriggerPlots);
+  mTriggerCounter.clear();
   //	resetObject(mInfoCanvasComm);
   //	resetObject(mInfoCanvasOBComm);
 }
@@ -12,15 +12,19 @@
 #include "ITS/ITSRawTask.h"
 #include "ITS/ITSTaskVariables.h"
 #include <Framework/InputRecord.h>
+#include <Monitoring/Monitoring.h>
 
 #include <TGaxis.h>
 #include <TStyle.h>
 #include <TPad.h>
+
+#include <chrono>
 using o2::itsmft::Digit;
 
 using namespace std;
 using namespace o2::itsmft;
 using namespace o2::its;
+using namespace o2::monitoring;
 
 namespace o2
 {
@@ -98,9 +102,8 @@ void ITSRawTask::initialize(o2::framework::InitContext& /*ctx*/)
 {
   QcInfoLogger::GetInstance() << "initialize ITSRawTask" << AliceO2::InfoLogger::InfoLogger::endm;
 
-  o2::its::GeometryTGeo* geom = o2::its::GeometryTGeo::Instance();
-  geom->fillMatrixCache(o2::math_utils::bit2Mask(o2::math_utils::TransformType::L2G));
-  int numOfChips = geom->getNumberOfChips();
+  buildChipGeometry();
+  int numOfChips = mChipGeometry.size();
   QcInfoLogger::GetInstance() << "numOfChips = " << numOfChips << AliceO2::InfoLogger::InfoLogger::endm;
   setNChips(numOfChips);
 
@@ -152,7 +155,6 @@ void ITSRawTask::initialize(o2::framework::InitContext& /*ctx*/)
   bulb->SetFillColor(kRed);
   mTotalFileDone = 0;
   TotalHisTime = 0;
-  mCounted = 0;
   mYellowed = 0;
 }
 
@@ -168,21 +170,9 @@ void ITSRawTask::startOfCycle()
 
 void ITSRawTask::monitorData(o2::framework::ProcessingContext& ctx)
 {
-  double eta, phi;
-  int lay, sta, ssta, mod, chip;
   UShort_t col = 0, row = 0, ChipID = 0;
-  std::chrono::time_point<std::chrono::high_resolution_clock> start;
-  std::chrono::time_point<std::chrono::high_resolution_clock> startLoop;
-  std::chrono::time_point<std::chrono::high_resolution_clock> end;
-  int difference;
-
-  start = std::chrono::high_resolution_clock::now();
 
-  ofstream timefout("HisTimeGlobal.dat", ios::app);
-
-  ofstream timefout2("HisTimeLoop.dat", ios::app);
-
-  QcInfoLogger::GetInstance() << "BEEN HERE BRO" << AliceO2::InfoLogger::InfoLogger::endm;
+  auto start = std::chrono::steady_clock::now();
 
   int FileID = ctx.inputs().get<int>("File");
   int EPID = ctx.inputs().get<int>("EP");
@@ -221,32 +211,17 @@ void ITSRawTask::monitorData(o2::framework::ProcessingContext& ctx)
     }
   }
 
-  difference = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
-  //	QcInfoLogger::GetInstance() << "Before Loop = " << difference/1000.0 << "s" <<  AliceO2::InfoLogger::InfoLogger::endm;
-  timefout << "Before Loop  = " << difference / 1000.0 << "s" << std::endl;
+  auto startLoop = std::chrono::steady_clock::now();
   int i = 0;
   for (auto&& pixeldata : digits) {
-    startLoop = std::chrono::high_resolution_clock::now();
-
     ChipID = pixeldata.getChipIndex();
     col = pixeldata.getColumn();
     row = pixeldata.getRow();
-    //    mNEvent = pixeldata.getROFrame();
     mNEvent = events.get()[i].NEvent;
     i++;
-    //cout << "Event Compare: " << NEvent << ", " << NEventPre << endl;
 
     if (mNEvent % occUpdateFrequency == 0 && mNEvent > 0 && mNEvent != mNEventPre) {
       updateOccupancyPlots(mNEventPre);
-      // cout << "Carried out, " << NEventPre << endl;
-    }
-
-    // cout << "NFrame = " << NEvent  << endl;
-    if (mCounted < mTotalCounted) {
-      end = std::chrono::high_resolution_clock::now();
-      difference = std::chrono::duration_cast<std::chrono::nanoseconds>(end - startLoop).count();
-      //	QcInfoLogger::GetInstance() << "Before Geo = " << difference << "ns" <<  AliceO2::InfoLogger::InfoLogger::endm;
-      timefout2 << "Getting Value Time  = " << difference << "ns" << std::endl;
     }
 
     if (mNEvent % 1000000 == 0 && mNEvent > 0) {
@@ -258,94 +233,46 @@ void ITSRawTask::monitorData(o2::framework::ProcessingContext& ctx)
       ptNEvent->AddText(Form("Event Being Processed: %d", mNEvent));
     }
 
-    if (mCounted < mTotalCounted) {
-      end = std::chrono::high_resolution_clock::now();
-      difference = std::chrono::duration_cast<std::chrono::nanoseconds>(end - startLoop).count();
-      //	QcInfoLogger::GetInstance() << "Before Geo = " << difference << "ns" <<  AliceO2::InfoLogger::InfoLogger::endm;
-      timefout2 << "Before Geo  = " << difference << "ns" << std::endl;
-    }
-
-    gm->getChipId(ChipID, lay, sta, ssta, mod, chip);
-    // cout << "getID : " << ChipID << ", " << lay << ", " << sta << ", " << ssta << ", " << mod << ", " << chip << endl;
-    gm->fillMatrixCache(o2::math_utils::bit2Mask(o2::math_utils::TransformType::L2G));
-    const math_utils::Point3D<float> loc(0., 0., 0.);
-    auto glo = gm->getMatrixL2G(ChipID)(loc);
-
-    if (!mlayerEnable[lay]) {
+    const ChipGeometry& geo = mChipGeometry[ChipID];
+    if (!mlayerEnable[geo.lay]) {
       continue;
     }
 
-    if (mCounted < mTotalCounted) {
-      end = std::chrono::high_resolution_clock::now();
-      difference = std::chrono::duration_cast<std::chrono::nanoseconds>(end - startLoop).count();
-      //	QcInfoLogger::GetInstance() << "After Geo = " << difference << "ns" <<  AliceO2::InfoLogger::InfoLogger::endm;
-      timefout2 << "After Geo =  " << difference << "ns" << std::endl;
-    }
-
     int hicCol, hicRow;
     // Todo: check if chipID is really chip ID
-    getHicCoordinates(lay, chip, col, row, hicRow, hicCol);
-    //  if (lay == 0 && sta == 0 && ssta == 0 && mod == 0 && chip == 0) cout << ChipID << ", " << col << ", " << row << endl;
-    hHicHitmap[lay][sta][mod]->Fill(hicCol, hicRow);
-    if (lay > NLayerIB && chip > 6) {
+    getHicCoordinates(geo.lay, geo.chip, col, row, hicRow, hicCol);
+    hHicHitmap[geo.lay][geo.sta][geo.mod]->Fill(hicCol, hicRow);
+    if (geo.lay > NLayerIB && geo.chip > 6) {
       // OB HICs: take into account that chip IDs are 0 .. 6, 8 .. 14
-      hChipHitmap[lay][sta][mod][chip - 1]->Fill(col, row);
+      hChipHitmap[geo.lay][geo.sta][geo.mod][geo.chip - 1]->fill(col, row);
     } else {
-      hChipHitmap[lay][sta][mod][chip]->Fill(col, row);
-      // hIBHitmap[lay]->Fill(hicCol, row+(sta*NRowHis));
-    }
-
-    if (mCounted < mTotalCounted) {
-      end = std::chrono::high_resolution_clock::now();
-      difference = std::chrono::duration_cast<std::chrono::nanoseconds>(end - startLoop).count();
-      //	QcInfoLogger::GetInstance() << "After Geo = " << difference << "ns" <<  AliceO2::InfoLogger::InfoLogger::endm;
-      timefout2 << "Fill HitMaps =  " << difference << "ns" << std::endl;
+      hChipHitmap[geo.lay][geo.sta][geo.mod][geo.chip]->fill(col, row);
     }
 
-    if (mCounted < mTotalCounted) {
-      end = std::chrono::high_resolution_clock::now();
-      difference = std::chrono::duration_cast<std::chrono::nanoseconds>(end - startLoop).count();
-      //	QcInfoLogger::GetInstance() << "After Geo = " << difference << "ns" <<  AliceO2::InfoLogger::InfoLogger::endm;
-      timefout2 << "Before glo etaphi =  " << difference << "ns" << std::endl;
-    }
-
-    eta = glo.eta();
-    phi = glo.phi();
-    hEtaPhiHitmap[lay]->Fill(eta, phi);
-
-    if (mCounted < mTotalCounted) {
-      end = std::chrono::high_resolution_clock::now();
-      difference = std::chrono::duration_cast<std::chrono::nanoseconds>(end - startLoop).count();
-      //	QcInfoLogger::GetInstance() << "After Geo = " << difference << "ns" <<  AliceO2::InfoLogger::InfoLogger::endm;
-      timefout2 << "After glo etaphi =  " << difference << "ns" << std::endl;
-      mCounted = mCounted + 1;
-    }
+    hEtaPhiHitmap[geo.lay]->Fill(geo.eta, geo.phi);
 
     mNEventPre = mNEvent;
 
   } // end digits loop
-  i = 0;
+  auto endLoop = std::chrono::steady_clock::now();
+
   if (mNEventPre > 0) {
     updateOccupancyPlots(mNEventPre);
   }
-  //cout << "EndUpdateOcc " << NEventPre <<endl;
-  end = std::chrono::high_resolution_clock::now();
-  difference = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
-  QcInfoLogger::GetInstance() << "Time After Loop = " << difference / 1000.0 << "s"
-                              << AliceO2::InfoLogger::InfoLogger::endm;
-  timefout << "Time After Loop = " << difference / 1000.0 << "s" << std::endl;
 
   QcInfoLogger::GetInstance() << "NEventDone = " << mNEvent << AliceO2::InfoLogger::InfoLogger::endm;
-  QcInfoLogger::GetInstance() << "Test  " << AliceO2::InfoLogger::InfoLogger::endm;
 
-  digits.clear();
-
-  end = std::chrono::high_resolution_clock::now();
-  difference = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
-  TotalHisTime = TotalHisTime + difference;
-  QcInfoLogger::GetInstance() << "Time in Histogram = " << difference / 1000.0 << "s"
-                              << AliceO2::InfoLogger::InfoLogger::endm;
-  timefout << "Time in Histogram = " << difference / 1000.0 << "s" << std::endl;
+  auto end = std::chrono::steady_clock::now();
+  auto loopTime = std::chrono::duration_cast<std::chrono::microseconds>(endLoop - startLoop).count();
+  auto histogramTime = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+  TotalHisTime = TotalHisTime + histogramTime / 1000.0;
+  if (mMonitoring) {
+    mMonitoring->send(Metric{ "its_raw_task_duration" }
+                        .addValue(histogramTime, "time_in_histogram_us")
+                        .addValue(loopTime, "time_in_digit_loop_us")
+                        .addValue(digits.empty() ? 0. : loopTime * 1000. / digits.size(), "time_per_digit_ns")
+                        .addValue(static_cast<uint64_t>(digits.size()), "digits"));
+  }
 
   if (mNEvent == 0 && ChipID == 0 && row == 0 && col == 0 && mYellowed == 0) {
     bulb->SetFillColor(kYellow);
@@ -353,6 +280,25 @@ void ITSRawTask::monitorData(o2::framework::ProcessingContext& ctx)
   }
 }
 
+void ITSRawTask::buildChipGeometry()
+{
+  // The position of a chip does not change during the run, its location and the eta/phi of its centre
+  // are therefore computed once instead of for every digit.
+  o2::its::GeometryTGeo* geom = o2::its::GeometryTGeo::Instance();
+  geom->fillMatrixCache(o2::math_utils::bit2Mask(o2::math_utils::TransformType::L2G));
+  const math_utils::Point3D<float> loc(0., 0., 0.);
+
+  int numOfChips = geom->getNumberOfChips();
+  mChipGeometry.resize(numOfChips);
+  for (int iChip = 0; iChip < numOfChips; iChip++) {
+    ChipGeometry& geo = mChipGeometry[iChip];
+    geom->getChipId(iChip, geo.lay, geo.sta, geo.ssta, geo.mod, geo.chip);
+    auto glo = geom->getMatrixL2G(iChip)(loc);
+    geo.eta = glo.eta();
+    geo.phi = glo.phi();
+  }
+}
+
 void ITSRawTask::addObject(TObject* aObject, bool published)
 {
   if (!aObject) {
@@ -519,8 +465,8 @@ void ITSRawTask::createHicHistos(int aLayer, int aStave, int aHic)
   addObject(hHicHitmap[aLayer][aStave][aHic]);
 
   for (int iChip = 0; iChip < nChips; iChip++) {
-    hChipHitmap[aLayer][aStave][aHic][iChip] = new TH2I(Form("chipHitmapL%dS%dH%dC%d", aLayer, aStave, aHic, iChip),
-                                                        Form("chipHitmapL%dS%dH%dC%d", aLayer, aStave, aHic, iChip), 1024, -.5, 1023.5, 512, -.5, 511.5);
+    hChipHitmap[aLayer][aStave][aHic][iChip] = new OccupancyMap(Form("chipHitmapL%dS%dH%dC%d", aLayer, aStave, aHic, iChip),
+                                                                Form("chipHitmapL%dS%dH%dC%d", aLayer, aStave, aHic, iChip), 1024, 512);
     addObject(hChipHitmap[aLayer][aStave][aHic][iChip], false);
   }
 }
@@ -719,7 +665,7 @@ void ITSRawTask::resetHitmaps()
       for (int iHic = 0; iHic < nHicPerStave[iLayer]; iHic++) {
         hHicHitmap[iLayer][iStave][iHic]->Reset();
         for (int iChip = 0; iChip < nChipsPerHic[iLayer]; iChip++) {
-          hChipHitmap[iLayer][iStave][iHic][iChip]->Reset();
+          hChipHitmap[iLayer][iStave][iHic][iChip]->reset();
         }
       }
     }
@@ -753,23 +699,19 @@ void ITSRawTask::updateOccupancyPlots(int nEvents)
     for (int iStave = 0; iStave < NStaves[iLayer]; iStave++) {
       for (int iHic = 0; iHic < nHicPerStave[iLayer]; iHic++) {
         for (int iChip = 0; iChip < nChipsPerHic[iLayer]; iChip++) {
-          chipOccupancy = hChipHitmap[iLayer][iStave][iHic][iChip]->Integral();
+          chipOccupancy = hChipHitmap[iLayer][iStave][iHic][iChip]->getEntries();
           chipOccupancy = chipOccupancy / ((double)nEvents * (double)NPixels);
-          // cout << "chipOcc = " << hChipHitmap[iLayer][iStave][iHic][iChip]->Integral() << ", " << iLayer << ", " << iStave << ", " << iHic << ", " << iChip << endl;
+          // cout << "chipOcc = " << hChipHitmap[iLayer][iStave][iHic][iChip]->getEntries() << ", " << iLayer << ", " << iStave << ", " << iHic << ", " << iChip << endl;
           if (iLayer < NLayerIB) {
             hChipStaveOccupancy[iLayer]->Fill(iChip, iStave, chipOccupancy);
           } else {
             hChipStaveOccupancy[iLayer]->Fill(iHic, iStave, chipOccupancy / nChipsPerHic[iLayer]);
           }
-          for (int iCol = 0; iCol < NCols; iCol++) {
-            for (int iRow = 0; iRow < NRows; iRow++) {
-              pixelOccupancy = hChipHitmap[iLayer][iStave][iHic][iChip]->GetBinContent(iCol + 1, iRow + 1);
-              if (pixelOccupancy > 0) {
-                pixelOccupancy /= (double)nEvents;
-                hOccupancyPlot[iLayer]->Fill(log10(pixelOccupancy));
-              }
-            }
-          }
+          // only the fired pixels are visited, instead of the NCols x NRows of the chip
+          hChipHitmap[iLayer][iStave][iHic][iChip]->forEachFiredPixel([&](unsigned int, unsigned int, uint32_t hits) {
+            pixelOccupancy = hits / (double)nEvents;
+            hOccupancyPlot[iLayer]->Fill(log10(pixelOccupancy));
+          });
         }
       }
     }
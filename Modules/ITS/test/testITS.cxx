@@ -14,6 +14,9 @@
 ///
 
 #include "QualityControl/TaskFactory.h"
+#include "ITS/PixelHitMap.h"
+
+#include <unordered_map>
 
 #define BOOST_TEST_MODULE Publisher test
 #define BOOST_TEST_MAIN
@@ -30,6 +33,31 @@ namespace itstaskraw
 
 BOOST_AUTO_TEST_CASE(instantiate_task) { BOOST_CHECK(true); }
 
+BOOST_AUTO_TEST_CASE(pixel_hit_map)
+{
+  o2::quality_control_modules::its::PixelHitMap hitMap;
+  std::unordered_map<unsigned int, int> expected;
+  BOOST_CHECK(hitMap.empty());
+
+  for (unsigned int i = 0; i < 10000; i++) {
+    unsigned int pixel = 1000 * ((i * 7) % 1024) + (i * 13) % 512;
+    hitMap.increment(pixel);
+    expected[pixel]++;
+  }
+  BOOST_CHECK_EQUAL(hitMap.size(), expected.size());
+  for (const auto& [pixel, hits] : hitMap) {
+    BOOST_CHECK_EQUAL(hits, expected[pixel]);
+  }
+
+  hitMap.clear();
+  BOOST_CHECK(hitMap.empty());
+  hitMap.increment(1000 * 1023 + 511);
+  hitMap.increment(1000 * 1023 + 511);
+  BOOST_REQUIRE_EQUAL(hitMap.size(), 1);
+  BOOST_CHECK_EQUAL(hitMap.begin()->pixel, 1000 * 1023 + 511);
+  BOOST_CHECK_EQUAL(hitMap.begin()->hits, 2);
+}
+
 } // namespace itstaskraw
 } // namespace quality_control_modules
 } // namespace o2
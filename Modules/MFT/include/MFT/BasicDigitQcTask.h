@@ -24,6 +24,7 @@
 #include <TH2.h>
 // Quality Control
 #include "QualityControl/TaskInterface.h"
+#include "QualityControl/OccupancyMap.h"
 
 using namespace o2::quality_control::core;
 
@@ -56,8 +57,6 @@ class BasicDigitQcTask final : public TaskInterface
   //  variables
   const double gPixelHitMapsMaxBinX = 1024;
   const double gPixelHitMapsMaxBinY = 512;
-  const double gPixelHitMapsMinBin = 0;
-  const double gPixelHitMapsShift = 0.5;
   const int gPixelHitMapsBinWidth = 1;
 
   const int nHitMaps = 20;
@@ -120,7 +119,7 @@ class BasicDigitQcTask final : public TaskInterface
   std::unique_ptr<TH1F> mMFT_chip_std_dev_H = nullptr;
 
   std::vector<std::unique_ptr<TH2F>> mMFTChipHitMap;
-  std::vector<std::unique_ptr<TH2F>> mMFTPixelHitMap;
+  std::vector<std::unique_ptr<OccupancyMap>> mMFTPixelHitMap; // mostly empty, stored sparsely
 
   //  functions
   // void readTable();
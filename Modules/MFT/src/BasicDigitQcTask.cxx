@@ -95,11 +95,10 @@ void BasicDigitQcTask::initialize(o2::framework::InitContext& /*ctx*/)
     TString HistogramName = "";
     getPixelName(FolderName, HistogramName, iChipID);
 
-    auto pxlhitmap = std::make_unique<TH2F>(
+    auto pxlhitmap = std::make_unique<OccupancyMap>(
       FolderName, HistogramName,
-      gPixelHitMapsMaxBinX / gPixelHitMapsBinWidth, gPixelHitMapsMinBin - gPixelHitMapsShift, gPixelHitMapsMaxBinX - gPixelHitMapsShift,
-      gPixelHitMapsMaxBinY / gPixelHitMapsBinWidth, gPixelHitMapsMinBin - gPixelHitMapsShift, gPixelHitMapsMaxBinY - gPixelHitMapsShift);
-    pxlhitmap->SetStats(0);
+      static_cast<unsigned int>(gPixelHitMapsMaxBinX / gPixelHitMapsBinWidth), static_cast<unsigned int>(gPixelHitMapsMaxBinY / gPixelHitMapsBinWidth));
+    pxlhitmap->setStats(false);
     mMFTPixelHitMap.push_back(std::move(pxlhitmap));
     if (TaskLevel == 2 || TaskLevel == 4)
       getObjectsManager()->startPublishing(mMFTPixelHitMap[iVectorID].get());
@@ -118,7 +117,7 @@ void BasicDigitQcTask::startOfActivity(Activity& /*activity*/)
   }
 
   for (int iVectorID = 0; iVectorID < (nMaps[FLP] + nMaps[4 - FLP]); iVectorID++) {
-    mMFTPixelHitMap[iVectorID]->Reset();
+    mMFTPixelHitMap[iVectorID]->reset();
   }
 }
 
@@ -143,16 +142,16 @@ void BasicDigitQcTask::monitorData(o2::framework::ProcessingContext& ctx)
     int vectorIndex = getVectorIndex(chipIndex);
 
     // fill pixel hit maps
-    mMFTPixelHitMap[vectorIndex]->Fill(one_digit.getColumn(), one_digit.getRow());
+    mMFTPixelHitMap[vectorIndex]->fill(one_digit.getColumn(), one_digit.getRow());
     // fill overview histograms
-    mMFT_chip_index_H->SetBinContent(chipIndex + 1, mMFTPixelHitMap[vectorIndex]->GetEntries());
-    mMFT_chip_std_dev_H->SetBinContent(chipIndex + 1, mMFTPixelHitMap[vectorIndex]->GetStdDev(1));
+    mMFT_chip_index_H->SetBinContent(chipIndex + 1, mMFTPixelHitMap[vectorIndex]->getEntries());
+    mMFT_chip_std_dev_H->SetBinContent(chipIndex + 1, mMFTPixelHitMap[vectorIndex]->getStdDev(1));
     // }
   }
 
   // fill the chip hit maps
   for (int iVectorID = 0; iVectorID < (nMaps[FLP] + nMaps[4 - FLP]); iVectorID++) {
-    int nEntries = mMFTPixelHitMap[iVectorID]->GetEntries();
+    int nEntries = mMFTPixelHitMap[iVectorID]->getEntries();
     int chipID = getChipIndex(iVectorID);
 
     int HitMapID = layer[chipID] + half[chipID] * nHitMaps / 2;
@@ -185,7 +184,7 @@ void BasicDigitQcTask::reset()
   }
 
   for (int iVectorID = 0; iVectorID < (nMaps[FLP] + nMaps[4 - FLP]); iVectorID++) {
-    mMFTPixelHitMap[iVectorID]->Reset();
+    mMFTPixelHitMap[iVectorID]->reset();
   }
 }
 
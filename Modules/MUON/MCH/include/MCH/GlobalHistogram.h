@@ -9,6 +9,8 @@
 #define QC_MODULE_MUONCHAMBERS_GLOBALHISTOGRAM_H
 
 #include <map>
+#include <utility>
+#include <vector>
 #include <TH2.h>
 
 namespace o2
@@ -26,6 +28,24 @@ class GlobalHistogram : public TH2F
   void getDeCenterST4(int de, float& xB0, float& yB0, float& xNB0, float& yNB0);
   void getDeCenterST5(int de, float& xB0, float& yB0, float& xNB0, float& yNB0);
 
+  // bins of this histogram covered by one cathode of a detection element, with the range of source bins of each
+  // row and column, the ranges along X and Y being independent
+  struct GatherTable {
+    int srcNbinsX{ 0 }; // binning of the source histogram, 0 until the table is computed
+    int srcNbinsY{ 0 };
+    int binXmin{ 0 };
+    int binXmax{ -1 };
+    int binYmin{ 0 };
+    int binYmax{ -1 };
+    std::vector<std::pair<int, int>> srcBinsX; // one per destination column
+    std::vector<std::pair<int, int>> srcBinsY; // one per destination row
+  };
+  // indexed by 2 * de + cathode, computed at the first use
+  std::vector<GatherTable> mGatherTables;
+
+  const GatherTable& getGatherTable(int de, int cathode, TH2F* hist);
+  void setDE(int de, TH2F* hB, TH2F* hNB, bool doAverage, bool includeNullBins);
+
  public:
   GlobalHistogram(std::string name, std::string title);
 
@@ -39,6 +59,9 @@ class GlobalHistogram : public TH2F
 
   // replace the contents with the histograms of the individual detection elements
   void set(std::map<int, TH2F*>& histB, std::map<int, TH2F*>& histNB, bool doAverage = true, bool includeNullBins = false);
+
+  // same as set(), only for the given detection elements, the bins of the others are left untouched
+  void set(const std::vector<int>& deIds, std::map<int, TH2F*>& histB, std::map<int, TH2F*>& histNB, bool doAverage = true, bool includeNullBins = false);
 };
 
 } // namespace muonchambers
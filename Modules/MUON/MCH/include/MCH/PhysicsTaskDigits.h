@@ -16,6 +16,8 @@
 #include "MCHBase/Digit.h"
 #endif
 #include "MCH/GlobalHistogram.h"
+#include <array>
+#include <vector>
 
 class TH1F;
 class TH2F;
@@ -52,7 +54,37 @@ class PhysicsTaskDigits /*final*/ : public TaskInterface // todo add back the "f
   void reset() override;
 
  private:
+  /// \brief Pad information computed at initialization, to fill the histograms without mapping lookups
+  struct PadInfo {
+    uint16_t binXMin{ 0 }; // range of bins covered by the pad in the XY histograms
+    uint16_t binXMax{ 0 };
+    uint16_t binYMin{ 0 };
+    uint16_t binYMax{ 0 };
+    uint16_t elecBinX{ 0 }; // bin of the pad in the Elec histograms
+    uint8_t elecBinY{ 0 };
+    uint8_t cathode{ 0 };
+    uint8_t feeId{ 0 };
+    uint8_t linkId{ 0 };
+    bool hasElec{ false }; // true if the pad is connected to a FEE link
+  };
+
+  /// \brief Histograms and hit counters of one detection element
+  struct DetectionElement {
+    int deId{ 0 };
+    TH1F* histADCamplitude{ nullptr };
+    TH2F* histNhits[2]{ nullptr, nullptr };
+    TH2F* histNorbits[2]{ nullptr, nullptr };
+    TH2F* histOccupancyXY[2]{ nullptr, nullptr };
+    std::vector<PadInfo> pads;        // indexed by pad id
+    std::vector<uint32_t> padDigits;  // digits of each pad since the last projection in the histograms
+    std::vector<uint32_t> padHits;    // digits with a positive ADC of each pad since the last projection
+  };
+
+  void createPads(DetectionElement& detectionElement);
   void plotDigit(const o2::mch::Digit& digit);
+  /// adds the pad counters to the hits histograms and updates the orbits histograms of the pads
+  /// \param modifiedDEs - filled with the DEs whose hits or orbits histograms changed
+  void fillPadHistograms(std::vector<int>& modifiedDEs);
 
   o2::mch::raw::Elec2DetMapper mElec2DetMapper;
   o2::mch::raw::Det2ElecMapper mDet2ElecMapper;
@@ -84,13 +116,18 @@ class PhysicsTaskDigits /*final*/ : public TaskInterface // todo add back the "f
 
   TH2F* mHistogramNhits[1100];
   TH1F* mHistogramADCamplitude[1100];
-  std::map<int, TH1F*> mHistogramADCamplitudeDE;
   std::map<int, TH2F*> mHistogramNhitsDE[2];
   std::map<int, TH2F*> mHistogramNorbitsDE[2];
-  std::map<int, TH2F*> mHistogramOccupancyXY[2];
+
+  std::array<int, 1100> mDeIndex;                    // index of each DE in mDetectionElements, -1 if none
+  std::vector<DetectionElement> mDetectionElements;
+  std::vector<int> mElecBinXToDE;                    // DE of each X bin of the Elec histograms, -1 if none
+  bool mLinkHasHits[MCH_FEEID_NUM][12];              // true once a pad of the FEE link had a hit
+  uint32_t mLinkFilledOrbits[MCH_FEEID_NUM][12];     // orbits of the FEE link last written to the orbits histograms of its pads
 
   GlobalHistogram* mHistogramOccupancy[1];
   GlobalHistogram* mHistogramOrbits[1];
+  GlobalHistogram* mHistogramHits[1]; // not published, updated for the modified DEs and divided by the orbits
 };
 
 } // namespace muonchambers
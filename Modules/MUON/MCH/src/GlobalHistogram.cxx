@@ -351,123 +351,163 @@ void GlobalHistogram::set(std::map<int, TH2F*>& histB, std::map<int, TH2F*>& his
 {
   for (auto& ih : histB) {
     int de = ih.first;
-    //if (de != 819) continue;
-    if (de < 500)
-      continue;
-    if (de >= 1100)
-      continue;
-    auto hB = ih.second;
-    if (!hB) {
-      continue;
+    TH2F* hNB = nullptr;
+    auto jh = histNB.find(de);
+    if (jh != histNB.end()) {
+      hNB = jh->second;
     }
+    setDE(de, ih.second, hNB, doAverage, includeNullBins);
+  }
+}
 
-    bool swapX = getLR(de) == 1;
-
-    //std::cout<<"[GlobalHistogram::set] de="<<de<<"  swapX="<<swapX<<std::endl;
-
+void GlobalHistogram::set(const std::vector<int>& deIds, std::map<int, TH2F*>& histB, std::map<int, TH2F*>& histNB, bool doAverage, bool includeNullBins)
+{
+  for (auto de : deIds) {
+    auto ih = histB.find(de);
+    if (ih == histB.end()) {
+      continue;
+    }
     TH2F* hNB = nullptr;
     auto jh = histNB.find(de);
     if (jh != histNB.end()) {
       hNB = jh->second;
     }
+    setDE(de, ih->second, hNB, doAverage, includeNullBins);
+  }
+}
 
-    TH2F* hist[2] = { hB, hNB };
+const GlobalHistogram::GatherTable& GlobalHistogram::getGatherTable(int de, int cathode, TH2F* hist)
+{
+  if (mGatherTables.empty()) {
+    mGatherTables.resize(2 * 1100);
+  }
+  GatherTable& table = mGatherTables[2 * de + cathode];
+  if (table.srcNbinsX == hist->GetXaxis()->GetNbins() && table.srcNbinsY == hist->GetYaxis()->GetNbins()) {
+    return table;
+  }
 
-    float xB0, yB0, xNB0, yNB0;
-    getDeCenter(de, xB0, yB0, xNB0, yNB0);
+  table = GatherTable{};
+  table.srcNbinsX = hist->GetXaxis()->GetNbins();
+  table.srcNbinsY = hist->GetYaxis()->GetNbins();
 
-    float x0[2] = { xB0, xNB0 };
-    float y0[2] = { yB0, yNB0 };
+  bool swapX = getLR(de) == 1;
 
-    const o2::mch::mapping::Segmentation& segment = o2::mch::mapping::segmentation(de);
-    if ((&segment) == nullptr) {
-      continue;
+  float xB0, yB0, xNB0, yNB0;
+  getDeCenter(de, xB0, yB0, xNB0, yNB0);
+  float x0 = (cathode == 0) ? xB0 : xNB0;
+  float y0 = (cathode == 0) ? yB0 : yNB0;
+
+  const o2::mch::mapping::Segmentation& segment = o2::mch::mapping::segmentation(de);
+  if ((&segment) == nullptr) {
+    return table;
+  }
+  const o2::mch::mapping::CathodeSegmentation& csegment = (cathode == 0) ? segment.bending() : segment.nonBending();
+  o2::mch::contour::BBox<double> bbox = o2::mch::mapping::getBBox(csegment);
+
+  float xMin = static_cast<float>(x0 - bbox.width() / 2);
+  float xMax = static_cast<float>(x0 + bbox.width() / 2);
+  float yMin = static_cast<float>(y0 + bbox.ymin());
+  float yMax = static_cast<float>(y0 + bbox.ymax());
+
+  float binWidthX = GetXaxis()->GetBinWidth(1);
+  float binWidthY = GetYaxis()->GetBinWidth(1);
+
+  // destination bins
+  table.binXmin = GetXaxis()->FindBin(xMin + binWidthX / 2);
+  table.binXmax = GetXaxis()->FindBin(xMax - binWidthX / 2);
+  table.binYmin = GetYaxis()->FindBin(yMin + binWidthY / 2);
+  table.binYmax = GetYaxis()->FindBin(yMax - binWidthY / 2);
+
+  for (int by = table.binYmin; by <= table.binYmax; by++) {
+    // vertical boundaries of current bin, in DE coordinates
+    float minY = GetYaxis()->GetBinLowEdge(by) - y0;
+    float maxY = GetYaxis()->GetBinUpEdge(by) - y0;
+
+    // find Y bin range in source histogram
+    int srcBinYmin = hist->GetYaxis()->FindBin(minY);
+    if (hist->GetYaxis()->GetBinCenter(srcBinYmin) < minY) {
+      srcBinYmin += 1;
+    }
+    int srcBinYmax = hist->GetYaxis()->FindBin(maxY);
+    if (hist->GetYaxis()->GetBinCenter(srcBinYmax) > maxY) {
+      srcBinYmax -= 1;
     }
-    const o2::mch::mapping::CathodeSegmentation& csegmentB = segment.bending();
-    o2::mch::contour::BBox<double> bboxB = o2::mch::mapping::getBBox(csegmentB);
-    o2::mch::contour::Contour<double> envelopB = o2::mch::mapping::getEnvelop(csegmentB);
+    table.srcBinsY.emplace_back(srcBinYmin, srcBinYmax);
+  }
 
-    const o2::mch::mapping::CathodeSegmentation& csegmentNB = segment.nonBending();
-    o2::mch::contour::BBox<double> bboxNB = o2::mch::mapping::getBBox(csegmentNB);
-    o2::mch::contour::Contour<double> envelopNB = o2::mch::mapping::getEnvelop(csegmentNB);
+  for (int bx = table.binXmin; bx <= table.binXmax; bx++) {
+    // horizontal boundaries of current bin, in DE coordinates
+    float minX = GetXaxis()->GetBinLowEdge(bx) - x0;
+    float maxX = GetXaxis()->GetBinUpEdge(bx) - x0;
 
-    float xMin[2] = { static_cast<float>(xB0 - bboxB.width() / 2), static_cast<float>(xNB0 - bboxNB.width() / 2) };
-    float xMax[2] = { static_cast<float>(xB0 + bboxB.width() / 2), static_cast<float>(xNB0 + bboxNB.width() / 2) };
-    float yMin[2] = { static_cast<float>(yB0 + bboxB.ymin()), static_cast<float>(yNB0 + bboxNB.ymin()) };
-    float yMax[2] = { static_cast<float>(yB0 + bboxB.ymax()), static_cast<float>(yNB0 + bboxNB.ymax()) };
+    if (swapX) {
+      float tempMax = -minX;
+      float tempMin = -maxX;
+      minX = tempMin;
+      maxX = tempMax;
+    }
 
-    float binWidthX = GetXaxis()->GetBinWidth(1);
-    float binWidthY = GetYaxis()->GetBinWidth(1);
+    // find X bin range in source histogram
+    int srcBinXmin = hist->GetXaxis()->FindBin(minX);
+    if (hist->GetXaxis()->GetBinCenter(srcBinXmin) < minX) {
+      srcBinXmin += 1;
+    }
+    int srcBinXmax = hist->GetXaxis()->FindBin(maxX);
+    if (hist->GetXaxis()->GetBinCenter(srcBinXmax) > maxX) {
+      srcBinXmax -= 1;
+    }
+    table.srcBinsX.emplace_back(srcBinXmin, srcBinXmax);
+  }
 
-    // loop on bending and non-bending planes
-    for (int i = 0; i < 2; i++) {
+  return table;
+}
 
-      if (hist[i] == nullptr) {
-        continue;
-      }
+void GlobalHistogram::setDE(int de, TH2F* hB, TH2F* hNB, bool doAverage, bool includeNullBins)
+{
+  if (de < 500 || de >= 1100) {
+    return;
+  }
+  if (!hB) {
+    return;
+  }
 
-      // loop on destination bins
-      int binXmin = GetXaxis()->FindBin(xMin[i] + binWidthX / 2);
-      int binXmax = GetXaxis()->FindBin(xMax[i] - binWidthX / 2);
-      int binYmin = GetYaxis()->FindBin(yMin[i] + binWidthY / 2);
-      int binYmax = GetYaxis()->FindBin(yMax[i] - binWidthY / 2);
-
-      for (int by = binYmin; by <= binYmax; by++) {
-        // vertical boundaries of current bin, in DE coordinates
-        float minY = GetYaxis()->GetBinLowEdge(by) - y0[i];
-        float maxY = GetYaxis()->GetBinUpEdge(by) - y0[i];
-
-        // find Y bin range in source histogram
-        int srcBinYmin = hist[i]->GetYaxis()->FindBin(minY);
-        if (hist[i]->GetYaxis()->GetBinCenter(srcBinYmin) < minY) {
-          srcBinYmin += 1;
-        }
-        int srcBinYmax = hist[i]->GetYaxis()->FindBin(maxY);
-        if (hist[i]->GetYaxis()->GetBinCenter(srcBinYmax) > maxY) {
-          srcBinYmax -= 1;
-        }
+  TH2F* hist[2] = { hB, hNB };
 
-        for (int bx = binXmin; bx <= binXmax; bx++) {
-          // horizontal boundaries of current bin, in DE coordinates
-          float minX = GetXaxis()->GetBinLowEdge(bx) - x0[i];
-          float maxX = GetXaxis()->GetBinUpEdge(bx) - x0[i];
+  // loop on bending and non-bending planes
+  for (int i = 0; i < 2; i++) {
 
-          if (swapX) {
-            float tempMax = -minX;
-            float tempMin = -maxX;
-            minX = tempMin;
-            maxX = tempMax;
-          }
+    if (hist[i] == nullptr) {
+      continue;
+    }
 
-          // find X bin range in source histogram
-          int srcBinXmin = hist[i]->GetXaxis()->FindBin(minX);
-          if (hist[i]->GetXaxis()->GetBinCenter(srcBinXmin) < minX) {
-            srcBinXmin += 1;
-          }
-          int srcBinXmax = hist[i]->GetXaxis()->FindBin(maxX);
-          if (hist[i]->GetXaxis()->GetBinCenter(srcBinXmax) > maxX) {
-            srcBinXmax -= 1;
-          }
+    // the bins of this histogram and of the source are associated once, at the first call
+    const GatherTable& table = getGatherTable(de, i, hist[i]);
+
+    // loop on destination bins
+    for (int by = table.binYmin; by <= table.binYmax; by++) {
+      auto [srcBinYmin, srcBinYmax] = table.srcBinsY[by - table.binYmin];
 
-          // loop on source bins, and compute the sum or average
-          int nBins = 0;
-          float tot = 0;
-          for (int sby = srcBinYmin; sby <= srcBinYmax; sby++) {
-            for (int sbx = srcBinXmin; sbx <= srcBinXmax; sbx++) {
-              float val = hist[i]->GetBinContent(sbx, sby);
-              if (val == 0 && !includeNullBins) {
-                continue;
-              }
-              nBins += 1;
-              tot += val;
+      for (int bx = table.binXmin; bx <= table.binXmax; bx++) {
+        auto [srcBinXmin, srcBinXmax] = table.srcBinsX[bx - table.binXmin];
+
+        // loop on source bins, and compute the sum or average
+        int nBins = 0;
+        float tot = 0;
+        for (int sby = srcBinYmin; sby <= srcBinYmax; sby++) {
+          for (int sbx = srcBinXmin; sbx <= srcBinXmax; sbx++) {
+            float val = hist[i]->GetBinContent(sbx, sby);
+            if (val == 0 && !includeNullBins) {
+              continue;
             }
+            nBins += 1;
+            tot += val;
           }
+        }
 
-          if (doAverage && (nBins > 0)) {
-            tot /= nBins;
-          }
-          SetBinContent(bx, by, tot);
+        if (doAverage && (nBins > 0)) {
+          tot /= nBins;
         }
+        SetBinContent(bx, by, tot);
       }
     }
   }
@@ -56,10 +56,15 @@ void PhysicsTaskDigits::initialize(o2::framework::InitContext& /*ctx*/)
                                                TString::Format("QcMuonChambers - ADC amplitude (FEE link %02d)", index), 5000, 0, 5000);
     }
   }
+  mDeIndex.fill(-1);
   for (auto de : o2::mch::raw::deIdsForAllMCH) {
+    mDeIndex[de] = mDetectionElements.size();
+    auto& detectionElement = mDetectionElements.emplace_back();
+    detectionElement.deId = de;
+
     TH1F* h = new TH1F(TString::Format("QcMuonChambers_ADCamplitude_DE%03d", de),
                        TString::Format("QcMuonChambers - ADC amplitude (DE%03d)", de), 5000, 0, 5000);
-    mHistogramADCamplitudeDE.insert(make_pair(de, h));
+    detectionElement.histADCamplitude = h;
 
     float Xsize = 40 * 5;
     float Xsize2 = Xsize / 2;
@@ -70,34 +75,60 @@ void PhysicsTaskDigits::initialize(o2::framework::InitContext& /*ctx*/)
     TH2F* h2 = new TH2F(TString::Format("QcMuonChambers_Nhits_DE%03d_B", de),
                         TString::Format("QcMuonChambers - Number of hits (DE%03d B)", de), Xsize * 2, -Xsize2, Xsize2, Ysize * 2, -Ysize2, Ysize2);
     mHistogramNhitsDE[0].insert(make_pair(de, h2));
+    detectionElement.histNhits[0] = h2;
     // getObjectsManager()->startPublishing(h2);
     h2 = new TH2F(TString::Format("QcMuonChambers_Nhits_DE%03d_NB", de),
                   TString::Format("QcMuonChambers - Number of hits (DE%03d NB)", de), Xsize * 2, -Xsize2, Xsize2, Ysize * 2, -Ysize2, Ysize2);
     mHistogramNhitsDE[1].insert(make_pair(de, h2));
+    detectionElement.histNhits[1] = h2;
     // getObjectsManager()->startPublishing(h2);
     h2 = new TH2F(TString::Format("QcMuonChambers_Norbits_DE%03d_B", de),
                   TString::Format("QcMuonChambers - Number of orbits (DE%03d B)", de), Xsize * 2, -Xsize2, Xsize2, Ysize * 2, -Ysize2, Ysize2);
     mHistogramNorbitsDE[0].insert(make_pair(de, h2));
+    detectionElement.histNorbits[0] = h2;
     h2 = new TH2F(TString::Format("QcMuonChambers_Norbits_DE%03d_NB", de),
                   TString::Format("QcMuonChambers - Number of orbits (DE%03d NB)", de), Xsize * 2, -Xsize2, Xsize2, Ysize * 2, -Ysize2, Ysize2);
     mHistogramNorbitsDE[1].insert(make_pair(de, h2));
+    detectionElement.histNorbits[1] = h2;
 
     {
       TH2F* hXY = new TH2F(TString::Format("QcMuonChambers_Occupancy_B_XY_%03d", de),
                            TString::Format("QcMuonChambers - Occupancy XY (DE%03d B) (MHz)", de), Xsize / scale, -Xsize2, Xsize2, Ysize / scale, -Ysize2, Ysize2);
-      mHistogramOccupancyXY[0].insert(make_pair(de, hXY));
+      detectionElement.histOccupancyXY[0] = hXY;
       // getObjectsManager()->startPublishing(hXY);
       hXY = new TH2F(TString::Format("QcMuonChambers_Occupancy_NB_XY_%03d", de),
                      TString::Format("QcMuonChambers - Occupancy XY (DE%03d NB) (MHz)", de), Xsize / scale, -Xsize2, Xsize2, Ysize / scale, -Ysize2, Ysize2);
-      mHistogramOccupancyXY[1].insert(make_pair(de, hXY));
+      detectionElement.histOccupancyXY[1] = hXY;
       //  getObjectsManager()->startPublishing(hXY);
     }
+
+    createPads(detectionElement);
   }
 
   for (int fee = 0; fee < MCH_FEEID_NUM; fee++) {
     for (int link = 0; link < 12; link++) {
       norbits[fee][link] = lastorbitseen[fee][link] = 0;
+      mLinkHasHits[fee][link] = false;
+      mLinkFilledOrbits[fee][link] = 0;
+    }
+  }
+
+  // DE associated to each DS board in the Elec view
+  mElecBinXToDE.assign(MCH_FEEID_NUM * 12 * 40 + 1, -1);
+  for (int binx = 1; binx < MCH_FEEID_NUM * 12 * 40 + 1; binx++) {
+    uint32_t ds_addr = (binx - 1) % 40;
+    uint32_t linkid = ((binx - 1 - ds_addr) / 40) % 12;
+    uint32_t fee_id = (binx - 1 - ds_addr - 40 * linkid) / (12 * 40);
+    std::optional<uint16_t> solar_id = mFeeLink2SolarMapper(FeeLinkId{ static_cast<uint16_t>(fee_id), static_cast<uint8_t>(linkid) });
+    if (!solar_id.has_value()) {
+      continue;
     }
+    std::optional<DsDetId> dsDetId =
+      mElec2DetMapper(DsElecId{ solar_id.value(), static_cast<uint8_t>(ds_addr / 5), static_cast<uint8_t>(ds_addr % 5) });
+    if (!dsDetId.has_value()) {
+      continue;
+    }
+    mElecBinXToDE[binx] = dsDetId->deId();
   }
   for (int de = 0; de < 1100; de++) {
     MeanOccupancyDE[de] = MeanOccupancyDECycle[de] = LastMeanNhitsDE[de] = LastMeanNorbitsDE[de] = NewMeanNhitsDE[de] = NewMeanNorbitsDE[de] = NbinsDE[de] = 0;
@@ -134,6 +165,8 @@ void PhysicsTaskDigits::initialize(o2::framework::InitContext& /*ctx*/)
   mHistogramOrbits[0]->init();
   mHistogramOrbits[0]->SetOption("colz");
   getObjectsManager()->startPublishing(mHistogramOrbits[0]);
+
+  mHistogramHits[0] = new GlobalHistogram("QcMuonChambers_Hits_den", "Hits");
 }
 
 void PhysicsTaskDigits::startOfActivity(Activity& /*activity*/)
@@ -180,166 +213,173 @@ void PhysicsTaskDigits::monitorData(o2::framework::ProcessingContext& ctx)
   }
 }
 
+void PhysicsTaskDigits::createPads(DetectionElement& detectionElement)
+{
+  int de = detectionElement.deId;
+  const o2::mch::mapping::Segmentation& segment = o2::mch::mapping::segmentation(de);
+
+  int nPads = segment.nofPads();
+  detectionElement.pads.resize(nPads);
+  detectionElement.padDigits.assign(nPads, 0);
+  detectionElement.padHits.assign(nPads, 0);
+
+  for (int padid = 0; padid < nPads; padid++) {
+    auto& pad = detectionElement.pads[padid];
+
+    double padX = segment.padPositionX(padid);
+    double padY = segment.padPositionY(padid);
+    float padSizeX = segment.padSizeX(padid);
+    float padSizeY = segment.padSizeY(padid);
+    pad.cathode = segment.isBendingPad(padid) ? 0 : 1;
+    int dsid = segment.padDualSampaId(padid);
+    int chan_addr = segment.padDualSampaChannel(padid);
+
+    // bins covered by the pad, the same in the hits and orbits histograms
+    auto h2 = detectionElement.histNhits[pad.cathode];
+    pad.binXMin = h2->GetXaxis()->FindBin(padX - padSizeX / 2 + 0.1);
+    pad.binXMax = h2->GetXaxis()->FindBin(padX + padSizeX / 2 - 0.1);
+    pad.binYMin = h2->GetYaxis()->FindBin(padY - padSizeY / 2 + 0.1);
+    pad.binYMax = h2->GetYaxis()->FindBin(padY + padSizeY / 2 - 0.1);
+
+    uint32_t ds_addr = 0;
+    int32_t linkid = 0;
+    int32_t fee_id = 0;
+
+    // get the unique solar ID and the DS address associated to this pad
+    std::optional<DsElecId> dsElecId = mDet2ElecMapper(DsDetId{ de, dsid });
+    if (dsElecId.has_value()) {
+      ds_addr = dsElecId->elinkId();
+
+      std::optional<FeeLinkId> feeLinkId = mSolar2FeeLinkMapper(dsElecId->solarId());
+      if (feeLinkId.has_value()) {
+        fee_id = feeLinkId->feeId();
+        linkid = feeLinkId->linkId();
+        pad.hasElec = true;
+      }
+    }
+
+    //xbin and ybin uniquely identify each physical pad
+    pad.elecBinX = fee_id * 12 * 40 + (linkid % 12) * 40 + ds_addr + 1;
+    pad.elecBinY = chan_addr + 1;
+    pad.feeId = fee_id;
+    pad.linkId = linkid % 12;
+  }
+}
+
 void PhysicsTaskDigits::plotDigit(const o2::mch::Digit& digit)
 {
   int ADC = digit.getADC();
   int de = digit.getDetID();
   int padid = digit.getPadID();
 
-  if (ADC < 0 || de <= 0 || padid < 0) {
+  if (ADC < 0 || de <= 0 || de >= 1100 || padid < 0) {
     return;
   }
-
-  // Fill NHits Elec Histogram and ADC distribution
-  // Using the mapping to go from Digit info (de, pad) to Elec info (fee, link) and fill Elec Histogram, where one bin is one physical pad
-  const o2::mch::mapping::Segmentation& segment = o2::mch::mapping::segmentation(de);
-
-  double padX = segment.padPositionX(padid);
-  double padY = segment.padPositionY(padid);
-  float padSizeX = segment.padSizeX(padid);
-  float padSizeY = segment.padSizeY(padid);
-  int cathode = segment.isBendingPad(padid) ? 0 : 1;
-  int dsid = segment.padDualSampaId(padid);
-  int chan_addr = segment.padDualSampaChannel(padid);
-
-  uint32_t solar_id = 0;
-  uint32_t ds_addr = 0;
-  int32_t linkid = 0;
-  int32_t fee_id = 0;
-
-  // get the unique solar ID and the DS address associated to this digit
-  std::optional<DsElecId> dsElecId = mDet2ElecMapper(DsDetId{ de, dsid });
-  if (dsElecId.has_value()) {
-    solar_id = dsElecId->solarId();
-    ds_addr = dsElecId->elinkId();
-
-    std::optional<FeeLinkId> feeLinkId = mSolar2FeeLinkMapper(solar_id);
-    if (feeLinkId.has_value()) {
-      fee_id = feeLinkId->feeId();
-      linkid = feeLinkId->linkId();
-    }
+  int deIndex = mDeIndex[de];
+  if (deIndex < 0) {
+    return;
   }
-
-  //xbin and ybin uniquely identify each physical pad
-  int xbin = fee_id * 12 * 40 + (linkid % 12) * 40 + ds_addr + 1;
-  int ybin = chan_addr + 1;
-
-  mHistogramNHitsElec->Fill(xbin - 0.5, ybin - 0.5);
-
-  auto h = mHistogramADCamplitudeDE.find(de);
-  if ((h != mHistogramADCamplitudeDE.end()) && (h->second != NULL)) {
-    h->second->Fill(ADC);
+  auto& detectionElement = mDetectionElements[deIndex];
+  if (padid >= static_cast<int>(detectionElement.pads.size())) {
+    return;
   }
 
+  // The NHits Elec and X Y histograms are filled from the pad counters at the end of the cycle
+  detectionElement.padDigits[padid] += 1;
+  detectionElement.histADCamplitude->Fill(ADC);
+
   if (ADC <= 0) {
     return;
   }
+  detectionElement.padHits[padid] += 1;
+}
 
-  // Fill X Y 2D hits histogram with fired pads distribution
-  auto h2 = mHistogramNhitsDE[cathode].find(de);
-  if ((h2 != mHistogramNhitsDE[cathode].end()) && (h2->second != NULL)) {
-    int binx_min = h2->second->GetXaxis()->FindBin(padX - padSizeX / 2 + 0.1);
-    int binx_max = h2->second->GetXaxis()->FindBin(padX + padSizeX / 2 - 0.1);
-    int biny_min = h2->second->GetYaxis()->FindBin(padY - padSizeY / 2 + 0.1);
-    int biny_max = h2->second->GetYaxis()->FindBin(padY + padSizeY / 2 - 0.1);
-    for (int by = biny_min; by <= biny_max; by++) {
-      float y = h2->second->GetYaxis()->GetBinCenter(by);
-      for (int bx = binx_min; bx <= binx_max; bx++) {
-        float x = h2->second->GetXaxis()->GetBinCenter(bx);
-        h2->second->Fill(x, y);
+void PhysicsTaskDigits::fillPadHistograms(std::vector<int>& modifiedDEs)
+{
+  std::vector<bool> deModified(mDetectionElements.size(), false);
+
+  double nElecEntries = 0;
+  for (size_t ide = 0; ide < mDetectionElements.size(); ide++) {
+    auto& detectionElement = mDetectionElements[ide];
+    for (size_t padid = 0; padid < detectionElement.pads.size(); padid++) {
+      const auto& pad = detectionElement.pads[padid];
+
+      if (uint32_t nDigits = detectionElement.padDigits[padid]; nDigits > 0) {
+        mHistogramNHitsElec->AddBinContent(mHistogramNHitsElec->GetBin(pad.elecBinX, pad.elecBinY), nDigits);
+        nElecEntries += nDigits;
+        detectionElement.padDigits[padid] = 0;
       }
-    }
-  }
 
-  // Get the Elec information to fill histogram of orbits (XY histogram)
-  h2 = mHistogramNorbitsDE[cathode].find(de);
-  if ((h2 != mHistogramNorbitsDE[cathode].end()) && (h2->second != NULL)) {
-    int NYbins = h2->second->GetYaxis()->GetNbins();
-    int NXbins = h2->second->GetXaxis()->GetNbins();
-    for (int by = 0; by < NYbins; by++) {
-      float y = h2->second->GetYaxis()->GetBinCenter(by);
-      for (int bx = 0; bx < NXbins; bx++) {
-        float x = h2->second->GetXaxis()->GetBinCenter(bx);
-
-        // get pad and DS channel mappings for this bin
-        int bpad = 0;
-        int nbpad = 0;
-        uint32_t solar_id_boucle = 0;
-
-        if (segment.findPadPairByPosition(x, y, bpad, nbpad)) {
-
-          // get the unique solar ID and the DS address associated to this bin
-          int padid_boucle = (cathode == 0) ? bpad : nbpad;
-          int dsid_boucle = segment.padDualSampaId(padid_boucle);
-          std::optional<DsElecId> dsElecId = mDet2ElecMapper(DsDetId{ de, dsid_boucle });
-          if (dsElecId.has_value()) {
-            solar_id_boucle = dsElecId->solarId();
-          }
-
-          if (solar_id_boucle == solar_id) {
-            h2->second->SetBinContent(bx, by, norbits[fee_id][linkid]);
+      // Fill X Y 2D hits histogram with fired pads distribution
+      if (uint32_t nHits = detectionElement.padHits[padid]; nHits > 0) {
+        auto h2 = detectionElement.histNhits[pad.cathode];
+        for (int by = pad.binYMin; by <= pad.binYMax; by++) {
+          for (int bx = pad.binXMin; bx <= pad.binXMax; bx++) {
+            h2->AddBinContent(h2->GetBin(bx, by), nHits);
           }
         }
+        h2->SetEntries(h2->GetEntries() + double(nHits) * (pad.binXMax - pad.binXMin + 1) * (pad.binYMax - pad.binYMin + 1));
+        if (pad.hasElec) {
+          mLinkHasHits[pad.feeId][pad.linkId] = true;
+        }
+        detectionElement.padHits[padid] = 0;
+        deModified[ide] = true;
       }
     }
   }
-}
+  mHistogramNHitsElec->SetEntries(mHistogramNHitsElec->GetEntries() + nElecEntries);
 
-void PhysicsTaskDigits::endOfCycle()
-{
-  QcInfoLogger::GetInstance() << "endOfCycle" << AliceO2::InfoLogger::InfoLogger::endm;
-  for (int de = 100; de <= 1030; de++) {
-    for (int i = 0; i < 2; i++) {
-      auto ih = mHistogramOccupancyXY[i].find(de);
-      ih = mHistogramOccupancyXY[i].find(de);
-      if (ih == mHistogramOccupancyXY[i].end()) {
-        continue;
+  // The orbits are written to the pads of the FEE links which had hits, when their number changed since the last cycle
+  bool linkModified[MCH_FEEID_NUM][12];
+  for (int fee = 0; fee < MCH_FEEID_NUM; fee++) {
+    for (int link = 0; link < 12; link++) {
+      linkModified[fee][link] = mLinkHasHits[fee][link] && norbits[fee][link] != mLinkFilledOrbits[fee][link];
+      if (linkModified[fee][link]) {
+        mLinkFilledOrbits[fee][link] = norbits[fee][link];
       }
     }
   }
 
-  // Compute Occupancy in GlobalHistograms by dividing Hits by Orbits and scaling
-  mHistogramOrbits[0]->set(mHistogramNorbitsDE[0], mHistogramNorbitsDE[1]);
-  mHistogramOccupancy[0]->set(mHistogramNhitsDE[0], mHistogramNhitsDE[1]);
-  mHistogramOccupancy[0]->Divide(mHistogramOrbits[0]);
-  mHistogramOccupancy[0]->Scale(1 / 87.5); // Converting Occupancy from NbHits/NbOrbits to MHz
-
-  // Fill NOrbits, in Elec view, for electronics channels associated to readout pads (in order to then compute the Occupancy in Elec view, physically meaningful because in Elec view, each bin is a physical pad)
-  for (uint16_t fee_id = 0; fee_id < MCH_FEEID_NUM; fee_id++) {
-
-    // loop on FEE links and check if it corresponds to an existing SOLAR board
-    for (uint8_t linkid = 0; linkid < 12; linkid++) {
-
-      std::optional<uint16_t> solar_id = mFeeLink2SolarMapper(FeeLinkId{ fee_id, linkid });
-      if (!solar_id.has_value()) {
+  // Fill the X Y histogram of orbits
+  for (size_t ide = 0; ide < mDetectionElements.size(); ide++) {
+    auto& detectionElement = mDetectionElements[ide];
+    for (const auto& pad : detectionElement.pads) {
+      if (!pad.hasElec || !linkModified[pad.feeId][pad.linkId]) {
         continue;
       }
-
-      // loop on DS boards and check if it exists in the mapping
-      for (uint8_t ds_addr = 0; ds_addr < 40; ds_addr++) {
-        uint32_t de, dsid;
-        std::optional<DsDetId> dsDetId =
-          mElec2DetMapper(DsElecId{ solar_id.value(), static_cast<uint8_t>(ds_addr / 5), static_cast<uint8_t>(ds_addr % 5) });
-        if (!dsDetId.has_value()) {
-          continue;
+      auto h2 = detectionElement.histNorbits[pad.cathode];
+      for (int by = pad.binYMin; by <= pad.binYMax; by++) {
+        for (int bx = pad.binXMin; bx <= pad.binXMax; bx++) {
+          h2->SetBinContent(bx, by, norbits[pad.feeId][pad.linkId]);
         }
-        de = dsDetId->deId();
-        dsid = dsDetId->dsId();
+      }
+      deModified[ide] = true;
+    }
 
-        int xbin = fee_id * 12 * 40 + (linkid % 12) * 40 + ds_addr + 1;
+    if (deModified[ide]) {
+      modifiedDEs.push_back(detectionElement.deId);
+    }
+  }
+}
 
-        // loop on DS channels and check if it is associated to a readout pad
-        for (int chan_addr = 0; chan_addr < 64; chan_addr++) {
+void PhysicsTaskDigits::endOfCycle()
+{
+  QcInfoLogger::GetInstance() << "endOfCycle" << AliceO2::InfoLogger::InfoLogger::endm;
 
-          const o2::mch::mapping::Segmentation& segment = o2::mch::mapping::segmentation(de);
-          int padid = segment.findPadByFEE(dsid, chan_addr);
-          if (padid < 0) {
-            continue;
-          }
+  std::vector<int> modifiedDEs;
+  fillPadHistograms(modifiedDEs);
 
-          int ybin = chan_addr + 1;
-          mHistogramNorbitsElec->SetBinContent(xbin, ybin, norbits[fee_id][linkid]);
-        }
+  // Compute Occupancy in GlobalHistograms by dividing Hits by Orbits and scaling, only the modified DEs are copied
+  mHistogramOrbits[0]->set(modifiedDEs, mHistogramNorbitsDE[0], mHistogramNorbitsDE[1]);
+  mHistogramHits[0]->set(modifiedDEs, mHistogramNhitsDE[0], mHistogramNhitsDE[1]);
+  mHistogramOccupancy[0]->Divide(mHistogramHits[0], mHistogramOrbits[0]);
+  mHistogramOccupancy[0]->Scale(1 / 87.5); // Converting Occupancy from NbHits/NbOrbits to MHz
+
+  // Fill NOrbits, in Elec view, for electronics channels associated to readout pads (in order to then compute the Occupancy in Elec view, physically meaningful because in Elec view, each bin is a physical pad)
+  for (const auto& detectionElement : mDetectionElements) {
+    for (const auto& pad : detectionElement.pads) {
+      if (pad.hasElec) {
+        mHistogramNorbitsElec->SetBinContent(pad.elecBinX, pad.elecBinY, norbits[pad.feeId][pad.linkId]);
       }
     }
   }
@@ -351,17 +391,11 @@ void PhysicsTaskDigits::endOfCycle()
   mHistogramOccupancyElec->Scale(1 / 87.5); // Converting Occupancy from NbHits/NbOrbits to MHz
 
   // Compute the Occupancy for individual DE XY histograms
-  for (int de = 0; de < 1100; de++) {
+  for (auto de : modifiedDEs) {
+    auto& detectionElement = mDetectionElements[mDeIndex[de]];
     for (int i = 0; i < 2; i++) {
-      auto h = mHistogramOccupancyXY[i].find(de);
-      if ((h != mHistogramOccupancyXY[i].end()) && (h->second != NULL)) {
-        auto hhits = mHistogramNhitsDE[i].find(de);
-        auto horbits = mHistogramNorbitsDE[i].find(de);
-        if ((hhits != mHistogramNhitsDE[i].end()) && (horbits != mHistogramNorbitsDE[i].end()) && (hhits->second != NULL) && (horbits->second != NULL)) {
-          h->second->Divide(hhits->second, horbits->second);
-          h->second->Scale(1 / 87.5); // Converting Occupancy from NbHits/NbOrbits to MHz
-        }
-      }
+      detectionElement.histOccupancyXY[i]->Divide(detectionElement.histNhits[i], detectionElement.histNorbits[i]);
+      detectionElement.histOccupancyXY[i]->Scale(1 / 87.5); // Converting Occupancy from NbHits/NbOrbits to MHz
     }
   }
 
@@ -385,21 +419,11 @@ void PhysicsTaskDigits::endOfCycle()
             continue;
           }
 
-          // Getting Elec information based on the definition of x and y bins in ElecHistograms
-          uint32_t ds_addr = (binx - 1) % 40;
-          uint32_t linkid = ((binx - 1 - ds_addr) / 40) % 12;
-          uint32_t fee_id = (binx - 1 - ds_addr - 40 * linkid) / (12 * 40);
-          uint32_t de;
-          std::optional<uint16_t> solar_id = mFeeLink2SolarMapper(FeeLinkId{ static_cast<uint16_t>(fee_id), static_cast<uint8_t>(linkid) });
-          if (!solar_id.has_value()) {
+          // Getting the DE based on the definition of x bins in ElecHistograms
+          int de = mElecBinXToDE[binx];
+          if (de < 0) {
             continue;
           }
-          std::optional<DsDetId> dsDetId =
-            mElec2DetMapper(DsElecId{ solar_id.value(), static_cast<uint8_t>(ds_addr / 5), static_cast<uint8_t>(ds_addr % 5) });
-          if (!dsDetId.has_value()) {
-            continue;
-          }
-          de = dsDetId->deId();
 
           MeanOccupancyDE[de] += h->GetBinContent(binx, biny);
           NbinsDE[de] += 1;
@@ -428,21 +452,11 @@ void PhysicsTaskDigits::endOfCycle()
       }
       for (int binx = 1; binx < hhits->GetXaxis()->GetNbins() + 1; binx++) {
         for (int biny = 1; biny < hhits->GetYaxis()->GetNbins() + 1; biny++) {
-          // Same procedure as above in getting Elec info
-          uint32_t ds_addr = (binx - 1) % 40;
-          uint32_t linkid = ((binx - 1 - ds_addr) / 40) % 12;
-          uint32_t fee_id = (binx - 1 - ds_addr - 40 * linkid) / (12 * 40);
-          uint32_t de;
-          std::optional<uint16_t> solar_id = mFeeLink2SolarMapper(FeeLinkId{ static_cast<uint16_t>(fee_id), static_cast<uint8_t>(linkid) });
-          if (!solar_id.has_value()) {
+          // Same procedure as above in getting the DE
+          int de = mElecBinXToDE[binx];
+          if (de < 0) {
             continue;
           }
-          std::optional<DsDetId> dsDetId =
-            mElec2DetMapper(DsElecId{ solar_id.value(), static_cast<uint8_t>(ds_addr / 5), static_cast<uint8_t>(ds_addr % 5) });
-          if (!dsDetId.has_value()) {
-            continue;
-          }
-          de = dsDetId->deId();
 
           NewMeanNhitsDE[de] += hhits->GetBinContent(binx, biny);
           NewMeanNorbitsDE[de] += horbits->GetBinContent(binx, biny);
@@ -477,32 +491,12 @@ void PhysicsTaskDigits::endOfActivity(Activity& /*activity*/)
   mHistogramNHitsElec->Write();
   mHistogramOccupancyElec->Write();
 
-  for (int de = 0; de < 1100; de++) {
-    {
-      auto h = mHistogramADCamplitudeDE.find(de);
-      if ((h != mHistogramADCamplitudeDE.end()) && (h->second != NULL)) {
-        h->second->Write();
-      }
-    }
+  for (auto& detectionElement : mDetectionElements) {
+    detectionElement.histADCamplitude->Write();
     for (int i = 0; i < 2; i++) {
-      {
-        auto h = mHistogramNhitsDE[i].find(de);
-        if ((h != mHistogramNhitsDE[i].end()) && (h->second != NULL)) {
-          h->second->Write();
-        }
-      }
-      {
-        auto h = mHistogramNorbitsDE[i].find(de);
-        if ((h != mHistogramNorbitsDE[i].end()) && (h->second != NULL)) {
-          h->second->Write();
-        }
-      }
-      {
-        auto h = mHistogramOccupancyXY[i].find(de);
-        if ((h != mHistogramOccupancyXY[i].end()) && (h->second != NULL)) {
-          h->second->Write();
-        }
-      }
+      detectionElement.histNhits[i]->Write();
+      detectionElement.histNorbits[i]->Write();
+      detectionElement.histOccupancyXY[i]->Write();
     }
   }
 
@@ -23,6 +23,7 @@
 #include "DataFormatsPHOS/Cell.h"
 #include "DataFormatsPHOS/TriggerRecord.h"
 #include <gsl/span>
+#include "Common/PedestalStatistics.h"
 
 class TH1F;
 class TH2F;
@@ -122,6 +123,7 @@ class RawQcTask final : public TaskInterface
   void FillPhysicsHistograms(const gsl::span<const o2::phos::Cell>& cells, const gsl::span<const o2::phos::TriggerRecord>& tr);
   void CreatePedestalHistograms();
   void FillPedestalHistograms(const gsl::span<const o2::phos::Cell>& cells, const gsl::span<const o2::phos::TriggerRecord>& tr);
+  void FillPedestalMaps();
   void CreateLEDHistograms() {}
   void FillLEDHistograms(const gsl::span<const o2::phos::Cell>& /*cells*/, const gsl::span<const o2::phos::TriggerRecord>& /*tr*/) {}
 
@@ -129,11 +131,19 @@ class RawQcTask final : public TaskInterface
   static constexpr short kNmod = 6;
   static constexpr short kMaxErr = 5;
   static constexpr short kOcccupancyTh = 10;
+  static constexpr int kNChannels = 4 * 64 * 56 + 1; ///< the absolute ids of the cells start from 1
 
   int mMode = 0; ///< Possible modes: 0(def): Physics, 1: Pedestals, 2: LED
 
   std::array<TH1F*, kNhist1D> mHist1D = { nullptr }; ///< Array of 1D histograms
   std::array<TH2F*, kNhist2D> mHist2D = { nullptr }; ///< Array of 2D histograms
+
+  // statistics per cell of the pedestal means and RMS, the maps are filled from them at the end of the cycle
+  using PedestalStatistics = o2::quality_control_modules::common::PedestalStatistics;
+  PedestalStatistics mHGMeanStatistics{ kNChannels };
+  PedestalStatistics mHGRmsStatistics{ kNChannels };
+  PedestalStatistics mLGMeanStatistics{ kNChannels };
+  PedestalStatistics mLGRmsStatistics{ kNChannels };
 };
 
 } // namespace o2::quality_control_modules::phos
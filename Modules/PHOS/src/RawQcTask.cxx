@@ -123,18 +123,6 @@ void RawQcTask::startOfActivity(Activity& /*activity*/)
 void RawQcTask::startOfCycle()
 {
   QcInfoLogger::GetInstance() << "startOfCycle" << AliceO2::InfoLogger::InfoLogger::endm;
-  if (mMode == 1) { //Pedestals
-    for (Int_t mod = 0; mod < 4; mod++) {
-      if (mHist2D[kHGmeanM1 + mod]) {
-        mHist2D[kHGmeanM1 + mod]->Multiply(mHist2D[kHGoccupM1 + mod]);
-        mHist2D[kHGrmsM1 + mod]->Multiply(mHist2D[kHGoccupM1 + mod]);
-      }
-      if (mHist2D[kLGmeanM1 + mod]) {
-        mHist2D[kLGmeanM1 + mod]->Multiply(mHist2D[kLGoccupM1 + mod]);
-        mHist2D[kLGrmsM1 + mod]->Multiply(mHist2D[kLGoccupM1 + mod]);
-      }
-    }
-  }
 }
 
 void RawQcTask::monitorData(o2::framework::ProcessingContext& ctx)
@@ -196,10 +184,9 @@ void RawQcTask::endOfCycle()
 {
   QcInfoLogger::GetInstance() << "endOfCycle" << AliceO2::InfoLogger::InfoLogger::endm;
   if (mMode == 1) { //Pedestals
+    FillPedestalMaps();
     for (Int_t mod = 0; mod < 4; mod++) {
       if (mHist2D[kHGmeanM1 + mod]) {
-        mHist2D[kHGmeanM1 + mod]->Divide(mHist2D[kHGoccupM1 + mod]);
-        mHist2D[kHGrmsM1 + mod]->Divide(mHist2D[kHGoccupM1 + mod]);
         mHist1D[kHGmeanSummaryM1 + mod]->Reset();
         mHist1D[kHGrmsSummaryM1 + mod]->Reset();
         double occMin = 1.e+9;
@@ -227,8 +214,6 @@ void RawQcTask::endOfCycle()
         mHist2D[kHGoccupM1 + mod]->SetMaximum(occMax);
       }
       if (mHist2D[kLGmeanM1 + mod]) {
-        mHist2D[kLGmeanM1 + mod]->Divide(mHist2D[kLGoccupM1 + mod]);
-        mHist2D[kLGrmsM1 + mod]->Divide(mHist2D[kLGoccupM1 + mod]);
         mHist1D[kLGmeanSummaryM1 + mod]->Reset();
         mHist1D[kLGrmsSummaryM1 + mod]->Reset();
         double occMin = 1.e+9;
@@ -279,6 +264,10 @@ void RawQcTask::reset()
       mHist2D[i]->Reset();
     }
   }
+  mHGMeanStatistics.reset();
+  mHGRmsStatistics.reset();
+  mLGMeanStatistics.reset();
+  mLGRmsStatistics.reset();
 }
 void RawQcTask::FillPhysicsHistograms(const gsl::span<const o2::phos::Cell>& cells, const gsl::span<const o2::phos::TriggerRecord>& cellsTR)
 {
@@ -321,21 +310,41 @@ void RawQcTask::FillPedestalHistograms(const gsl::span<const o2::phos::Cell>& ce
     for (int i = firstCellInEvent; i < lastCellInEvent; i++) {
       const o2::phos::Cell c = cells[i];
       short address = c.getAbsId();
-      char relid[3];
-      o2::phos::Geometry::absToRelNumbering(address, relid);
       if (c.getHighGain()) {
-        mHist2D[kHGmeanM1 + relid[0]]->Fill(relid[1] - 0.5, relid[2] - 0.5, c.getEnergy());
-        mHist2D[kHGrmsM1 + relid[0]]->Fill(relid[1] - 0.5, relid[2] - 0.5, 1.e+7 * c.getTime()); //to store in Cells format
-        mHist2D[kHGoccupM1 + relid[0]]->Fill(relid[1] - 0.5, relid[2] - 0.5);
+        mHGMeanStatistics.fill(address, c.getEnergy());
+        mHGRmsStatistics.fill(address, 1.e+7 * c.getTime()); //to store in Cells format
       } else {
-        mHist2D[kLGmeanM1 + relid[0]]->Fill(relid[1] - 0.5, relid[2] - 0.5, c.getEnergy());
-        mHist2D[kLGrmsM1 + relid[0]]->Fill(relid[1] - 0.5, relid[2] - 0.5, 1.e+7 * c.getTime());
-        mHist2D[kLGoccupM1 + relid[0]]->Fill(relid[1] - 0.5, relid[2] - 0.5);
+        mLGMeanStatistics.fill(address, c.getEnergy());
+        mLGRmsStatistics.fill(address, 1.e+7 * c.getTime());
       }
     }
   }
 }
 
+void RawQcTask::FillPedestalMaps()
+{
+  for (int address = 0; address < kNChannels; address++) {
+    const uint32_t nHG = mHGMeanStatistics.getEntries(address);
+    const uint32_t nLG = mLGMeanStatistics.getEntries(address);
+    if (nHG == 0 && nLG == 0) {
+      continue;
+    }
+    char relid[3];
+    o2::phos::Geometry::absToRelNumbering(address, relid);
+    int ibin = mHist2D[kHGmeanM1 + relid[0]]->FindBin(relid[1] - 0.5, relid[2] - 0.5);
+    if (nHG > 0) {
+      mHist2D[kHGmeanM1 + relid[0]]->SetBinContent(ibin, mHGMeanStatistics.getMean(address));
+      mHist2D[kHGrmsM1 + relid[0]]->SetBinContent(ibin, mHGRmsStatistics.getMean(address));
+      mHist2D[kHGoccupM1 + relid[0]]->SetBinContent(ibin, nHG);
+    }
+    if (nLG > 0) {
+      mHist2D[kLGmeanM1 + relid[0]]->SetBinContent(ibin, mLGMeanStatistics.getMean(address));
+      mHist2D[kLGrmsM1 + relid[0]]->SetBinContent(ibin, mLGRmsStatistics.getMean(address));
+      mHist2D[kLGoccupM1 + relid[0]]->SetBinContent(ibin, nLG);
+    }
+  }
+}
+
 void RawQcTask::CreatePedestalHistograms()
 {
   //Prepare historams for pedestal run QA
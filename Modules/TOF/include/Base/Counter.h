@@ -22,6 +22,14 @@
 // ROOT includes
 #include "TH1.h"
 #include "TMath.h"
+#include "TArrayF.h"
+#include "TArrayD.h"
+#include "TArrayI.h"
+
+// STL includes
+#include <array>
+#include <numeric>
+#include <type_traits>
 
 // QC includes
 #include "QualityControl/QcInfoLogger.h"
@@ -29,6 +37,11 @@
 // Fairlogger includes
 #include <fairlogger/Logger.h>
 
+// #define ENABLE_COUNTER_DEBUG // Flag used to enable the bound checks and the logging of each increment. Always on in debug builds
+#if !defined(NDEBUG) && !defined(ENABLE_COUNTER_DEBUG)
+#define ENABLE_COUNTER_DEBUG
+#endif
+
 namespace o2::quality_control_modules::tof
 {
 
@@ -44,10 +57,19 @@ class Counter
   /// Destructor
   ~Counter() = default;
 
-  /// Functions to increment a counter
+  /// Functions to increment a counter. Bound checks and logging are only compiled with ENABLE_COUNTER_DEBUG
   /// @param index Index in the counter array to increment
   /// @param weight weight to add to the array element
-  void Add(const unsigned int& index, const uint32_t& weight);
+  void Add(const unsigned int& index, const uint32_t& weight)
+  {
+#ifdef ENABLE_COUNTER_DEBUG
+    if (index >= size) {
+      LOG(FATAL) << "Incrementing counter too far! " << index << "/" << size;
+    }
+    LOG(DEBUG) << "Incrementing " << index << "/" << size << " of " << weight << " to " << counter[index];
+#endif
+    counter[index] += weight;
+  }
 
   /// Functions to count a single event
   /// @param index Index in the counter array to increment by one
@@ -56,6 +78,10 @@ class Counter
   /// Function to reset counters to zero
   void Reset();
 
+  /// Function to add the content of another counter, e.g. to merge the per-thread counters at the end of a cycle
+  /// @param other Counter to add to this one
+  void Merge(const Counter& other);
+
   /// Function to print the counter content
   void Print();
 
@@ -82,7 +108,8 @@ class Counter
   /// @returns Returns 0 if everything went OK
   int MakeHistogram(TH1* histogram) const;
 
-  /// Function to fill a histogram with the counters
+  /// Function to fill a histogram with the counters.
+  /// The counters are copied in bulk into the bin array of TH1F/D/I, TH2F/D/I and TH3F/D/I, and bin by bin for other types.
   /// @param histogram The histogram to fill
   /// @param biny Y offset to fill to histogram, useful for TH2 and TH3
   /// @param binz Z offset to fill to histogram, useful for TH3
@@ -108,21 +135,19 @@ class Counter
 // #define ENABLE_BIN_SHIFT // Flag used to enable different binning in counter and histograms
 
 template <const unsigned int size, const char* labels[size]>
-void Counter<size, labels>::Add(const unsigned int& index, const uint32_t& weight)
+void Counter<size, labels>::Reset()
 {
-  if (index > size) {
-    LOG(FATAL) << "Incrementing counter too far! " << index << "/" << size;
-  }
-  LOG(DEBUG) << "Incrementing " << index << "/" << size << " of " << weight << " to " << counter[index];
-  counter[index] += weight;
+#ifdef ENABLE_COUNTER_DEBUG
+  LOG(DEBUG) << "Resetting Counter";
+#endif
+  counter.fill(0);
 }
 
 template <const unsigned int size, const char* labels[size]>
-void Counter<size, labels>::Reset()
+void Counter<size, labels>::Merge(const Counter& other)
 {
-  LOG(DEBUG) << "Resetting Counter";
   for (unsigned int i = 0; i < size; i++) {
-    counter[i] = 0;
+    counter[i] += other.counter[i];
   }
 }
 
@@ -150,10 +175,8 @@ void Counter<size, labels>::Print()
 template <const unsigned int size, const char* labels[size]>
 uint32_t Counter<size, labels>::Total()
 {
-  uint32_t sum = 0;
-  for (unsigned int i = 0; i < size; i++) {
-    sum += counter[i];
-  }
+  // accumulating in a local allows the compiler to vectorize the reduction
+  const uint32_t sum = std::accumulate(counter.begin(), counter.end(), uint32_t{ 0 });
   mTotal = sum;
   return sum;
 }
@@ -251,19 +274,54 @@ int Counter<size, labels>::FillHistogram(TH1* histogram, const unsigned int& bin
     }
   };
 
-  LOG(DEBUG) << "Filling Histogram " << histogram->GetName() << " with counter contents";
 #ifndef ENABLE_BIN_SHIFT
+  // Copies the non empty counters in the contiguous bins [1, size] of the row (biny, binz), in a loop without branches
+  // so that it can be vectorized. It reproduces what SetBinContent and SetBinError do bin by bin.
+  auto fillArray = [&](auto* content) {
+    const Int_t offset = histogram->GetBin(1, biny, binz);
+    if (histogram->GetSumw2N() == 0) {
+      histogram->Sumw2();
+    }
+    Double_t* sumw2 = histogram->GetSumw2()->GetArray();
+    using content_t = std::remove_pointer_t<decltype(content)>;
+    unsigned int nFilled = 0;
+    for (unsigned int i = 0; i < size; i++) {
+      const bool filled = counter[i] > 0;
+      content[offset + i] = filled ? static_cast<content_t>(counter[i]) : content[offset + i];
+      sumw2[offset + i] = filled ? static_cast<Double_t>(counter[i]) : sumw2[offset + i];
+      nFilled += filled;
+    }
+    Double_t stats[TH1::kNstat] = { 0 }; // Statistics are recomputed from the bin contents when needed
+    histogram->PutStats(stats);
+    histogram->SetEntries(histogram->GetEntries() + nFilled);
+  };
+
   if (size != (histogram->GetNbinsX())) {
     LOG(FATAL) << "Counter of size " << size << " does not fit in histogram " << histogram->GetName() << " with size " << histogram->GetNbinsX() - 1;
     return 1;
   }
-  for (unsigned int i = 0; i < size; i++) {
-    LOG(DEBUG) << "Filling bin " << i + 1 << " with counter at position " << i;
-    if (HasLabel(i) && strcmp(labels[i], histogram->GetXaxis()->GetBinLabel(i + 1)) != 0) { // If it has a label check its consistency!
-      LOG(FATAL) << "Bin " << i + 1 << " does not have the expected label '" << histogram->GetXaxis()->GetBinLabel(i + 1) << "' vs '" << labels[i] << "'";
-      return 1;
+  if constexpr (labels != nullptr) {
+    for (unsigned int i = 0; i < size; i++) {
+      if (HasLabel(i) && strcmp(labels[i], histogram->GetXaxis()->GetBinLabel(i + 1)) != 0) { // If it has a label check its consistency!
+        LOG(FATAL) << "Bin " << i + 1 << " does not have the expected label '" << histogram->GetXaxis()->GetBinLabel(i + 1) << "' vs '" << labels[i] << "'";
+        return 1;
+      }
+    }
+  }
+  if (histogram->InheritsFrom("TProfile") || histogram->InheritsFrom("TProfile2D") || histogram->InheritsFrom("TProfile3D")) {
+    for (unsigned int i = 0; i < size; i++) { // The content of profiles is not stored as is in their bin array
+      fillIt(i + 1, i);
+    }
+  } else if (auto arrayF = dynamic_cast<TArrayF*>(histogram)) {
+    fillArray(arrayF->GetArray());
+  } else if (auto arrayD = dynamic_cast<TArrayD*>(histogram)) {
+    fillArray(arrayD->GetArray());
+  } else if (auto arrayI = dynamic_cast<TArrayI*>(histogram)) {
+    fillArray(arrayI->GetArray());
+  } else {
+    for (unsigned int i = 0; i < size; i++) {
+      fillIt(i + 1, i);
     }
-    fillIt(i + 1, i);
   }
 #else
   const unsigned int nbinsx = histogram->GetNbinsX();
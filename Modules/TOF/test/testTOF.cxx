@@ -17,6 +17,7 @@
 #include "Base/Counter.h"
 #include "DataFormatsTOF/CompressedDataFormat.h"
 #include "TH1F.h"
+#include "TH2F.h"
 
 #define BOOST_TEST_MODULE Publisher test
 #define BOOST_TEST_MAIN
@@ -98,4 +99,41 @@ BOOST_AUTO_TEST_CASE(check_tof_counter)
   BOOST_TEST_CHECKPOINT("Ending");
   BOOST_CHECK(true);
 }
-} // namespace o2::quality_control_modules::tof
\ No newline at end of file
+
+BOOST_AUTO_TEST_CASE(check_tof_counter_merge)
+{
+  // Per-thread counters merged into one and then copied into one row of a 2D histogram
+  Counter<10, nullptr> shards[4];
+  for (unsigned int t = 0; t < 4; t++) {
+    for (unsigned int j = 0; j < 10; j++) {
+      shards[t].Add(j, j * (t + 1));
+    }
+  }
+  Counter<10, nullptr> merged;
+  for (unsigned int t = 0; t < 4; t++) {
+    merged.Merge(shards[t]);
+  }
+  for (unsigned int j = 0; j < 10; j++) {
+    BOOST_CHECK_EQUAL(merged.HowMany(j), j * 10);
+  }
+  BOOST_CHECK_EQUAL(merged.Total(), 450);
+
+  TH2F* h2 = new TH2F("hMerged", "hMerged", 10, 0, 10, 3, 0, 3);
+  h2->SetBinContent(1, 2, 5); // empty counters must not overwrite existing bins
+  BOOST_CHECK(merged.FillHistogram(h2, 2) == 0);
+  BOOST_CHECK_EQUAL(h2->GetBinContent(1, 2), 5);
+  for (unsigned int j = 1; j < 10; j++) {
+    BOOST_CHECK_EQUAL(h2->GetBinContent(j + 1, 2), j * 10);
+    BOOST_CHECK_CLOSE(h2->GetBinError(j + 1, 2), TMath::Sqrt(j * 10), 1e-6);
+    BOOST_CHECK_EQUAL(h2->GetBinContent(j + 1, 1), 0);
+    BOOST_CHECK_EQUAL(h2->GetBinContent(j + 1, 3), 0);
+  }
+  BOOST_CHECK_EQUAL(h2->GetEntries(), 10);
+  BOOST_CHECK_EQUAL(h2->Integral(), 455);
+
+  merged.Reset();
+  BOOST_CHECK_EQUAL(merged.Total(), 0);
+  delete h2;
+}
+
+} // namespace o2::quality_control_modules::tof
@@ -23,6 +23,7 @@
 
 // QC includes
 #include "QualityControl/TaskInterface.h"
+#include "TPC/Utility.h"
 
 class TCanvas;
 
@@ -52,8 +53,16 @@ class Clusters /*final*/ : public TaskInterface // todo add back the "final" whe
   void endOfActivity(Activity& activity) override;
   void reset() override;
 
+  /// \brief Adds the values of the clusters to the sums
+  /// The sectors are processed in parallel if there are thread accumulators, each thread filling its own.
+  static void processClusters(const o2::tpc::ClusterNativeAccess& clusterIndex, o2::tpc::qc::Clusters& sums,
+                              std::vector<o2::tpc::qc::Clusters>& threadClusters);
+  /// \brief Sets the pad-wise means of the cluster values out of their sums, the numbers of clusters are copied
+  static void computeMeans(o2::tpc::qc::Clusters& sums, o2::tpc::qc::Clusters& means);
+
  private:
   o2::tpc::qc::Clusters mQCClusters{};                         ///< O2 Cluster task to perform actions on cluster objects
+  o2::tpc::qc::Clusters mClusterSums{};                        ///< sums of the cluster values, the published means are computed out of them
   std::vector<o2::tpc::qc::CalPadWrapper> mWrapperVector{};    ///< vector holding CalPad objects wrapped as TObjects; published on QCG; will be non-wrapped CalPad objects in the future
   std::vector<std::unique_ptr<TCanvas>> mNClustersCanvasVec{}; ///< summary canvases of the NClusters object
   std::vector<std::unique_ptr<TCanvas>> mQMaxCanvasVec{};      ///< summary canvases of the QMax object
@@ -61,6 +70,12 @@ class Clusters /*final*/ : public TaskInterface // todo add back the "final" whe
   std::vector<std::unique_ptr<TCanvas>> mSigmaTimeCanvasVec{}; ///< summary canvases of the SigmaTime object
   std::vector<std::unique_ptr<TCanvas>> mSigmaPadCanvasVec{};  ///< summary canvases of the SigmaPad object
   std::vector<std::unique_ptr<TCanvas>> mTimeBinCanvasVec{};   ///< summary canvases of the TimeBin object
+  ClusterHandlerBuffers mClusterBuffers{};                      ///< memory of the cluster index, reused for each message
+  int mNThreads = 1;                                            ///< number of threads processing the sectors in parallel
+  std::vector<o2::tpc::qc::Clusters> mThreadClusters{};         ///< private accumulators of the threads, moved into mClusterSums sector by sector
+
+  /// \brief Adds the values of the ROCs of a sector of the source to the target and zeroes them in the source
+  static void moveSector(o2::tpc::qc::Clusters& source, o2::tpc::qc::Clusters& target, int sector);
 };
 
 } // namespace o2::quality_control_modules::tpc
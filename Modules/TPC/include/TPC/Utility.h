@@ -19,6 +19,7 @@
 #include "QualityControl/ObjectsManager.h"
 
 #include "DataFormatsTPC/ClusterNative.h"
+#include "DataFormatsTPC/ClusterNativeHelper.h"
 #include "Framework/ProcessingContext.h"
 
 #include <TCanvas.h>
@@ -39,10 +40,19 @@ void addAndPublish(std::shared_ptr<o2::quality_control::core::ObjectsManager> ob
 /// \return std::vector<TCanvas*>
 std::vector<TCanvas*> toVector(std::vector<std::unique_ptr<TCanvas>>& input);
 
+/// \brief Memory used by clusterHandler, kept from one message to the next
+struct ClusterHandlerBuffers {
+  o2::tpc::ClusterNativeAccess clusterIndex;
+  std::unique_ptr<o2::tpc::ClusterNative[]> clusterBuffer;
+  o2::tpc::ClusterNativeHelper::ConstMCLabelContainerViewWithBuffer clustersMCBuffer;
+  std::vector<gsl::span<const char>> inputs;
+};
+
 /// \brief Converts CLUSTERNATIVE from InputRecord to ClusterNativeAccess
 /// Convenience funtion to make native clusters accessible when receiving them from the DPL
 /// \param input InputReconrd from the ProcessingContext
-/// \return ClusterNativeAccess object for easy cluster access
-o2::tpc::ClusterNativeAccess clusterHandler(o2::framework::InputRecord& input);
+/// \param buffers Memory of the index, it should be kept by the caller and passed for each message
+/// \return ClusterNativeAccess object for easy cluster access, valid until the next call with the same buffers
+const o2::tpc::ClusterNativeAccess& clusterHandler(o2::framework::InputRecord& input, ClusterHandlerBuffers& buffers);
 } //namespace o2::quality_control_modules::tpc
 #endif //QUALITYCONTROL_TPCUTILITY_H
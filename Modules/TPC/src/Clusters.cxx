@@ -23,6 +23,12 @@
 #include "TPC/Clusters.h"
 #include "TPC/Utility.h"
 
+#include <algorithm>
+
+#ifdef WITH_OPENMP
+#include <omp.h>
+#endif
+
 namespace o2::quality_control_modules::tpc
 {
 
@@ -40,6 +46,16 @@ void Clusters::initialize(o2::framework::InitContext& /*ctx*/)
 {
   QcInfoLogger::GetInstance() << "initialize TPC Clusters QC task" << AliceO2::InfoLogger::InfoLogger::endm;
 
+#ifdef WITH_OPENMP
+  if (auto param = mCustomParameters.find("nThreads"); param != mCustomParameters.end()) {
+    mNThreads = std::max(std::stoi(param->second), 1);
+  }
+#endif
+  if (mNThreads > 1) {
+    // each thread has its own copy of the pad-wise objects
+    mThreadClusters.resize(mNThreads);
+  }
+
   addAndPublish(getObjectsManager(), mNClustersCanvasVec, { "c_Sides_N_Clusters", "c_ROCs_N_Clusters_1D", "c_ROCs_N_Clusters_2D" });
   addAndPublish(getObjectsManager(), mQMaxCanvasVec, { "c_Sides_Q_Max", "c_ROCs_Q_Max_1D", "c_ROCs_Q_Max_2D" });
   addAndPublish(getObjectsManager(), mQTotCanvasVec, { "c_Sides_Q_Tot", "c_ROCs_Q_Tot_1D", "c_ROCs_Q_Tot_2D" });
@@ -51,6 +67,30 @@ void Clusters::initialize(o2::framework::InitContext& /*ctx*/)
     getObjectsManager()->startPublishing(&wrapper);
     getObjectsManager()->addMetadata(wrapper.getObj()->getName().data(), "custom", "87");
   }
+
+  // the means and the summary canvases are computed once per cycle, when they are published, rather than for each message
+  getObjectsManager()->registerRenderer([this]() {
+    // the sums are kept as they are, the means are only computed for the publication
+    computeMeans(mClusterSums, mQCClusters);
+
+    auto vecPtrNClusters = toVector(mNClustersCanvasVec);
+    o2::tpc::painter::makeSummaryCanvases(mQCClusters.getNClusters(), 300, 0, 0, true, &vecPtrNClusters);
+
+    auto vecPtrQMax = toVector(mQMaxCanvasVec);
+    o2::tpc::painter::makeSummaryCanvases(mQCClusters.getQMax(), 300, 0, 0, true, &vecPtrQMax);
+
+    auto vecPtrQTot = toVector(mQTotCanvasVec);
+    o2::tpc::painter::makeSummaryCanvases(mQCClusters.getQTot(), 300, 0, 0, true, &vecPtrQTot);
+
+    auto vecPtrSigmaTime = toVector(mSigmaTimeCanvasVec);
+    o2::tpc::painter::makeSummaryCanvases(mQCClusters.getSigmaTime(), 300, 0, 0, true, &vecPtrSigmaTime);
+
+    auto vecPtrSigmaPad = toVector(mSigmaPadCanvasVec);
+    o2::tpc::painter::makeSummaryCanvases(mQCClusters.getSigmaPad(), 300, 0, 0, true, &vecPtrSigmaPad);
+
+    auto vecPtrTimeBin = toVector(mTimeBinCanvasVec);
+    o2::tpc::painter::makeSummaryCanvases(mQCClusters.getTimeBin(), 300, 0, 0, true, &vecPtrTimeBin);
+  });
 }
 
 void Clusters::startOfActivity(Activity& /*activity*/)
@@ -65,37 +105,85 @@ void Clusters::startOfCycle()
 
 void Clusters::monitorData(o2::framework::ProcessingContext& ctx)
 {
-  o2::tpc::ClusterNativeAccess clusterIndex = clusterHandler(ctx.inputs());
+  processClusters(clusterHandler(ctx.inputs(), mClusterBuffers), mClusterSums, mThreadClusters);
+}
 
+void Clusters::processClusters(const o2::tpc::ClusterNativeAccess& clusterIndex, o2::tpc::qc::Clusters& sums,
+                               std::vector<o2::tpc::qc::Clusters>& threadClusters)
+{
+  if (threadClusters.empty()) {
+    for (int isector = 0; isector < o2::tpc::constants::MAXSECTOR; ++isector) {
+      for (int irow = 0; irow < o2::tpc::constants::MAXGLOBALPADROW; ++irow) {
+        const int nClusters = clusterIndex.nClusters[isector][irow];
+        for (int icl = 0; icl < nClusters; ++icl) {
+          const auto& cl = *(clusterIndex.clusters[isector][irow] + icl);
+          sums.processCluster(cl, o2::tpc::Sector(isector), irow);
+        }
+      }
+    }
+    return;
+  }
+
+#ifdef WITH_OPENMP
+#pragma omp parallel for num_threads(threadClusters.size()) schedule(dynamic)
+#endif
   for (int isector = 0; isector < o2::tpc::constants::MAXSECTOR; ++isector) {
+#ifdef WITH_OPENMP
+    auto& accumulator = threadClusters[omp_get_thread_num()];
+#else
+    auto& accumulator = threadClusters[0];
+#endif
     for (int irow = 0; irow < o2::tpc::constants::MAXGLOBALPADROW; ++irow) {
       const int nClusters = clusterIndex.nClusters[isector][irow];
       for (int icl = 0; icl < nClusters; ++icl) {
         const auto& cl = *(clusterIndex.clusters[isector][irow] + icl);
-        mQCClusters.processCluster(cl, o2::tpc::Sector(isector), irow);
+        accumulator.processCluster(cl, o2::tpc::Sector(isector), irow);
       }
     }
+    // the ROCs of a sector are only written by the thread which processes it, the move needs no lock
+    moveSector(accumulator, sums, isector);
   }
+}
 
-  mQCClusters.analyse();
-
-  auto vecPtrNClusters = toVector(mNClustersCanvasVec);
-  o2::tpc::painter::makeSummaryCanvases(mQCClusters.getNClusters(), 300, 0, 0, true, &vecPtrNClusters);
-
-  auto vecPtrQMax = toVector(mQMaxCanvasVec);
-  o2::tpc::painter::makeSummaryCanvases(mQCClusters.getQMax(), 300, 0, 0, true, &vecPtrQMax);
-
-  auto vecPtrQTot = toVector(mQTotCanvasVec);
-  o2::tpc::painter::makeSummaryCanvases(mQCClusters.getQTot(), 300, 0, 0, true, &vecPtrQTot);
-
-  auto vecPtrSigmaTime = toVector(mSigmaTimeCanvasVec);
-  o2::tpc::painter::makeSummaryCanvases(mQCClusters.getSigmaTime(), 300, 0, 0, true, &vecPtrSigmaTime);
-
-  auto vecPtrSigmaPad = toVector(mSigmaPadCanvasVec);
-  o2::tpc::painter::makeSummaryCanvases(mQCClusters.getSigmaPad(), 300, 0, 0, true, &vecPtrSigmaPad);
+void Clusters::computeMeans(o2::tpc::qc::Clusters& sums, o2::tpc::qc::Clusters& means)
+{
+  means.getNClusters() = sums.getNClusters();
+  auto divide = [&sums](o2::tpc::CalPad& sum, o2::tpc::CalPad& mean) {
+    for (size_t roc = 0; roc < sum.getData().size(); ++roc) {
+      const auto& sumData = sum.getCalArray(roc).getData();
+      const auto& nClusters = sums.getNClusters().getCalArray(roc).getData();
+      auto& meanData = mean.getCalArray(roc).getData();
+      for (size_t pad = 0; pad < sumData.size(); ++pad) {
+        meanData[pad] = nClusters[pad] > 0 ? sumData[pad] / nClusters[pad] : 0;
+      }
+    }
+  };
+  divide(sums.getQMax(), means.getQMax());
+  divide(sums.getQTot(), means.getQTot());
+  divide(sums.getSigmaTime(), means.getSigmaTime());
+  divide(sums.getSigmaPad(), means.getSigmaPad());
+  divide(sums.getTimeBin(), means.getTimeBin());
+}
 
-  auto vecPtrTimeBin = toVector(mTimeBinCanvasVec);
-  o2::tpc::painter::makeSummaryCanvases(mQCClusters.getTimeBin(), 300, 0, 0, true, &vecPtrTimeBin);
+void Clusters::moveSector(o2::tpc::qc::Clusters& source, o2::tpc::qc::Clusters& target, int sector)
+{
+  auto move = [sector](o2::tpc::CalPad& from, o2::tpc::CalPad& to) {
+    // the inner and the outer ROC of the sector
+    for (int roc : { sector, sector + o2::tpc::constants::MAXSECTOR }) {
+      auto& fromData = from.getCalArray(roc).getData();
+      auto& toData = to.getCalArray(roc).getData();
+      for (size_t pad = 0; pad < fromData.size(); ++pad) {
+        toData[pad] += fromData[pad];
+        fromData[pad] = 0;
+      }
+    }
+  };
+  move(source.getNClusters(), target.getNClusters());
+  move(source.getQMax(), target.getQMax());
+  move(source.getQTot(), target.getQTot());
+  move(source.getSigmaTime(), target.getSigmaTime());
+  move(source.getSigmaPad(), target.getSigmaPad());
+  move(source.getTimeBin(), target.getTimeBin());
 }
 
 void Clusters::endOfCycle()
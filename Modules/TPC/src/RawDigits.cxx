@@ -48,6 +48,18 @@ void RawDigits::initialize(o2::framework::InitContext& /*ctx*/)
     getObjectsManager()->addMetadata(wrapper.getObj()->getName().data(), "custom", "87");
   }
 
+  // the summary canvases are drawn once per cycle, when they are published, rather than for each message
+  getObjectsManager()->registerRenderer([this]() {
+    auto vecPtrNRawDigits = toVector(mNRawDigitsCanvasVec);
+    o2::tpc::painter::makeSummaryCanvases(mRawDigitQC.getNClusters(), 300, 0, 0, true, &vecPtrNRawDigits);
+
+    auto vecPtrQMax = toVector(mQMaxCanvasVec);
+    o2::tpc::painter::makeSummaryCanvases(mRawDigitQC.getQMax(), 300, 0, 0, true, &vecPtrQMax);
+
+    auto vecPtrTimeBin = toVector(mTimeBinCanvasVec);
+    o2::tpc::painter::makeSummaryCanvases(mRawDigitQC.getTimeBin(), 300, 0, 0, true, &vecPtrTimeBin);
+  });
+
   mRawReader.setLinkZSCallback([this](int cru, int rowInSector, int padInRow, int timeBin, float adcValue) -> bool {
     mRawDigitQC.fillADCValue(cru, rowInSector, padInRow, timeBin, adcValue);
     return true;
@@ -70,15 +82,6 @@ void RawDigits::monitorData(o2::framework::ProcessingContext& ctx)
   o2::tpc::calib_processing_helper::processRawData(ctx.inputs(), reader, false);
 
   mRawDigitQC.analyse();
-
-  auto vecPtrNRawDigits = toVector(mNRawDigitsCanvasVec);
-  o2::tpc::painter::makeSummaryCanvases(mRawDigitQC.getNClusters(), 300, 0, 0, true, &vecPtrNRawDigits);
-
-  auto vecPtrQMax = toVector(mQMaxCanvasVec);
-  o2::tpc::painter::makeSummaryCanvases(mRawDigitQC.getQMax(), 300, 0, 0, true, &vecPtrQMax);
-
-  auto vecPtrTimeBin = toVector(mTimeBinCanvasVec);
-  o2::tpc::painter::makeSummaryCanvases(mRawDigitQC.getTimeBin(), 300, 0, 0, true, &vecPtrTimeBin);
 }
 
 void RawDigits::endOfCycle()
@@ -24,7 +24,9 @@
 
 // external includes
 #include <Framework/Logger.h>
+#include <array>
 #include <bitset>
+#include <cstring>
 
 namespace o2::quality_control_modules::tpc
 {
@@ -52,28 +54,23 @@ std::vector<TCanvas*> toVector(std::vector<std::unique_ptr<TCanvas>>& input)
   return output;
 }
 
-o2::tpc::ClusterNativeAccess clusterHandler(o2::framework::InputRecord& input)
+const o2::tpc::ClusterNativeAccess& clusterHandler(o2::framework::InputRecord& input, ClusterHandlerBuffers& buffers)
 {
   using namespace o2::tpc;
   using namespace o2::framework;
 
-  ClusterNativeAccess clusterIndex;
+  auto& clusterIndex = buffers.clusterIndex;
+  memset(&clusterIndex, 0, sizeof(clusterIndex));
 
   constexpr static size_t NSectors = o2::tpc::constants::MAXSECTOR;
 
-  std::vector<gsl::span<const char>> inputs;
-  struct InputRef {
-    DataRef data;
-    DataRef labels;
-  };
-  std::map<int, InputRef> inputrefs;
+  std::array<DataRef, NSectors> inputRefs;
+  std::bitset<NSectors> sectors = 0; // sectors in inputRefs
 
   std::bitset<NSectors> validInputs = 0;
 
   int operation = 0;
-  std::vector<int> inputIds(36);
-  std::iota(inputIds.begin(), inputIds.end(), 0);
-  std::vector<InputSpec> filter = {
+  static const std::vector<InputSpec> filter = {
     { "check", ConcreteDataTypeMatcher{ o2::header::gDataOriginTPC, "CLUSTERNATIVE" }, Lifetime::Timeframe },
   };
   for (auto const& ref : InputRecordWalker(input, filter)) {
@@ -104,21 +101,22 @@ o2::tpc::ClusterNativeAccess clusterHandler(o2::framework::InputRecord& input)
       throw std::runtime_error("can only have one cluster data set per sector");
     }
     validInputs |= sectorMask;
-    inputrefs[sector].data = ref;
+    inputRefs[sector] = ref;
+    sectors.set(sector);
   }
 
-  for (auto const& refentry : inputrefs) {
-    //auto& sector = refentry.first;
-    auto& ref = refentry.second.data;
-    inputs.emplace_back(gsl::span(ref.payload, DataRefUtils::getPayloadSize(ref)));
+  buffers.inputs.clear();
+  for (size_t sector = 0; sector < NSectors; sector++) {
+    if (sectors.test(sector)) {
+      auto& ref = inputRefs[sector];
+      buffers.inputs.emplace_back(gsl::span(ref.payload, DataRefUtils::getPayloadSize(ref)));
+    }
   }
 
-  std::unique_ptr<ClusterNative[]> clusterBuffer;
-  ClusterNativeHelper::ConstMCLabelContainerViewWithBuffer clustersMCBufferDummy;
-  std::vector<o2::dataformats::ConstMCLabelContainerView> mcInputsDummy;
-  memset(&clusterIndex, 0, sizeof(clusterIndex));
-  ClusterNativeHelper::Reader::fillIndex(clusterIndex, clusterBuffer, clustersMCBufferDummy,
-                                         inputs, mcInputsDummy);
+  // the clusters are copied in clusterBuffer, which must outlive the index
+  static const std::vector<o2::dataformats::ConstMCLabelContainerView> mcInputsDummy;
+  ClusterNativeHelper::Reader::fillIndex(clusterIndex, buffers.clusterBuffer, buffers.clustersMCBuffer,
+                                         buffers.inputs, mcInputsDummy);
 
   return clusterIndex;
 }
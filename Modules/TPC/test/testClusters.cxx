@@ -0,0 +1,113 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   testClusters.cxx
+///
+
+#include "TPC/Clusters.h"
+#include "DataFormatsTPC/ClusterNative.h"
+
+#define BOOST_TEST_MODULE Clusters test
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+
+#include <boost/test/unit_test.hpp>
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace o2::quality_control_modules::tpc
+{
+
+namespace
+{
+// counts the pads whose values differ between the two CalPads
+size_t countDifferences(o2::tpc::CalPad& a, o2::tpc::CalPad& b)
+{
+  size_t differences = 0;
+  for (size_t roc = 0; roc < a.getData().size(); ++roc) {
+    const auto& aData = a.getCalArray(roc).getData();
+    const auto& bData = b.getCalArray(roc).getData();
+    for (size_t pad = 0; pad < aData.size(); ++pad) {
+      if (std::abs(aData[pad] - bData[pad]) > 1e-4 * std::max(std::abs(aData[pad]), 1.f)) {
+        differences++;
+      }
+    }
+  }
+  return differences;
+}
+} // namespace
+
+BOOST_AUTO_TEST_CASE(test_clusters_threads)
+{
+  std::mt19937 generator(42);
+  std::uniform_int_distribution<int> nClustersDistribution(0, 3);
+  std::uniform_real_distribution<float> padDistribution(0, 60);
+  std::uniform_real_distribution<float> timeDistribution(0, 500);
+  std::uniform_real_distribution<float> sigmaDistribution(0, 3);
+  std::uniform_int_distribution<int> chargeDistribution(10, 1000);
+
+  o2::tpc::qc::Clusters singleSums, threadedSums;
+  std::vector<o2::tpc::qc::Clusters> noThreadClusters;
+  std::vector<o2::tpc::qc::Clusters> threadClusters(4);
+
+  // several messages, the sums of the previous ones are kept in between
+  for (int message = 0; message < 3; ++message) {
+    std::vector<std::vector<o2::tpc::ClusterNative>> rowClusters(o2::tpc::constants::MAXSECTOR * o2::tpc::constants::MAXGLOBALPADROW);
+    auto clusterIndex = std::make_unique<o2::tpc::ClusterNativeAccess>();
+    for (int isector = 0; isector < o2::tpc::constants::MAXSECTOR; ++isector) {
+      for (int irow = 0; irow < o2::tpc::constants::MAXGLOBALPADROW; ++irow) {
+        auto& clusters = rowClusters[isector * o2::tpc::constants::MAXGLOBALPADROW + irow];
+        clusters.resize(nClustersDistribution(generator));
+        for (auto& cl : clusters) {
+          cl.setTimeFlags(timeDistribution(generator), 0);
+          cl.setPad(padDistribution(generator));
+          cl.setSigmaTime(sigmaDistribution(generator));
+          cl.setSigmaPad(sigmaDistribution(generator));
+          cl.qMax = chargeDistribution(generator);
+          cl.qTot = cl.qMax + chargeDistribution(generator);
+        }
+        clusterIndex->clusters[isector][irow] = clusters.data();
+        clusterIndex->nClusters[isector][irow] = clusters.size();
+      }
+    }
+
+    Clusters::processClusters(*clusterIndex, singleSums, noThreadClusters);
+    Clusters::processClusters(*clusterIndex, threadedSums, threadClusters);
+  }
+
+  o2::tpc::qc::Clusters singleMeans, threadedMeans;
+  Clusters::computeMeans(singleSums, singleMeans);
+  Clusters::computeMeans(threadedSums, threadedMeans);
+
+  BOOST_CHECK_EQUAL(countDifferences(singleMeans.getNClusters(), threadedMeans.getNClusters()), 0);
+  BOOST_CHECK_EQUAL(countDifferences(singleMeans.getQMax(), threadedMeans.getQMax()), 0);
+  BOOST_CHECK_EQUAL(countDifferences(singleMeans.getQTot(), threadedMeans.getQTot()), 0);
+  BOOST_CHECK_EQUAL(countDifferences(singleMeans.getSigmaTime(), threadedMeans.getSigmaTime()), 0);
+  BOOST_CHECK_EQUAL(countDifferences(singleMeans.getSigmaPad(), threadedMeans.getSigmaPad()), 0);
+  BOOST_CHECK_EQUAL(countDifferences(singleMeans.getTimeBin(), threadedMeans.getTimeBin()), 0);
+
+  // the means are not computed twice: publishing again gives the same values
+  Clusters::computeMeans(threadedSums, threadedMeans);
+  BOOST_CHECK_EQUAL(countDifferences(singleMeans.getQMax(), threadedMeans.getQMax()), 0);
+  // and clusters were really processed
+  float totalClusters = 0;
+  for (const auto& calArray : singleMeans.getNClusters().getData()) {
+    for (auto value : calArray.getData()) {
+      totalClusters += value;
+    }
+  }
+  BOOST_CHECK_GT(totalClusters, 0);
+}
+
+} // namespace o2::quality_control_modules::tpc